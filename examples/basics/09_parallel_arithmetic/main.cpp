@@ -0,0 +1,56 @@
+/** 
+ *  Codac - Examples
+ *  Parallel arithmetic on tubes: scaling benchmark
+ * ----------------------------------------------------------------------------
+ *
+ *  \brief      Computation times of tube arithmetic and TFunction evaluations
+ *              with 1 to 32 threads (see ThreadPool::set_nb_threads())
+ *
+ *  \date       2021
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <chrono>
+#include <codac.h>
+
+using namespace std;
+using namespace codac;
+
+int main()
+{
+  double dt = 0.0001;
+  Interval tdomain(0.,100.);
+
+  TFunction f_traj("(cos(t) ; sin(t)+t/10)");
+  TrajectoryVector traj(tdomain, f_traj);
+  TubeVector x(traj, dt); // 1,000,000 slices per component
+  x.inflate(0.1);
+
+  TFunction f("x1", "x2", "(x1*cos(t)+sqr(x2) ; exp(-x1)*atan2(x2,x1))");
+  ThreadPool::set_grain_size(4096);
+
+  cout << "Slices: " << x.nb_slices() << endl;
+  cout << "threads\tarithmetic (s)\tTFunction (s)" << endl;
+
+  for(int nb_threads = 1 ; nb_threads <= 32 ; nb_threads *= 2)
+  {
+    ThreadPool::set_nb_threads(nb_threads);
+
+    auto t0 = chrono::steady_clock::now();
+    Tube y = sqrt(sqr(x[0]) + sqr(x[1])) * exp(-x[0]) | sin(x[1]);
+    auto t1 = chrono::steady_clock::now();
+    TubeVector z = f.eval_vector(x);
+    auto t2 = chrono::steady_clock::now();
+
+    cout << nb_threads
+         << "\t" << chrono::duration<double>(t1 - t0).count()
+         << "\t" << chrono::duration<double>(t2 - t1).count() << endl;
+  }
+
+  ThreadPool::set_nb_threads(1);
+
+  return EXIT_SUCCESS;
+}
@@ -32,7 +32,7 @@ using py::init;
   \
   m.def(str_f, (double (*) (double)) &std::f); \
   m.def(str_f, (Interval (*) (const Interval&)) &ibex::f); \
-  m.def(str_f, (const Tube (*) (const Tube&)) &f); \
+  m.def(str_f, [](const Tube& x) { return Tube(f(x)); }); \
   m.def(str_f, (const Trajectory (*) (const Trajectory&)) &f); \
 
 void export_arithmetic(py::module& m)
@@ -57,7 +57,7 @@ void export_arithmetic(py::module& m)
   // sqr (not defined in std)
   m.def("sqr", [](double x) { return pow(x,2); }, "x"_a.noconvert());
   m.def("sqr", (Interval (*) (const Interval&)) &ibex::sqr);
-  m.def("sqr", (const Tube (*) (const Tube&)) &sqr);
+  m.def("sqr", [](const Tube& x) { return Tube(sqr(x)); });
   m.def("sqr", (const Trajectory (*) (const Trajectory&)) &sqr);
 
   // pow (several possible argument types)
@@ -67,15 +67,15 @@ void export_arithmetic(py::module& m)
   m.def("pow", (Interval (*) (const Interval& x, double p)) &ibex::pow, "x"_a, "p"_a);
   m.def("pow", (Interval (*) (const Interval& x, const Interval& p)) &ibex::pow, "x"_a, "p"_a);
   m.def("pow", [](double x, const Interval& p) { return ibex::pow(Interval(x),p); }, "x"_a, "p"_a);
-  m.def("pow", (const Tube (*) (const Tube& x, int p)) &pow, "x"_a, "p"_a);
-  m.def("pow", (const Tube (*) (const Tube& x, double p)) &pow, "x"_a, "p"_a);
-  m.def("pow", (const Tube (*) (const Tube& x, const Interval& p)) &pow, "x"_a, "p"_a);
+  m.def("pow", [](const Tube& x, int p) { return Tube(pow(x,p)); }, "x"_a, "p"_a);
+  m.def("pow", [](const Tube& x, double p) { return Tube(pow(x,p)); }, "x"_a, "p"_a);
+  m.def("pow", [](const Tube& x, const Interval& p) { return Tube(pow(x,p)); }, "x"_a, "p"_a);
   m.def("pow", (const Trajectory (*) (const Trajectory& x, int p)) &pow, "x"_a, "p"_a);
   m.def("pow", (const Trajectory (*) (const Trajectory& x, double p)) &pow, "x"_a, "p"_a);
 
   // root
   m.def("root", (Interval (*) (const Interval& x, int p)) &ibex::root, "x"_a, "p"_a);
-  m.def("root", (const Tube (*) (const Tube& x, int p)) &root, "x"_a, "p"_a);
+  m.def("root", [](const Tube& x, int p) { return Tube(root(x,p)); }, "x"_a, "p"_a);
   m.def("root", (const Trajectory (*) (const Trajectory& x, int p)) &root, "x"_a, "p"_a);
 
   // atan2
@@ -83,11 +83,11 @@ void export_arithmetic(py::module& m)
   m.def("atan2", [](const Interval& y, double x) { return ibex::atan2(y,Interval(x)); }, "y"_a.noconvert(), "x"_a.noconvert());
   m.def("atan2", [](double y, const Interval& x) { return ibex::atan2(Interval(y),x); }, "y"_a.noconvert(), "x"_a.noconvert());
   m.def("atan2", (Interval (*) (const Interval& y, const Interval& x)) &atan2, "y"_a, "x"_a);
-  m.def("atan2", (const Tube (*) (const Tube& y, const Tube& x)) &atan2, "y"_a, "x"_a);
-  m.def("atan2", [](const Tube& y, double x) { return atan2(y,Interval(x)); } , "y"_a.noconvert(), "x"_a.noconvert());
-  m.def("atan2", (const Tube (*) (const Tube& y, const Interval& x)) &atan2, "y"_a, "x"_a);
-  m.def("atan2", [](double y, const Tube& x) { return atan2(Interval(y),x); } , "y"_a.noconvert(), "x"_a.noconvert());
-  m.def("atan2", (const Tube (*) (const Interval& y, const Tube& x)) &atan2, "y"_a, "x"_a);
+  m.def("atan2", [](const Tube& y, const Tube& x) { return Tube(atan2(y,x)); }, "y"_a, "x"_a);
+  m.def("atan2", [](const Tube& y, double x) { return Tube(atan2(y,Interval(x))); } , "y"_a.noconvert(), "x"_a.noconvert());
+  m.def("atan2", [](const Tube& y, const Interval& x) { return Tube(atan2(y,x)); }, "y"_a, "x"_a);
+  m.def("atan2", [](double y, const Tube& x) { return Tube(atan2(Interval(y),x)); } , "y"_a.noconvert(), "x"_a.noconvert());
+  m.def("atan2", [](const Interval& y, const Tube& x) { return Tube(atan2(y,x)); }, "y"_a, "x"_a);
   m.def("atan2", (const Trajectory (*) (const Trajectory& y, const Trajectory& x)) &atan2, "y"_a, "x"_a);
   m.def("atan2", (const Trajectory (*) (const Trajectory& y, double x)) &atan2, "y"_a, "x"_a);
   m.def("atan2", (const Trajectory (*) (double y, const Trajectory& x)) &atan2, "y"_a, "x"_a);
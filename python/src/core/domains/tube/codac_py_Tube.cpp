@@ -425,67 +425,67 @@ void export_Tube(py::module& m)
   // Operators
 
     .def("__add__",      [](const Tube& x) { return +x; })
-    .def("__add__",      [](const Tube& x, const Tube& y) { return x+y; })
-    .def("__add__",      [](const Tube& x, double y) { return x+y; })
-    .def("__add__",      [](const Tube& x, const Interval& y) { return x+y; })
+    .def("__add__",      [](const Tube& x, const Tube& y) { return Tube(x+y); })
+    .def("__add__",      [](const Tube& x, double y) { return Tube(x+y); })
+    .def("__add__",      [](const Tube& x, const Interval& y) { return Tube(x+y); })
     .def("__add__",      [](const Tube& x, const Trajectory& y) { return x+y; })
 
-    .def("__radd__",     [](const Tube& y, double x) { return x+y; })
-    .def("__radd__",     [](const Tube& y, const Interval& x) { return x+y; })
+    .def("__radd__",     [](const Tube& y, double x) { return Tube(x+y); })
+    .def("__radd__",     [](const Tube& y, const Interval& x) { return Tube(x+y); })
     .def("__radd__",     [](const Tube& y, const Trajectory& x) { return x+y; })
-    .def("__radd__",     [](const Tube& y, const Tube& x) { return x+y; })
+    .def("__radd__",     [](const Tube& y, const Tube& x) { return Tube(x+y); })
 
-    .def("__neg__",      [](const Tube& x) { return -x; })
-    .def("__sub__",      [](const Tube& x, const Tube& y) { return x-y; })
-    .def("__sub__",      [](const Tube& x, double y) { return x-y; })
-    .def("__sub__",      [](const Tube& x, const Interval& y) { return x-y; })
+    .def("__neg__",      [](const Tube& x) { return Tube(-x); })
+    .def("__sub__",      [](const Tube& x, const Tube& y) { return Tube(x-y); })
+    .def("__sub__",      [](const Tube& x, double y) { return Tube(x-y); })
+    .def("__sub__",      [](const Tube& x, const Interval& y) { return Tube(x-y); })
     .def("__sub__",      [](const Tube& x, const Trajectory& y) { return x-y; })
 
-    .def("__rsub__",     [](const Tube& y, double x) { return x-y; })
-    .def("__rsub__",     [](const Tube& y, const Interval& x) { return x-y; })
+    .def("__rsub__",     [](const Tube& y, double x) { return Tube(x-y); })
+    .def("__rsub__",     [](const Tube& y, const Interval& x) { return Tube(x-y); })
     .def("__rsub__",     [](const Tube& y, const Trajectory& x) { return x-y; })
-    .def("__rsub__",     [](const Tube& y, const Tube& x) { return x-y; })
+    .def("__rsub__",     [](const Tube& y, const Tube& x) { return Tube(x-y); })
 
-    .def("__mul__",      [](const Tube& x, const Tube& y) { return x*y; })
-    .def("__mul__",      [](const Tube& x, double y) { return x*y; })
-    .def("__mul__",      [](const Tube& x, const Interval& y) { return x*y; })
+    .def("__mul__",      [](const Tube& x, const Tube& y) { return Tube(x*y); })
+    .def("__mul__",      [](const Tube& x, double y) { return Tube(x*y); })
+    .def("__mul__",      [](const Tube& x, const Interval& y) { return Tube(x*y); })
     .def("__mul__",      [](const Tube& x, const Trajectory& y) { return x*y; })
     // Vector case
     .def("__mul__",      [](const Tube& x, const IntervalVector& y) { return x*y; })
     .def("__mul__",      [](const Tube& x, const TubeVector& y) { return x*y; })
 
-    .def("__rmul__",     [](const Tube& y, double x) { return x*y; })
-    .def("__rmul__",     [](const Tube& y, const Interval& x) { return x*y; })
+    .def("__rmul__",     [](const Tube& y, double x) { return Tube(x*y); })
+    .def("__rmul__",     [](const Tube& y, const Interval& x) { return Tube(x*y); })
     .def("__rmul__",     [](const Tube& y, const Trajectory& x) { return x*y; })
 
-    .def("__truediv__",  [](const Tube& x, const Tube& y) { return x/y; })
-    .def("__truediv__",  [](const Tube& x, double y) { return x/y; })
-    .def("__truediv__",  [](const Tube& x, const Interval& y) { return x/y; })
+    .def("__truediv__",  [](const Tube& x, const Tube& y) { return Tube(x/y); })
+    .def("__truediv__",  [](const Tube& x, double y) { return Tube(x/y); })
+    .def("__truediv__",  [](const Tube& x, const Interval& y) { return Tube(x/y); })
     .def("__truediv__",  [](const Tube& x, const Trajectory& y) { return x/y; })
 
-    .def("__rtruediv__", [](const Tube& y, const double x) { return x/y; })
-    .def("__rtruediv__", [](const Tube& y, const Interval& x) { return x/y; })
+    .def("__rtruediv__", [](const Tube& y, const double x) { return Tube(x/y); })
+    .def("__rtruediv__", [](const Tube& y, const Interval& x) { return Tube(x/y); })
     .def("__rtruediv__", [](const Tube& y, const Trajectory& x) { return x/y; })
     // Vector case
     .def("__rtruediv__", [](const Tube& y, const IntervalVector& x) { return x/y; })
     .def("__rtruediv__", [](const Tube& y, const TubeVector& x) { return x/y; })
 
-    .def("__or__",       [](const Tube& x, const Tube& y) { return x|y; })
-    .def("__or__",       [](const Tube& x, double y) { return x|y; })
-    .def("__or__",       [](const Tube& x, const Interval& y) { return x|y; })
+    .def("__or__",       [](const Tube& x, const Tube& y) { return Tube(x|y); })
+    .def("__or__",       [](const Tube& x, double y) { return Tube(x|y); })
+    .def("__or__",       [](const Tube& x, const Interval& y) { return Tube(x|y); })
     .def("__or__",       [](const Tube& x, const Trajectory& y) { return x|y; })
 
-    .def("__ror__",      [](const Tube& y, double x) { return x|y; })
-    .def("__ror__",      [](const Tube& y, const Interval& x) { return x|y; })
+    .def("__ror__",      [](const Tube& y, double x) { return Tube(x|y); })
+    .def("__ror__",      [](const Tube& y, const Interval& x) { return Tube(x|y); })
     .def("__ror__",      [](const Tube& y, const Trajectory& x) { return x|y; })
 
-    .def("__and__",      [](const Tube& x, const Tube& y) { return x&y; })
-    .def("__and__",      [](const Tube& x, double y) { return x&y; })
-    .def("__and__",      [](const Tube& x, const Interval& y) { return x&y; })
+    .def("__and__",      [](const Tube& x, const Tube& y) { return Tube(x&y); })
+    .def("__and__",      [](const Tube& x, double y) { return Tube(x&y); })
+    .def("__and__",      [](const Tube& x, const Interval& y) { return Tube(x&y); })
     .def("__and__",      [](const Tube& x, const Trajectory& y) { return x&y; })
 
-    .def("__rand__",     [](const Tube& y, double x) { return x&y; })
-    .def("__rand__",     [](const Tube& y, const Interval& x) { return x&y; })
+    .def("__rand__",     [](const Tube& y, double x) { return Tube(x&y); })
+    .def("__rand__",     [](const Tube& y, const Interval& x) { return Tube(x&y); })
     .def("__rand__",     [](const Tube& y, const Trajectory& x) { return x&y; })
   ;
 }
\ No newline at end of file
@@ -26,13 +26,11 @@ namespace codac
     assert(x.definition_type() == TrajDefnType::MAP_OF_VALUES
       && "not supported yet for trajectories defined by a Function");
 
-    map<double,double> map_y = x.sampled_map();
+    TrajectorySamples samples_y = x.samples();
+    for(int k = 0 ; k < samples_y.size() ; k++)
+      samples_y.set_value(k, -samples_y.values()[k]);
 
-    for(map<double,double>::iterator it = map_y.begin() ;
-      it != map_y.end() ; it++)
-      it->second = -it->second;
-
-    return Trajectory(map_y);
+    return Trajectory(samples_y);
   }
     
   #define macro_scal_unary(f) \
@@ -42,13 +40,11 @@ namespace codac
       assert(x.definition_type() == TrajDefnType::MAP_OF_VALUES \
         && "not supported yet for trajectories defined by a Function"); \
       \
-      map<double,double> map_y = x.sampled_map(); \
-      \
-      for(map<double,double>::iterator it = map_y.begin() ; \
-        it != map_y.end() ; it++) \
-        it->second = std::f(it->second); \
+      TrajectorySamples samples_y = x.samples(); \
+      for(int k = 0 ; k < samples_y.size() ; k++) \
+        samples_y.set_value(k, std::f(samples_y.values()[k])); \
       \
-      return Trajectory(map_y); \
+      return Trajectory(samples_y); \
     } \
     \
 
@@ -61,13 +57,11 @@ namespace codac
     assert(x.definition_type() == TrajDefnType::MAP_OF_VALUES
       && "not supported yet for trajectories defined by a Function");
 
-    map<double,double> map_y = x.sampled_map();
-
-    for(map<double,double>::iterator it = map_y.begin() ;
-      it != map_y.end() ; it++)
-      it->second = std::pow(it->second,2);
+    TrajectorySamples samples_y = x.samples();
+    for(int k = 0 ; k < samples_y.size() ; k++)
+      samples_y.set_value(k, std::pow(samples_y.values()[k],2));
 
-    return Trajectory(map_y);
+    return Trajectory(samples_y);
   }
 
   macro_scal_unary(sqrt);
@@ -91,13 +85,11 @@ namespace codac
       assert(x.definition_type() == TrajDefnType::MAP_OF_VALUES && \
         "not supported yet for trajectories defined by a Function"); \
       \
-      map<double,double> map_y = x.sampled_map(); \
+      TrajectorySamples samples_y = x.samples(); \
+      for(int k = 0 ; k < samples_y.size() ; k++) \
+        samples_y.set_value(k, std::f(samples_y.values()[k], param)); \
       \
-      for(map<double,double>::iterator it = map_y.begin() ; \
-        it != map_y.end() ; it++) \
-        it->second = std::f(it->second, param); \
-      \
-      return Trajectory(map_y); \
+      return Trajectory(samples_y); \
     } \
     \
   
@@ -109,12 +101,11 @@ namespace codac
     assert(x.definition_type() == TrajDefnType::MAP_OF_VALUES &&
       "not supported yet for trajectories defined by a Function");
 
-    map<double,double> map_y = x.sampled_map();
-    for(map<double,double>::iterator it = map_y.begin() ;
-      it != map_y.end() ; it++)
-      it->second = std::pow(it->second, 1. / p);
+    TrajectorySamples samples_y = x.samples();
+    for(int k = 0 ; k < samples_y.size() ; k++)
+      samples_y.set_value(k, std::pow(samples_y.values()[k], 1. / p));
 
-    return Trajectory(map_y);
+    return Trajectory(samples_y);
   }
 
   #define macro_scal_binary_arith(f) \
@@ -130,17 +121,15 @@ namespace codac
         x1_sampled.sample(x2); \
       if(x1.definition_type() == TrajDefnType::MAP_OF_VALUES) \
         x2_sampled.sample(x1); \
-      map<double,double> new_map; \
-      map<double,double>::const_iterator it_x1 = x1_sampled.sampled_map().begin(); \
-      map<double,double>::const_iterator it_x2 = x2_sampled.sampled_map().begin(); \
       \
-      while(it_x1 != x1_sampled.sampled_map().end()) \
-      { \
-        new_map[it_x1->first] = it_x1->second f it_x2->second; \
-        it_x1++; it_x2++; \
-      } \
+      TrajectorySamples samples_y = x1_sampled.samples(); \
+      const vector<double>& v_x2 = x2_sampled.samples().values(); \
+      assert(samples_y.size() == (int)v_x2.size()); \
+      \
+      for(int k = 0 ; k < samples_y.size() ; k++) \
+        samples_y.set_value(k, samples_y.values()[k] f v_x2[k]); \
       \
-      return Trajectory(new_map); \
+      return Trajectory(samples_y); \
     } \
     \
     const Trajectory operator f(const Trajectory& x1, double x2) \
@@ -148,14 +137,11 @@ namespace codac
       assert(x1.definition_type() == TrajDefnType::MAP_OF_VALUES && \
         "not supported yet for trajectories defined by a Function"); \
       \
-      Trajectory y(x1); \
-      map<double,double> map_y = y.sampled_map(); \
+      TrajectorySamples samples_y = x1.samples(); \
+      for(int k = 0 ; k < samples_y.size() ; k++) \
+        samples_y.set_value(k, samples_y.values()[k] f x2); \
       \
-      for(map<double,double>::iterator it = map_y.begin() ; \
-        it != map_y.end() ; it++) \
-        it->second = it->second f x2; \
-      \
-      return Trajectory(map_y); \
+      return Trajectory(samples_y); \
     } \
     \
     const Trajectory operator f(double x1, const Trajectory& x2) \
@@ -163,14 +149,11 @@ namespace codac
       assert(x2.definition_type() == TrajDefnType::MAP_OF_VALUES && \
         "not supported yet for trajectories defined by a Function"); \
       \
-      Trajectory y(x2); \
-      map<double,double> map_y = y.sampled_map(); \
-      \
-      for(map<double,double>::iterator it = map_y.begin() ; \
-        it != map_y.end() ; it++) \
-        it->second = x1 f it->second; \
+      TrajectorySamples samples_y = x2.samples(); \
+      for(int k = 0 ; k < samples_y.size() ; k++) \
+        samples_y.set_value(k, x1 f samples_y.values()[k]); \
       \
-      return Trajectory(map_y); \
+      return Trajectory(samples_y); \
     } \
     \
 
@@ -190,18 +173,15 @@ namespace codac
       x1_sampled.sample(x2);
     if(x1.definition_type() == TrajDefnType::MAP_OF_VALUES)
       x2_sampled.sample(x1);
-    map<double,double> map_x1 = x1.sampled_map(), map_x2 = x2.sampled_map();
 
-    map<double,double>::iterator it_x1 = map_x1.begin();
-    map<double,double>::iterator it_x2 = map_x2.begin();
+    TrajectorySamples samples_y = x1_sampled.samples();
+    const vector<double>& v_x2 = x2_sampled.samples().values();
+    assert(samples_y.size() == (int)v_x2.size());
 
-    while(it_x1 != map_x1.end())
-    {
-      it_x1->second = std::atan2(it_x1->second, it_x2->second);
-      it_x1++; it_x2++;
-    }
+    for(int k = 0 ; k < samples_y.size() ; k++)
+      samples_y.set_value(k, std::atan2(samples_y.values()[k], v_x2[k]));
 
-    return Trajectory(map_x1);
+    return Trajectory(samples_y);
   }
 
   const Trajectory atan2(const Trajectory& x1, double x2)
@@ -209,14 +189,11 @@ namespace codac
     assert(x1.definition_type() == TrajDefnType::MAP_OF_VALUES &&
       "not supported yet for trajectories defined by a Function");
 
-    Trajectory y(x1);
-    map<double,double> map_y = y.sampled_map();
+    TrajectorySamples samples_y = x1.samples();
+    for(int k = 0 ; k < samples_y.size() ; k++)
+      samples_y.set_value(k, std::atan2(samples_y.values()[k], x2));
 
-    for(map<double,double>::iterator it = map_y.begin() ;
-      it != map_y.end() ; it++)
-      it->second = std::atan2(it->second, x2);
-
-    return Trajectory(map_y);
+    return Trajectory(samples_y);
   }
 
   const Trajectory atan2(double x1, const Trajectory& x2)
@@ -224,13 +201,10 @@ namespace codac
     assert(x2.definition_type() == TrajDefnType::MAP_OF_VALUES &&
       "not supported yet for trajectories defined by a Function");
 
-    Trajectory y(x2);
-    map<double,double> map_y = y.sampled_map();
-
-    for(map<double,double>::iterator it = map_y.begin() ;
-      it != map_y.end() ; it++)
-      it->second = std::atan2(x1, it->second);
+    TrajectorySamples samples_y = x2.samples();
+    for(int k = 0 ; k < samples_y.size() ; k++)
+      samples_y.set_value(k, std::atan2(x1, samples_y.values()[k]));
 
-    return Trajectory(map_y);
+    return Trajectory(samples_y);
   }
 }
\ No newline at end of file
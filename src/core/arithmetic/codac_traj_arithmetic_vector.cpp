@@ -97,8 +97,8 @@ namespace codac
           x2_[i].sample(x2_[j]);
 
     TrajectoryVector result(x2.size());
-    for(auto const& it : x2_[0].sampled_map())
-      result.set(x1*x2_(it.first), it.first);
+    for(const auto& t : x2_[0].samples().times())
+      result.set(x1*x2_(t), t);
     
     return result;
   }
@@ -132,9 +132,8 @@ namespace codac
     assert(x1.size() == 3 && x2.size() == 3);
 
     TrajectoryVector result(x1.size());
-    for(auto const& it : x1[0].sampled_map())
+    for(const auto& t : x1[0].samples().times())
     {
-      double t = it.first;
       Vector v(3);
       v[0] = x1[1](t)*x2[2] - x1[2](t)*x2[1];
       v[1] = x1[2](t)*x2[0] - x1[0](t)*x2[2];
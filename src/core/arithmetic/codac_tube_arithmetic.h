@@ -19,113 +19,118 @@
 #include "codac_IntervalVector.h"
 #include "codac_Tube.h"
 #include "codac_TubeVector.h"
+#include "codac_tube_expr.h"
 
 namespace codac
 {
   /// \name Scalar outputs
   /// @{
 
+    // Operations on Tube and Interval operands return lazy expressions (see TubeExpr),
+    // evaluated in a single pass over the slices when assigned to a Tube object.
+    // Temporary tube operands are handled by the overloads of the end of this section.
+
     /** \brief \f$\cos([x](\cdot))\f$
       * \param x
       * \return Tube output
       */
-    const Tube cos(const Tube& x);
+    const TubeExprUnary<tube_op::Cos,TubeRef> cos(const Tube& x);
 
     /** \brief \f$\sin([x](\cdot))\f$
       * \param x
       * \return Tube output
       */
-    const Tube sin(const Tube& x);
+    const TubeExprUnary<tube_op::Sin,TubeRef> sin(const Tube& x);
 
     /** \brief \f$\mid[x](\cdot)\mid\f$
       * \param x
       * \return Tube output
       */
-    const Tube abs(const Tube& x);
+    const TubeExprUnary<tube_op::Abs,TubeRef> abs(const Tube& x);
 
     /** \brief \f$[x]^2(\cdot)\f$
       * \param x
       * \return Tube output
       */
-    const Tube sqr(const Tube& x);
+    const TubeExprUnary<tube_op::Sqr,TubeRef> sqr(const Tube& x);
 
     /** \brief \f$\sqrt{[x](\cdot)}\f$
       * \param x
       * \return Tube output
       */
-    const Tube sqrt(const Tube& x);
+    const TubeExprUnary<tube_op::Sqrt,TubeRef> sqrt(const Tube& x);
 
     /** \brief \f$\exp([x](\cdot))\f$
       * \param x
       * \return Tube output
       */
-    const Tube exp(const Tube& x);
+    const TubeExprUnary<tube_op::Exp,TubeRef> exp(const Tube& x);
 
     /** \brief \f$\log([x](\cdot))\f$
       * \param x
       * \return Tube output
       */
-    const Tube log(const Tube& x);
+    const TubeExprUnary<tube_op::Log,TubeRef> log(const Tube& x);
 
     /** \brief \f$\tan([x](\cdot))\f$
       * \param x
       * \return Tube output
       */
-    const Tube tan(const Tube& x);
+    const TubeExprUnary<tube_op::Tan,TubeRef> tan(const Tube& x);
 
     /** \brief \f$\arccos([x](\cdot))\f$
       * \param x
       * \return Tube output
       */
-    const Tube acos(const Tube& x);
+    const TubeExprUnary<tube_op::Acos,TubeRef> acos(const Tube& x);
 
     /** \brief \f$\arcsin([x](\cdot))\f$
       * \param x
       * \return Tube output
       */
-    const Tube asin(const Tube& x);
+    const TubeExprUnary<tube_op::Asin,TubeRef> asin(const Tube& x);
 
     /** \brief \f$\arctan([x](\cdot))\f$
       * \param x
       * \return Tube output
       */
-    const Tube atan(const Tube& x);
+    const TubeExprUnary<tube_op::Atan,TubeRef> atan(const Tube& x);
 
     /** \brief \f$\cosh([x](\cdot))\f$
       * \param x
       * \return Tube output
       */
-    const Tube cosh(const Tube& x);
+    const TubeExprUnary<tube_op::Cosh,TubeRef> cosh(const Tube& x);
 
     /** \brief \f$\sinh([x](\cdot))\f$
       * \param x
       * \return Tube output
       */
-    const Tube sinh(const Tube& x);
+    const TubeExprUnary<tube_op::Sinh,TubeRef> sinh(const Tube& x);
 
     /** \brief \f$\tanh([x](\cdot))\f$
       * \param x
       * \return Tube output
       */
-    const Tube tanh(const Tube& x);
+    const TubeExprUnary<tube_op::Tanh,TubeRef> tanh(const Tube& x);
 
     /** \brief \f$\mathrm{arccosh}([x](\cdot))\f$
       * \param x
       * \return Tube output
       */
-    const Tube acosh(const Tube& x);
+    const TubeExprUnary<tube_op::Acosh,TubeRef> acosh(const Tube& x);
 
     /** \brief \f$\mathrm{arcsinh}([x](\cdot))\f$
       * \param x
       * \return Tube output
       */
-    const Tube asinh(const Tube& x);
+    const TubeExprUnary<tube_op::Asinh,TubeRef> asinh(const Tube& x);
 
     /** \brief \f$\mathrm{arctanh}([x](\cdot))\f$
       * \param x
       * \return Tube output
       */
-    const Tube atanh(const Tube& x);
+    const TubeExprUnary<tube_op::Atanh,TubeRef> atanh(const Tube& x);
 
 
     /** \brief \f$\mathrm{arctan2}([y](\cdot),[x](\cdot))\f$
@@ -133,21 +138,21 @@ namespace codac
       * \param x
       * \return Tube output
       */
-    const Tube atan2(const Tube& y, const Tube& x);
+    const TubeExprBinary<tube_op::Atan2,TubeRef,TubeRef> atan2(const Tube& y, const Tube& x);
 
     /** \brief \f$\mathrm{arctan2}([y](\cdot),[x])\f$
       * \param y
       * \param x
       * \return Tube output
       */
-    const Tube atan2(const Tube& y, const Interval& x);
+    const TubeExprBinary<tube_op::Atan2,TubeRef,TubeExprCst> atan2(const Tube& y, const Interval& x);
 
     /** \brief \f$\mathrm{arctan2}([y],[x](\cdot))\f$
       * \param y
       * \param x
       * \return Tube output
       */
-    const Tube atan2(const Interval& y, const Tube& x);
+    const TubeExprBinary<tube_op::Atan2,TubeExprCst,TubeRef> atan2(const Interval& y, const Tube& x);
 
 
     /** \brief \f$[x]^p(\cdot)\f$
@@ -155,28 +160,28 @@ namespace codac
       * \param p
       * \return Tube output
       */
-    const Tube pow(const Tube& x, int p);
+    const TubeExprUnary<tube_op::Pow<int>,TubeRef> pow(const Tube& x, int p);
 
     /** \brief \f$[x]^p(\cdot)\f$
       * \param x
       * \param p
       * \return Tube output
       */
-    const Tube pow(const Tube& x, double p);
+    const TubeExprUnary<tube_op::Pow<double>,TubeRef> pow(const Tube& x, double p);
 
     /** \brief \f$[x]^{[p]}(\cdot)\f$
       * \param x
       * \param p
       * \return Tube output
       */
-    const Tube pow(const Tube& x, const Interval& p);
+    const TubeExprUnary<tube_op::Pow<Interval>,TubeRef> pow(const Tube& x, const Interval& p);
 
     /** \brief \f$\sqrt[p]{[x](\cdot)}\f$
       * \param x
       * \param p
       * \return Tube output
       */
-    const Tube root(const Tube& x, int p);
+    const TubeExprUnary<tube_op::Root,TubeRef> root(const Tube& x, int p);
 
     // todo: atan2, pow with Trajectory as parameter
 
@@ -185,42 +190,42 @@ namespace codac
       * \param x
       * \return Tube output
       */
-    const Tube min(const Tube& y, const Tube& x);
+    const TubeExprBinary<tube_op::Min,TubeRef,TubeRef> min(const Tube& y, const Tube& x);
 
     /** \brief \f$\mathrm{min}([y](\cdot),[x])\f$
       * \param y
       * \param x
       * \return Tube output
       */
-    const Tube min(const Tube& y, const Interval& x);
+    const TubeExprBinary<tube_op::Min,TubeRef,TubeExprCst> min(const Tube& y, const Interval& x);
 
     /** \brief \f$\mathrm{min}([y],[x](\cdot))\f$
       * \param y
       * \param x
       * \return Tube output
       */
-    const Tube min(const Interval& y, const Tube& x);
+    const TubeExprBinary<tube_op::Min,TubeExprCst,TubeRef> min(const Interval& y, const Tube& x);
 
     /** \brief \f$\mathrm{max}([y](\cdot),[x](\cdot))\f$
       * \param y
       * \param x
       * \return Tube output
       */
-    const Tube max(const Tube& y, const Tube& x);
+    const TubeExprBinary<tube_op::Max,TubeRef,TubeRef> max(const Tube& y, const Tube& x);
 
     /** \brief \f$\mathrm{max}([y](\cdot),[x])\f$
       * \param y
       * \param x
       * \return Tube output
       */
-    const Tube max(const Tube& y, const Interval& x);
+    const TubeExprBinary<tube_op::Max,TubeRef,TubeExprCst> max(const Tube& y, const Interval& x);
 
     /** \brief \f$\mathrm{max}([y],[x](\cdot))\f$
       * \param y
       * \param x
       * \return Tube output
       */
-    const Tube max(const Interval& y, const Tube& x);
+    const TubeExprBinary<tube_op::Max,TubeExprCst,TubeRef> max(const Interval& y, const Tube& x);
 
 
     /** \brief \f$[x](\cdot)\f$
@@ -234,21 +239,21 @@ namespace codac
       * \param y
       * \return Tube output
       */
-    const Tube operator+(const Tube& x, const Tube& y);
+    const TubeExprBinary<tube_op::Add,TubeRef,TubeRef> operator+(const Tube& x, const Tube& y);
 
     /** \brief \f$[x](\cdot)+[y]\f$
       * \param x
       * \param y
       * \return Tube output
       */
-    const Tube operator+(const Tube& x, const Interval& y);
+    const TubeExprBinary<tube_op::Add,TubeRef,TubeExprCst> operator+(const Tube& x, const Interval& y);
 
     /** \brief \f$[x]+[y](\cdot)\f$
       * \param x
       * \param y
       * \return Tube output
       */
-    const Tube operator+(const Interval& x, const Tube& y);
+    const TubeExprBinary<tube_op::Add,TubeExprCst,TubeRef> operator+(const Interval& x, const Tube& y);
 
     /** \brief \f$[x](\cdot)+y(\cdot)\f$
       * \param x
@@ -269,28 +274,28 @@ namespace codac
       * \param x
       * \return Tube output
       */
-    const Tube operator-(const Tube& x);
+    const TubeExprUnary<tube_op::Neg,TubeRef> operator-(const Tube& x);
 
     /** \brief \f$[x](\cdot)-[y](\cdot)\f$
       * \param x
       * \param y
       * \return Tube output
       */
-    const Tube operator-(const Tube& x, const Tube& y);
+    const TubeExprBinary<tube_op::Sub,TubeRef,TubeRef> operator-(const Tube& x, const Tube& y);
 
     /** \brief \f$[x](\cdot)-[y]\f$
       * \param x
       * \param y
       * \return Tube output
       */
-    const Tube operator-(const Tube& x, const Interval& y);
+    const TubeExprBinary<tube_op::Sub,TubeRef,TubeExprCst> operator-(const Tube& x, const Interval& y);
 
     /** \brief \f$[x]-[y](\cdot)\f$
       * \param x
       * \param y
       * \return Tube output
       */
-    const Tube operator-(const Interval& x, const Tube& y);
+    const TubeExprBinary<tube_op::Sub,TubeExprCst,TubeRef> operator-(const Interval& x, const Tube& y);
 
     /** \brief \f$[x](\cdot)-y(\cdot)\f$
       * \param x
@@ -312,21 +317,21 @@ namespace codac
       * \param y
       * \return Tube output
       */
-    const Tube operator*(const Tube& x, const Tube& y);
+    const TubeExprBinary<tube_op::Mul,TubeRef,TubeRef> operator*(const Tube& x, const Tube& y);
 
     /** \brief \f$[x](\cdot)\cdot[y]\f$
       * \param x
       * \param y
       * \return Tube output
       */
-    const Tube operator*(const Tube& x, const Interval& y);
+    const TubeExprBinary<tube_op::Mul,TubeRef,TubeExprCst> operator*(const Tube& x, const Interval& y);
 
     /** \brief \f$[x]\cdot[y](\cdot)\f$
       * \param x
       * \param y
       * \return Tube output
       */
-    const Tube operator*(const Interval& x, const Tube& y);
+    const TubeExprBinary<tube_op::Mul,TubeExprCst,TubeRef> operator*(const Interval& x, const Tube& y);
 
     /** \brief \f$[x](\cdot)\cdot y(\cdot)\f$
       * \param x
@@ -348,21 +353,21 @@ namespace codac
       * \param y
       * \return Tube output
       */
-    const Tube operator/(const Tube& x, const Tube& y);
+    const TubeExprBinary<tube_op::Div,TubeRef,TubeRef> operator/(const Tube& x, const Tube& y);
 
     /** \brief \f$[x](\cdot)/[y]\f$
       * \param x
       * \param y
       * \return Tube output
       */
-    const Tube operator/(const Tube& x, const Interval& y);
+    const TubeExprBinary<tube_op::Div,TubeRef,TubeExprCst> operator/(const Tube& x, const Interval& y);
 
     /** \brief \f$[x]/[y](\cdot)\f$
       * \param x
       * \param y
       * \return Tube output
       */
-    const Tube operator/(const Interval& x, const Tube& y);
+    const TubeExprBinary<tube_op::Div,TubeExprCst,TubeRef> operator/(const Interval& x, const Tube& y);
 
     /** \brief \f$[x](\cdot)/y(\cdot)\f$
       * \param x
@@ -384,21 +389,21 @@ namespace codac
       * \param y
       * \return Tube output
       */
-    const Tube operator|(const Tube& x, const Tube& y);
+    const TubeExprBinary<tube_op::Union,TubeRef,TubeRef> operator|(const Tube& x, const Tube& y);
 
     /** \brief \f$[x](\cdot)\sqcup[y]\f$
       * \param x
       * \param y
       * \return Tube output
       */
-    const Tube operator|(const Tube& x, const Interval& y);
+    const TubeExprBinary<tube_op::Union,TubeRef,TubeExprCst> operator|(const Tube& x, const Interval& y);
 
     /** \brief \f$[x]\sqcup[y](\cdot)\f$
       * \param x
       * \param y
       * \return Tube output
       */
-    const Tube operator|(const Interval& x, const Tube& y);
+    const TubeExprBinary<tube_op::Union,TubeExprCst,TubeRef> operator|(const Interval& x, const Tube& y);
 
     /** \brief \f$[x](\cdot)\sqcup y(\cdot)\f$
       * \param x
@@ -420,21 +425,21 @@ namespace codac
       * \param y
       * \return Tube output
       */
-    const Tube operator&(const Tube& x, const Tube& y);
+    const TubeExprBinary<tube_op::Inter,TubeRef,TubeRef> operator&(const Tube& x, const Tube& y);
 
     /** \brief \f$[x](\cdot)\cap[y]\f$
       * \param x
       * \param y
       * \return Tube output
       */
-    const Tube operator&(const Tube& x, const Interval& y);
+    const TubeExprBinary<tube_op::Inter,TubeRef,TubeExprCst> operator&(const Tube& x, const Interval& y);
 
     /** \brief \f$[x]\cap[y](\cdot)\f$
       * \param x
       * \param y
       * \return Tube output
       */
-    const Tube operator&(const Interval& x, const Tube& y);
+    const TubeExprBinary<tube_op::Inter,TubeExprCst,TubeRef> operator&(const Interval& x, const Tube& y);
 
     /** \brief \f$[x](\cdot)\cap y(\cdot)\f$
       * \param x
@@ -450,6 +455,221 @@ namespace codac
       */
     const Tube operator&(const Trajectory& x, const Tube& y);
 
+  /// @}
+  /// \name Scalar outputs from expressions
+  /// @{
+
+    // The following functions compose expressions without evaluating them,
+    // see the above functions for their definitions.
+
+    #define macro_tube_expr_unary(f, Op) \
+      \
+      template<typename E> \
+      inline const TubeExprUnary<tube_op::Op,E> f(const TubeExpr<E>& x) \
+      { \
+        return TubeExprUnary<tube_op::Op,E>(tube_op::Op(), x.derived()); \
+      } \
+      \
+
+    macro_tube_expr_unary(cos, Cos);
+    macro_tube_expr_unary(sin, Sin);
+    macro_tube_expr_unary(abs, Abs);
+    macro_tube_expr_unary(sqr, Sqr);
+    macro_tube_expr_unary(sqrt, Sqrt);
+    macro_tube_expr_unary(exp, Exp);
+    macro_tube_expr_unary(log, Log);
+    macro_tube_expr_unary(tan, Tan);
+    macro_tube_expr_unary(acos, Acos);
+    macro_tube_expr_unary(asin, Asin);
+    macro_tube_expr_unary(atan, Atan);
+    macro_tube_expr_unary(cosh, Cosh);
+    macro_tube_expr_unary(sinh, Sinh);
+    macro_tube_expr_unary(tanh, Tanh);
+    macro_tube_expr_unary(acosh, Acosh);
+    macro_tube_expr_unary(asinh, Asinh);
+    macro_tube_expr_unary(atanh, Atanh);
+    macro_tube_expr_unary(operator-, Neg);
+
+    template<typename E>
+    inline const E operator+(const TubeExpr<E>& x)
+    {
+      return x.derived();
+    }
+
+    template<typename E>
+    inline const TubeExprUnary<tube_op::Pow<int>,E> pow(const TubeExpr<E>& x, int p)
+    {
+      return TubeExprUnary<tube_op::Pow<int>,E>(tube_op::Pow<int>(p), x.derived());
+    }
+
+    template<typename E>
+    inline const TubeExprUnary<tube_op::Pow<double>,E> pow(const TubeExpr<E>& x, double p)
+    {
+      return TubeExprUnary<tube_op::Pow<double>,E>(tube_op::Pow<double>(p), x.derived());
+    }
+
+    template<typename E>
+    inline const TubeExprUnary<tube_op::Pow<Interval>,E> pow(const TubeExpr<E>& x, const Interval& p)
+    {
+      return TubeExprUnary<tube_op::Pow<Interval>,E>(tube_op::Pow<Interval>(p), x.derived());
+    }
+
+    template<typename E>
+    inline const TubeExprUnary<tube_op::Root,E> root(const TubeExpr<E>& x, int p)
+    {
+      return TubeExprUnary<tube_op::Root,E>(tube_op::Root(p), x.derived());
+    }
+
+    #define macro_tube_expr_binary(f, Op) \
+      \
+      template<typename E1, typename E2> \
+      inline const TubeExprBinary<tube_op::Op,E1,E2> f(const TubeExpr<E1>& x1, const TubeExpr<E2>& x2) \
+      { \
+        return TubeExprBinary<tube_op::Op,E1,E2>(x1.derived(), x2.derived()); \
+      } \
+      \
+      template<typename E> \
+      inline const TubeExprBinary<tube_op::Op,E,TubeRef> f(const TubeExpr<E>& x1, const Tube& x2) \
+      { \
+        return TubeExprBinary<tube_op::Op,E,TubeRef>(x1.derived(), TubeRef(x2)); \
+      } \
+      \
+      template<typename E> \
+      inline const TubeExprBinary<tube_op::Op,TubeRef,E> f(const Tube& x1, const TubeExpr<E>& x2) \
+      { \
+        return TubeExprBinary<tube_op::Op,TubeRef,E>(TubeRef(x1), x2.derived()); \
+      } \
+      \
+      template<typename E> \
+      inline const TubeExprBinary<tube_op::Op,E,TubeExprCst> f(const TubeExpr<E>& x1, const Interval& x2) \
+      { \
+        return TubeExprBinary<tube_op::Op,E,TubeExprCst>(x1.derived(), TubeExprCst(x2)); \
+      } \
+      \
+      template<typename E> \
+      inline const TubeExprBinary<tube_op::Op,TubeExprCst,E> f(const Interval& x1, const TubeExpr<E>& x2) \
+      { \
+        return TubeExprBinary<tube_op::Op,TubeExprCst,E>(TubeExprCst(x1), x2.derived()); \
+      } \
+      \
+
+    macro_tube_expr_binary(atan2, Atan2);
+    macro_tube_expr_binary(min, Min);
+    macro_tube_expr_binary(max, Max);
+    macro_tube_expr_binary(operator+, Add);
+    macro_tube_expr_binary(operator-, Sub);
+    macro_tube_expr_binary(operator*, Mul);
+    macro_tube_expr_binary(operator/, Div);
+    macro_tube_expr_binary(operator|, Union);
+    macro_tube_expr_binary(operator&, Inter);
+
+  /// @}
+  /// \name Scalar outputs from temporary tubes
+  /// @{
+
+    // The following overloads take the ownership of temporary tube operands (see TubeExprVal),
+    // so that an expression such as `auto e = sqr(x.primitive()) + 1.;` remains valid.
+    // Const temporaries (for instance returned as `const Tube`) are copied, others are moved.
+
+    #define macro_tube_rvalue_unary(f, Op, X) \
+      \
+      inline const TubeExprUnary<tube_op::Op,TubeVal> f(X x) \
+      { \
+        return TubeExprUnary<tube_op::Op,TubeVal>(tube_op::Op(), TubeVal(std::move(x))); \
+      } \
+      \
+
+    #define macro_tube_rvalue_unary_param(f, Op, p, X) \
+      \
+      inline const TubeExprUnary<tube_op::Op,TubeVal> f(X x, p param) \
+      { \
+        return TubeExprUnary<tube_op::Op,TubeVal>(tube_op::Op(param), TubeVal(std::move(x))); \
+      } \
+      \
+
+    #define macro_tube_rvalue_binary(f, Op, X) \
+      \
+      inline const TubeExprBinary<tube_op::Op,TubeVal,TubeRef> f(X x1, const Tube& x2) \
+      { \
+        return TubeExprBinary<tube_op::Op,TubeVal,TubeRef>(TubeVal(std::move(x1)), TubeRef(x2)); \
+      } \
+      \
+      inline const TubeExprBinary<tube_op::Op,TubeRef,TubeVal> f(const Tube& x1, X x2) \
+      { \
+        return TubeExprBinary<tube_op::Op,TubeRef,TubeVal>(TubeRef(x1), TubeVal(std::move(x2))); \
+      } \
+      \
+      inline const TubeExprBinary<tube_op::Op,TubeVal,TubeVal> f(X x1, Tube&& x2) \
+      { \
+        return TubeExprBinary<tube_op::Op,TubeVal,TubeVal>(TubeVal(std::move(x1)), TubeVal(std::move(x2))); \
+      } \
+      \
+      inline const TubeExprBinary<tube_op::Op,TubeVal,TubeVal> f(X x1, const Tube&& x2) \
+      { \
+        return TubeExprBinary<tube_op::Op,TubeVal,TubeVal>(TubeVal(std::move(x1)), TubeVal(std::move(x2))); \
+      } \
+      \
+      inline const TubeExprBinary<tube_op::Op,TubeVal,TubeExprCst> f(X x1, const Interval& x2) \
+      { \
+        return TubeExprBinary<tube_op::Op,TubeVal,TubeExprCst>(TubeVal(std::move(x1)), TubeExprCst(x2)); \
+      } \
+      \
+      inline const TubeExprBinary<tube_op::Op,TubeExprCst,TubeVal> f(const Interval& x1, X x2) \
+      { \
+        return TubeExprBinary<tube_op::Op,TubeExprCst,TubeVal>(TubeExprCst(x1), TubeVal(std::move(x2))); \
+      } \
+      \
+      template<typename E> \
+      inline const TubeExprBinary<tube_op::Op,E,TubeVal> f(const TubeExpr<E>& x1, X x2) \
+      { \
+        return TubeExprBinary<tube_op::Op,E,TubeVal>(x1.derived(), TubeVal(std::move(x2))); \
+      } \
+      \
+      template<typename E> \
+      inline const TubeExprBinary<tube_op::Op,TubeVal,E> f(X x1, const TubeExpr<E>& x2) \
+      { \
+        return TubeExprBinary<tube_op::Op,TubeVal,E>(TubeVal(std::move(x1)), x2.derived()); \
+      } \
+      \
+
+    #define macro_tube_rvalue(X) \
+      \
+      macro_tube_rvalue_unary(cos, Cos, X); \
+      macro_tube_rvalue_unary(sin, Sin, X); \
+      macro_tube_rvalue_unary(abs, Abs, X); \
+      macro_tube_rvalue_unary(sqr, Sqr, X); \
+      macro_tube_rvalue_unary(sqrt, Sqrt, X); \
+      macro_tube_rvalue_unary(exp, Exp, X); \
+      macro_tube_rvalue_unary(log, Log, X); \
+      macro_tube_rvalue_unary(tan, Tan, X); \
+      macro_tube_rvalue_unary(acos, Acos, X); \
+      macro_tube_rvalue_unary(asin, Asin, X); \
+      macro_tube_rvalue_unary(atan, Atan, X); \
+      macro_tube_rvalue_unary(cosh, Cosh, X); \
+      macro_tube_rvalue_unary(sinh, Sinh, X); \
+      macro_tube_rvalue_unary(tanh, Tanh, X); \
+      macro_tube_rvalue_unary(acosh, Acosh, X); \
+      macro_tube_rvalue_unary(asinh, Asinh, X); \
+      macro_tube_rvalue_unary(atanh, Atanh, X); \
+      macro_tube_rvalue_unary(operator-, Neg, X); \
+      macro_tube_rvalue_unary_param(pow, Pow<int>, int, X); \
+      macro_tube_rvalue_unary_param(pow, Pow<double>, double, X); \
+      macro_tube_rvalue_unary_param(pow, Pow<Interval>, const Interval&, X); \
+      macro_tube_rvalue_unary_param(root, Root, int, X); \
+      macro_tube_rvalue_binary(atan2, Atan2, X); \
+      macro_tube_rvalue_binary(min, Min, X); \
+      macro_tube_rvalue_binary(max, Max, X); \
+      macro_tube_rvalue_binary(operator+, Add, X); \
+      macro_tube_rvalue_binary(operator-, Sub, X); \
+      macro_tube_rvalue_binary(operator*, Mul, X); \
+      macro_tube_rvalue_binary(operator/, Div, X); \
+      macro_tube_rvalue_binary(operator|, Union, X); \
+      macro_tube_rvalue_binary(operator&, Inter, X); \
+      \
+
+    macro_tube_rvalue(Tube&&);
+    macro_tube_rvalue(const Tube&&);
+
   /// @}
   /// \name Vector outputs
   /// @{
@@ -22,245 +22,76 @@ namespace codac
     return x;
   }
 
-  const Tube operator-(const Tube& x)
-  {
-    Tube y(x);
-    Slice *s_y = NULL;
-    const Slice *s_x = NULL;
-
-    do
-    {
-      if(s_y == NULL) // first iteration
-      {
-        s_y = y.first_slice();
-        s_x = x.first_slice();
-      }
-
-      else
-      {
-        s_y = s_y->next_slice();
-        s_x = s_x->next_slice();
-      }
-
-      s_y->set_envelope(-s_x->codomain(), false);
-      s_y->set_input_gate(-s_x->input_gate(), false);
-
-    } while(s_y->next_slice() != NULL);
+  // Operations on Tube and Interval operands only build expressions,
+  // evaluated when assigned to a Tube object (see TubeExpr)
 
-    s_y->set_output_gate(-s_x->output_gate(), false);
-    return y;
-  }
-    
-  #define macro_scal_unary(f) \
+  #define macro_scal_unary(f, Op) \
     \
-    const Tube f(const Tube& x) \
+    const TubeExprUnary<tube_op::Op,TubeRef> f(const Tube& x) \
     { \
-      Tube y(x); \
-      Slice *s_y = NULL; \
-      const Slice *s_x = NULL; \
-      \
-      do \
-      { \
-        if(s_y == NULL) /* first iteration */ \
-        { \
-          s_y = y.first_slice(); \
-          s_x = x.first_slice(); \
-        } \
-        \
-        else \
-        { \
-          s_y = s_y->next_slice(); \
-          s_x = s_x->next_slice(); \
-        } \
-        \
-        s_y->set_envelope(ibex::f(s_x->codomain()), false); \
-        s_y->set_input_gate(ibex::f(s_x->input_gate()), false); \
-        \
-      } while(s_y->next_slice() != NULL); \
-      \
-      s_y->set_output_gate(ibex::f(s_x->output_gate()), false); \
-      return y; \
+      return TubeExprUnary<tube_op::Op,TubeRef>(tube_op::Op(), TubeRef(x)); \
     } \
     \
 
-  macro_scal_unary(cos);
-  macro_scal_unary(sin);
-  macro_scal_unary(abs);
-  macro_scal_unary(sqr);
-  macro_scal_unary(sqrt);
-  macro_scal_unary(exp);
-  macro_scal_unary(log);
-  macro_scal_unary(tan);
-  macro_scal_unary(acos);
-  macro_scal_unary(asin);
-  macro_scal_unary(atan);
-  macro_scal_unary(cosh);
-  macro_scal_unary(sinh);
-  macro_scal_unary(tanh);
-  macro_scal_unary(acosh);
-  macro_scal_unary(asinh);
-  macro_scal_unary(atanh);
+  macro_scal_unary(operator-, Neg);
+  macro_scal_unary(cos, Cos);
+  macro_scal_unary(sin, Sin);
+  macro_scal_unary(abs, Abs);
+  macro_scal_unary(sqr, Sqr);
+  macro_scal_unary(sqrt, Sqrt);
+  macro_scal_unary(exp, Exp);
+  macro_scal_unary(log, Log);
+  macro_scal_unary(tan, Tan);
+  macro_scal_unary(acos, Acos);
+  macro_scal_unary(asin, Asin);
+  macro_scal_unary(atan, Atan);
+  macro_scal_unary(cosh, Cosh);
+  macro_scal_unary(sinh, Sinh);
+  macro_scal_unary(tanh, Tanh);
+  macro_scal_unary(acosh, Acosh);
+  macro_scal_unary(asinh, Asinh);
+  macro_scal_unary(atanh, Atanh);
     
-  #define macro_scal_unary_param(f, p) \
+  #define macro_scal_unary_param(f, Op, p) \
     \
-    const Tube f(const Tube& x, p param) \
+    const TubeExprUnary<tube_op::Op,TubeRef> f(const Tube& x, p param) \
     { \
-      Tube y(x); \
-      Slice *s_y = NULL; \
-      const Slice *s_x = NULL; \
-      \
-      do \
-      { \
-        if(s_y == NULL) /* first iteration */ \
-        { \
-          s_y = y.first_slice(); \
-          s_x = x.first_slice(); \
-        } \
-        \
-        else \
-        { \
-          s_y = s_y->next_slice(); \
-          s_x = s_x->next_slice(); \
-        } \
-        \
-        s_y->set_envelope(ibex::f(s_x->codomain(), param), false); \
-        s_y->set_input_gate(ibex::f(s_x->input_gate(), param), false); \
-        \
-      } while(s_y->next_slice() != NULL); \
-      \
-      s_y->set_output_gate(ibex::f(s_x->output_gate(), param), false); \
-      return y; \
+      return TubeExprUnary<tube_op::Op,TubeRef>(tube_op::Op(param), TubeRef(x)); \
     } \
     \
 
-  macro_scal_unary_param(pow, int);
-  macro_scal_unary_param(pow, double);
-  macro_scal_unary_param(pow, const Interval&);
-  macro_scal_unary_param(root, int);
+  macro_scal_unary_param(pow, Pow<int>, int);
+  macro_scal_unary_param(pow, Pow<double>, double);
+  macro_scal_unary_param(pow, Pow<Interval>, const Interval&);
+  macro_scal_unary_param(root, Root, int);
 
-  #define macro_scal_binary(f) \
+  #define macro_scal_binary(f, Op) \
     \
-    const Tube f(const Tube& x1, const Tube& x2) \
+    const TubeExprBinary<tube_op::Op,TubeRef,TubeRef> f(const Tube& x1, const Tube& x2) \
     { \
-      assert(x1.tdomain() == x2.tdomain()); \
-      \
-      Tube y(x1); \
-      const Slice *s_x1, *s_x2; \
-      \
-      Tube *x1_resampled = NULL; /* In case of different slicing between x1 and x2, */ \
-      Tube *x2_resampled = NULL; /* copies of x1 and x2 will be made and equally resampled. */ \
-      \
-      if(Tube::same_slicing(x1, x2)) /* faster, no sampling computation needed */ \
-      { \
-        s_x1 = x1.first_slice(); \
-        s_x2 = x2.first_slice(); \
-      } \
-      \
-      else \
-      { \
-        x1_resampled = new Tube(x1); \
-        x2_resampled = new Tube(x2); \
-        x1_resampled->sample(x2); /* common sampling */ \
-        x2_resampled->sample(x1); \
-        y.sample(*x2_resampled); \
-        s_x1 = x1_resampled->first_slice(); \
-        s_x2 = x2_resampled->first_slice(); \
-      } \
-      \
-      Slice *s_y = NULL; \
-      do \
-      { \
-        if(s_y == NULL) /* first iteration */ \
-          s_y = y.first_slice(); \
-        \
-        else \
-        { \
-          s_y = s_y->next_slice(); \
-          s_x1 = s_x1->next_slice(); \
-          s_x2 = s_x2->next_slice(); \
-        } \
-        \
-        s_y->set_envelope(ibex::f(s_x1->codomain(), s_x2->codomain()), false); \
-        s_y->set_input_gate(ibex::f(s_x1->input_gate(), s_x2->input_gate()), false); \
-        \
-      } while(s_y->next_slice() != NULL); \
-      \
-      s_y->set_output_gate(ibex::f(s_x1->output_gate(), s_x2->output_gate()), false); \
-      \
-      if(x1_resampled != NULL) delete x1_resampled; \
-      if(x2_resampled != NULL) delete x2_resampled; \
-      return y; \
+      return TubeExprBinary<tube_op::Op,TubeRef,TubeRef>(TubeRef(x1), TubeRef(x2)); \
     } \
     \
-    const Tube f(const Tube& x1, const Interval& x2) \
+    const TubeExprBinary<tube_op::Op,TubeRef,TubeExprCst> f(const Tube& x1, const Interval& x2) \
     { \
-      Tube y(x1); \
-      Slice *s_y = NULL; \
-      const Slice *s_x1 = NULL; \
-      \
-      do \
-      { \
-        if(s_y == NULL) /* first iteration */ \
-        { \
-          s_y = y.first_slice(); \
-          s_x1 = x1.first_slice(); \
-        } \
-        \
-        else \
-        { \
-          s_y = s_y->next_slice(); \
-          s_x1 = s_x1->next_slice(); \
-        } \
-        \
-        s_y->set_envelope(ibex::f(s_x1->codomain(), x2), false); \
-        s_y->set_input_gate(ibex::f(s_x1->input_gate(), x2), false); \
-        \
-      } while(s_y->next_slice() != NULL); \
-      \
-      s_y->set_output_gate(ibex::f(s_x1->output_gate(), x2), false); \
-      \
-      return y; \
+      return TubeExprBinary<tube_op::Op,TubeRef,TubeExprCst>(TubeRef(x1), TubeExprCst(x2)); \
     } \
     \
-    const Tube f(const Interval& x1, const Tube& x2) \
+    const TubeExprBinary<tube_op::Op,TubeExprCst,TubeRef> f(const Interval& x1, const Tube& x2) \
     { \
-      Tube y(x2); \
-      Slice *s_y = NULL; \
-      const Slice *s_x2 = NULL; \
-      \
-      do \
-      { \
-        if(s_y == NULL) /* first iteration */ \
-        { \
-          s_y = y.first_slice(); \
-          s_x2 = x2.first_slice(); \
-        } \
-        \
-        else \
-        { \
-          s_y = s_y->next_slice(); \
-          s_x2 = s_x2->next_slice(); \
-        } \
-        \
-        s_y->set_envelope(ibex::f(x1, s_x2->codomain()), false); \
-        s_y->set_input_gate(ibex::f(x1, s_x2->input_gate()), false); \
-        \
-      } while(s_y->next_slice() != NULL); \
-      \
-      s_y->set_output_gate(ibex::f(x1, s_x2->output_gate()), false); \
-      \
-      return y; \
+      return TubeExprBinary<tube_op::Op,TubeExprCst,TubeRef>(TubeExprCst(x1), TubeRef(x2)); \
     } \
+    \
 
-  macro_scal_binary(operator+);
-  macro_scal_binary(operator-);
-  macro_scal_binary(operator*);
-  macro_scal_binary(operator/);
-  macro_scal_binary(operator|);
-  macro_scal_binary(operator&);
-  macro_scal_binary(atan2);
-  macro_scal_binary(min);
-  macro_scal_binary(max);
+  macro_scal_binary(operator+, Add);
+  macro_scal_binary(operator-, Sub);
+  macro_scal_binary(operator*, Mul);
+  macro_scal_binary(operator/, Div);
+  macro_scal_binary(operator|, Union);
+  macro_scal_binary(operator&, Inter);
+  macro_scal_binary(atan2, Atan2);
+  macro_scal_binary(min, Min);
+  macro_scal_binary(max, Max);
 
   #define macro_scal_binary_traj(f, feq) \
     \
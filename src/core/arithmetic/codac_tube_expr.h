@@ -0,0 +1,357 @@
+/**
+ *  \file
+ *  Lazy expressions on tubes
+ * ----------------------------------------------------------------------------
+ *  \date       2021
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_TUBE_EXPR_H__
+#define __CODAC_TUBE_EXPR_H__
+
+#include <cassert>
+#include <memory>
+#include <utility>
+#include "codac_Interval.h"
+
+// The classes of this file do not require the definition of the Tube class:
+// their methods are only instantiated when a Tube object is built from an expression.
+
+namespace codac
+{
+  class Tube;
+
+  /**
+   * \class TubeExpr
+   * \brief Base class of lazy arithmetic expressions on tubes
+   *
+   * \note Arithmetic operators and functions on tubes return expressions instead of tubes.
+   *       No computation is performed until an expression is assigned to a Tube object:
+   *       the whole expression is then evaluated in a single pass over the slices,
+   *       and only the resulting tube is allocated.
+   * \note The read-only accessors of Tube (tdomain, codomain, evaluations, volume) are
+   *       available on expressions. Other methods require to build a Tube from the expression.
+   * \note Expressions refer to their lvalue tube operands: they must not be stored (for
+   *       instance with `auto`) beyond the lifetime of these tubes. Temporary tubes are
+   *       kept alive by the expression (see `TubeExprVal`).
+   *
+   * \param E the derived expression class (curiously recurring template pattern)
+   */
+  template<typename E>
+  class TubeExpr
+  {
+    public:
+
+      /**
+       * \brief Returns the derived expression object
+       *
+       * \return a const reference to the expression
+       */
+      const E& derived() const
+      {
+        return static_cast<const E&>(*this);
+      }
+
+      /**
+       * \brief Returns the temporal definition domain of the expression
+       *
+       * \return an Interval object \f$[t_0,t_f]\f$
+       */
+      const Interval tdomain() const;
+
+      /**
+       * \brief Returns the envelope of the values of the expression
+       *
+       * \note The expression is evaluated without building a tube if its operands share the same slicing
+       *
+       * \return the result \f$[x]([t_0,t_f])\f$
+       */
+      const Interval codomain() const;
+
+      /**
+       * \brief Returns the number of slices of the tube resulting from the expression
+       *
+       * \return the number of slices of the common slicing of the operands
+       */
+      int nb_slices() const;
+
+      /**
+       * \brief Returns the volume of the tube resulting from the expression
+       *
+       * \note The expression is evaluated without building a tube if its operands share the same slicing
+       *
+       * \return the volume, see `Tube::volume()`
+       */
+      double volume() const;
+
+      /**
+       * \brief Returns the evaluation of the expression at \f$t\f$, without building a tube
+       *
+       * \param t the temporal key (double, must belong to the tdomain of the expression)
+       * \return Interval value of \f$[x](t)\f$, see `Tube::operator()(double)`
+       */
+      const Interval operator()(double t) const;
+
+      /**
+       * \brief Returns the envelope of the expression over \f$[t]\f$
+       *
+       * \note The expression is evaluated without building a tube if its operands share the same slicing
+       *
+       * \param t the subtdomain (Interval, must be a subset of the tdomain of the expression)
+       * \return Interval envelope \f$[x]([t])\f$, see `Tube::operator()(const Interval&)`
+       */
+      const Interval operator()(const Interval& t) const;
+  };
+
+  /**
+   * \class TubeExprRef
+   * \brief Tube operand of an expression, referred without copy
+   *
+   * \note Evaluations are made either by slice indexes, when all the operands of an
+   *       expression share the same slicing, or by times otherwise.
+   */
+  template<typename T>
+  class TubeExprRef : public TubeExpr<TubeExprRef<T> >
+  {
+    public:
+
+      explicit TubeExprRef(const T& x) : m_x(x) { }
+      const Tube* tube() const { return &m_x; }
+      bool same_slicing(const Tube& y) const { return T::same_slicing(m_x, y); }
+      template<typename Y> void sample(Y& y) const { y.sample(m_x); }
+
+      const Interval slice_codomain(int k) const { return m_x.slice(k)->codomain(); }
+      const Interval gate(int k) const { return k < m_x.nb_slices() ? m_x.slice(k)->input_gate() : m_x.last_slice()->output_gate(); }
+      const Interval codomain_at(const Interval& t) const { return m_x.slice(t.mid())->codomain(); }
+      const Interval gate_at(double t) const { return m_x(t); }
+
+    protected:
+
+      const T& m_x; //!< referred tube
+  };
+
+  /**
+   * \class TubeExprVal
+   * \brief Temporary tube operand of an expression, owned by the expression
+   *
+   * \note The tube is moved (or copied, if const) when the expression is built, and
+   *       shared by the copies of the expression made when composing it.
+   */
+  template<typename T>
+  class TubeExprVal : public TubeExpr<TubeExprVal<T> >
+  {
+    public:
+
+      explicit TubeExprVal(T x) : m_x(std::make_shared<const T>(std::move(x))) { }
+      const Tube* tube() const { return m_x.get(); }
+      bool same_slicing(const Tube& y) const { return T::same_slicing(*m_x, y); }
+      template<typename Y> void sample(Y& y) const { y.sample(*m_x); }
+
+      const Interval slice_codomain(int k) const { return m_x->slice(k)->codomain(); }
+      const Interval gate(int k) const { return k < m_x->nb_slices() ? m_x->slice(k)->input_gate() : m_x->last_slice()->output_gate(); }
+      const Interval codomain_at(const Interval& t) const { return m_x->slice(t.mid())->codomain(); }
+      const Interval gate_at(double t) const { return (*m_x)(t); }
+
+    protected:
+
+      std::shared_ptr<const T> m_x; //!< owned tube
+  };
+
+  /**
+   * \class TubeExprCst
+   * \brief Constant interval operand of an expression
+   */
+  class TubeExprCst : public TubeExpr<TubeExprCst>
+  {
+    public:
+
+      explicit TubeExprCst(const Interval& x) : m_x(x) { }
+      const Tube* tube() const { return NULL; }
+      bool same_slicing(const Tube& y) const { return true; }
+      template<typename Y> void sample(Y& y) const { }
+
+      const Interval slice_codomain(int k) const { return m_x; }
+      const Interval gate(int k) const { return m_x; }
+      const Interval codomain_at(const Interval& t) const { return m_x; }
+      const Interval gate_at(double t) const { return m_x; }
+
+    protected:
+
+      const Interval m_x; //!< constant value
+  };
+
+  /**
+   * \class TubeExprUnary
+   * \brief Unary operation \f$f([x](\cdot))\f$ in an expression
+   *
+   * \param Op the function object computing \f$f\f$ on intervals
+   * \param E the type of the operand expression
+   */
+  template<typename Op, typename E>
+  class TubeExprUnary : public TubeExpr<TubeExprUnary<Op,E> >
+  {
+    public:
+
+      explicit TubeExprUnary(const Op& op, const E& x) : m_op(op), m_x(x) { }
+      const Tube* tube() const { return m_x.tube(); }
+      bool same_slicing(const Tube& y) const { return m_x.same_slicing(y); }
+      template<typename Y> void sample(Y& y) const { m_x.sample(y); }
+
+      const Interval slice_codomain(int k) const { return m_op(m_x.slice_codomain(k)); }
+      const Interval gate(int k) const { return m_op(m_x.gate(k)); }
+      const Interval codomain_at(const Interval& t) const { return m_op(m_x.codomain_at(t)); }
+      const Interval gate_at(double t) const { return m_op(m_x.gate_at(t)); }
+
+    protected:
+
+      const Op m_op; //!< function, possibly parameterized
+      const E m_x; //!< operand
+  };
+
+  /**
+   * \class TubeExprBinary
+   * \brief Binary operation \f$f([x_1](\cdot),[x_2](\cdot))\f$ in an expression
+   *
+   * \param Op the function object computing \f$f\f$ on intervals
+   * \param E1 the type of the first operand expression
+   * \param E2 the type of the second operand expression
+   */
+  template<typename Op, typename E1, typename E2>
+  class TubeExprBinary : public TubeExpr<TubeExprBinary<Op,E1,E2> >
+  {
+    public:
+
+      explicit TubeExprBinary(const E1& x1, const E2& x2) : m_x1(x1), m_x2(x2)
+      {
+        assert((x1.tube() == NULL || x2.tube() == NULL || x1.tdomain() == x2.tdomain())
+          && "operands must share the same tdomain");
+      }
+
+      const Tube* tube() const { return m_x1.tube() != NULL ? m_x1.tube() : m_x2.tube(); }
+      bool same_slicing(const Tube& y) const { return m_x1.same_slicing(y) && m_x2.same_slicing(y); }
+      template<typename Y> void sample(Y& y) const { m_x1.sample(y); m_x2.sample(y); }
+
+      const Interval slice_codomain(int k) const { return Op()(m_x1.slice_codomain(k), m_x2.slice_codomain(k)); }
+      const Interval gate(int k) const { return Op()(m_x1.gate(k), m_x2.gate(k)); }
+      const Interval codomain_at(const Interval& t) const { return Op()(m_x1.codomain_at(t), m_x2.codomain_at(t)); }
+      const Interval gate_at(double t) const { return Op()(m_x1.gate_at(t), m_x2.gate_at(t)); }
+
+    protected:
+
+      const E1 m_x1; //!< first operand
+      const E2 m_x2; //!< second operand
+  };
+
+  /**
+   * \brief Evaluates an expression on the slices of a tube, possibly in parallel
+   *
+   * \note If the operands of the expression do not share the slicing of \f$[y](\cdot)\f$,
+   *       this slicing must be a refinement of theirs (see `TubeExprRef`).
+   *
+   * \param y the tube receiving the values, possibly an operand of the expression
+   * \param x the expression
+   */
+  template<typename Y, typename E>
+  void eval_tube_expr(Y& y, const TubeExpr<E>& x)
+  {
+    const E& e = x.derived();
+    const bool same_slicing = e.same_slicing(y);
+
+    y.for_each_slice_range([&](int k0, int k1)
+    {
+      for(int k = k0 ; k < k1 ; k++)
+      {
+        if(same_slicing)
+        {
+          y.slice(k)->set_envelope(e.slice_codomain(k), false);
+          y.slice(k)->set_input_gate(e.gate(k), false);
+        }
+
+        else
+        {
+          const Interval t = y.slice(k)->tdomain();
+          y.slice(k)->set_envelope(e.codomain_at(t), false);
+          y.slice(k)->set_input_gate(e.gate_at(t.lb()), false);
+        }
+      }
+    });
+
+    y.last_slice()->set_output_gate(
+      same_slicing ? e.gate(y.nb_slices()) : e.gate_at(y.tdomain().ub()), false);
+  }
+
+  namespace tube_op
+  {
+    #define macro_tube_op_unary(Op, f) \
+      \
+      struct Op \
+      { \
+        const Interval operator()(const Interval& x) const { return ibex::f(x); } \
+      }; \
+      \
+
+    macro_tube_op_unary(Cos, cos);
+    macro_tube_op_unary(Sin, sin);
+    macro_tube_op_unary(Abs, abs);
+    macro_tube_op_unary(Sqr, sqr);
+    macro_tube_op_unary(Sqrt, sqrt);
+    macro_tube_op_unary(Exp, exp);
+    macro_tube_op_unary(Log, log);
+    macro_tube_op_unary(Tan, tan);
+    macro_tube_op_unary(Acos, acos);
+    macro_tube_op_unary(Asin, asin);
+    macro_tube_op_unary(Atan, atan);
+    macro_tube_op_unary(Cosh, cosh);
+    macro_tube_op_unary(Sinh, sinh);
+    macro_tube_op_unary(Tanh, tanh);
+    macro_tube_op_unary(Acosh, acosh);
+    macro_tube_op_unary(Asinh, asinh);
+    macro_tube_op_unary(Atanh, atanh);
+
+    struct Neg
+    {
+      const Interval operator()(const Interval& x) const { return -x; }
+    };
+
+    template<typename P>
+    struct Pow
+    {
+      explicit Pow(const P& p) : p(p) { }
+      const Interval operator()(const Interval& x) const { return ibex::pow(x, p); }
+      const P p;
+    };
+
+    struct Root
+    {
+      explicit Root(int p) : p(p) { }
+      const Interval operator()(const Interval& x) const { return ibex::root(x, p); }
+      const int p;
+    };
+
+    #define macro_tube_op_binary(Op, expr) \
+      \
+      struct Op \
+      { \
+        const Interval operator()(const Interval& x1, const Interval& x2) const { return expr; } \
+      }; \
+      \
+
+    macro_tube_op_binary(Add, x1 + x2);
+    macro_tube_op_binary(Sub, x1 - x2);
+    macro_tube_op_binary(Mul, x1 * x2);
+    macro_tube_op_binary(Div, x1 / x2);
+    macro_tube_op_binary(Union, x1 | x2);
+    macro_tube_op_binary(Inter, x1 & x2);
+    macro_tube_op_binary(Atan2, ibex::atan2(x1, x2));
+    macro_tube_op_binary(Min, ibex::min(x1, x2));
+    macro_tube_op_binary(Max, ibex::max(x1, x2));
+  }
+
+  typedef TubeExprRef<Tube> TubeRef; //!< tube operand of an expression
+  typedef TubeExprVal<Tube> TubeVal; //!< temporary tube operand of an expression
+}
+
+#endif
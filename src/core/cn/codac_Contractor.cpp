@@ -8,6 +8,7 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <limits>
 #include "codac_Contractor.h"
 #include "codac_CtcEval.h"
 #include "codac_CtcDeriv.h"
@@ -321,7 +322,12 @@ namespace codac
 
     else if(m_type == Type::T_CODAC)
     {
-      m_dyn_ctc.get().contract(m_v_domains);
+      if(m_dyn_ctc.get().is_incremental())
+        m_dyn_ctc.get().contract_incremental(m_v_domains, m_dirty_tdomain);
+      else
+        m_dyn_ctc.get().contract(m_v_domains);
+
+      m_dirty_tdomain = Interval::EMPTY_SET;
     }
 
     else if(m_type == Type::T_COMPONENT)
@@ -376,7 +382,71 @@ namespace codac
     else
       assert(false && "unhandled case");
   }
+
+  void Contractor::add_dirty_tdomain(const Interval& t)
+  {
+    m_dirty_tdomain |= t;
+  }
   
+  void Contractor::record_contraction(double duration, double volume_ratio)
+  {
+    // Exponential moving averages, so that priorities follow the evolution of the domains
+    const double alpha = m_nb_contractions == 0 ? 1. : 0.5;
+    double reduction = 1. - volume_ratio;
+    if(!(reduction >= 0.)) // undefined ratio (degenerated or unbounded domains)
+      reduction = 0.;
+
+    m_avg_reduction += alpha * (reduction - m_avg_reduction);
+    m_avg_duration += alpha * (duration - m_avg_duration);
+    m_total_reduction += reduction;
+    m_total_duration += duration;
+    m_nb_contractions++;
+  }
+
+  void Contractor::record_trigger()
+  {
+    m_nb_triggers++;
+  }
+
+  double Contractor::priority() const
+  {
+    // Components contractors are symbolic: they only relay the propagation
+    if(m_type == Type::T_COMPONENT || m_nb_contractions == 0)
+      return numeric_limits<double>::infinity();
+
+    return m_avg_reduction / (m_avg_duration + 1e-9);
+  }
+
+  int Contractor::nb_contractions() const
+  {
+    return m_nb_contractions;
+  }
+
+  int Contractor::nb_triggers() const
+  {
+    return m_nb_triggers;
+  }
+
+  double Contractor::total_duration() const
+  {
+    return m_total_duration;
+  }
+
+  double Contractor::total_reduction() const
+  {
+    return m_total_reduction;
+  }
+
+  void Contractor::reset_statistics()
+  {
+    m_nb_contractions = 0;
+    m_nb_triggers = 0;
+    m_avg_reduction = 0.;
+    m_avg_duration = 0.;
+    m_total_reduction = 0.;
+    m_total_duration = 0.;
+  }
+
   const string Contractor::name() const
   {
     switch(type())
@@ -58,6 +58,17 @@ namespace codac
       bool operator==(const Contractor& x) const;
 
       void contract();
+      void add_dirty_tdomain(const Interval& t);
+
+      void record_contraction(double duration, double volume_ratio);
+      void record_trigger();
+      double priority() const;
+
+      int nb_contractions() const;
+      int nb_triggers() const;
+      double total_duration() const;
+      double total_reduction() const;
+      void reset_statistics();
 
       const std::string name() const;
       void set_name(const std::string& name);
@@ -77,10 +88,19 @@ namespace codac
       };
 
       std::vector<Domain*> m_v_domains;
+      Interval m_dirty_tdomain = Interval::ALL_REALS; // contracted part of the domains since the last contraction (incremental contractors)
 
       std::string m_name;
       int m_ctc_id;
 
+      // Statistics observed during the contractions (used for scheduling and profiling)
+      int m_nb_contractions = 0;
+      int m_nb_triggers = 0; // number of activations due to the contraction of a related domain
+      double m_avg_reduction = 0.; // averaged relative volume reduction of the domains
+      double m_avg_duration = 0.; // averaged computation time, in seconds
+      double m_total_reduction = 0.; // cumulated relative volume reduction of the domains
+      double m_total_duration = 0.; // cumulated computation time, in seconds
+
       static int ctc_counter;
       
       friend class ContractorHashcode;
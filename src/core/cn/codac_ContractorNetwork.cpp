@@ -8,8 +8,10 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <algorithm>
 #include "codac_ContractorNetwork.h"
 #include "codac_CtcEval.h"
+#include "codac_ThreadPool.h"
 #include "codac_Exception.h"
 #include "codac_DomainsTypeException.h"
 
@@ -36,6 +38,9 @@ namespace codac
 
       if(m_ctc_deriv != NULL)
         delete m_ctc_deriv;
+
+      if(m_pool != NULL)
+        delete m_pool;
     }
 
     int ContractorNetwork::nb_ctc() const
@@ -165,84 +170,18 @@ namespace codac
       for(auto& dom : v_domains)
         add_dom(dom);
 
-      for(int i = 0 ; i < n/static_ctc.nb_var ; i++) // in case we are dealing with array data
-      {
-        int k = 0; // k-th slice
-        int slices_nb = -1; // will be determined during the dowhile loop, if one dyn domain is present
+      add_on_slices(static_ctc, v_domains);
 
-        do
-        {
-          // Creating a vector of pointers to domains
-          vector<Domain*> v_dom_ptr;
-          for(auto& dom : v_domains)
+      // Recording the constraint for the slices to come (streaming mode)
+      if(!Domain::all_slices(v_domains))
+        for(const auto& dom : v_domains)
+          if(dom.type() == Domain::Type::T_TUBE || dom.type() == Domain::Type::T_TUBE_VECTOR)
           {
-            switch(dom.type())
-            {
-              case Domain::Type::T_INTERVAL:
-                assert(n/static_ctc.nb_var == 1); // no array configuration with scalar type
-              case Domain::Type::T_SLICE:
-                v_dom_ptr.push_back(add_dom(dom));
-                break;
-
-              case Domain::Type::T_INTERVAL_VECTOR:
-                if(n/static_ctc.nb_var == 1) // heterogeneous case
-                {
-                  // todo: ? add the vector itself, or each component as it is now:
-                  for(int j = 0 ; j < dom.interval_vector().size() ; j++)
-                    v_dom_ptr.push_back(add_dom(Domain::vector_component(const_cast<Domain&>(dom), j)));
-                }
-
-                else // array data case
-                {
-                  if(dom.interval_vector().size() != n/static_ctc.nb_var)
-                    throw Exception(__func__, "wrong vector dimension");
-                  v_dom_ptr.push_back(add_dom(Domain::vector_component(const_cast<Domain&>(dom), i)));
-                }
-                break;
-
-              case Domain::Type::T_TUBE:
-                assert(n/static_ctc.nb_var == 1); // no array configuration with scalar type
-                v_dom_ptr.push_back(add_dom(Domain(const_cast<Slice&>(*dom.tube().slice(k)))));
-                slices_nb = dom.tube().nb_slices();
-                break;
-
-              case Domain::Type::T_TUBE_VECTOR:
-                if(n/static_ctc.nb_var == 1) // heterogeneous case
-                {
-                  for(int j = 0 ; j < dom.tube_vector().size() ; j++)
-                    v_dom_ptr.push_back(add_dom(Domain(const_cast<Slice&>(*dom.tube_vector()[j].slice(k)))));
-                }
-
-                else // array data case
-                {
-                  if(dom.tube_vector().size() != n/static_ctc.nb_var)
-                    throw Exception(__func__, "wrong vector dimension");
-                  v_dom_ptr.push_back(add_dom(Domain(const_cast<Slice&>(*dom.tube_vector()[i].slice(k)))));
-                }
-
-                slices_nb = dom.tube_vector().nb_slices();
-                break;
-
-              default:
-                assert(false && "unhandled case");
-            }
+            auto p = make_pair(&static_ctc, v_domains);
+            if(find(m_v_static_ctc_on_slices.begin(), m_v_static_ctc_on_slices.end(), p) == m_v_static_ctc_on_slices.end())
+              m_v_static_ctc_on_slices.push_back(p);
+            break;
           }
-
-          assert((int)v_dom_ptr.size() == static_ctc.nb_var);
-
-          // Creating what would be this new contractor (defined with domains)
-          Contractor ctc(static_ctc, v_dom_ptr);
-
-          // Getting the actual contractor (maybe the same if not already added)
-          Contractor *ctc_ptr = add_ctc(ctc);
-
-          // Linking to the related domains
-          for(auto& dom : v_dom_ptr)
-            dom->add_ctc(ctc_ptr);
-
-          k++;
-        } while(k < slices_nb);
-      }
     }
 
     void ContractorNetwork::add(DynCtc& dyn_ctc, const vector<Domain>& v_domains)
@@ -307,54 +246,19 @@ namespace codac
         if(!Domain::dyn_same_slicing(v_domains))
           throw Exception(__func__, "domains do not have same slicing");
 
-        vector<const Slice*> v_slices;
-
-        // Vector initialization with first slices of each tube
-        int nb_slices = -1;
         for(const auto& dom : v_domains)
         {
+          if(dom.type() != Domain::Type::T_TUBE && dom.type() != Domain::Type::T_TUBE_VECTOR)
+            throw Exception(__func__, "domain is not a tube or a tube vector");
           add_dom(dom);
-
-          switch(dom.type())
-          {
-            case Domain::Type::T_TUBE:
-            {
-              if(nb_slices == -1)
-                nb_slices = dom.tube().nb_slices();
-
-              v_slices.push_back(dom.tube().first_slice());
-            }
-            break;
-
-            case Domain::Type::T_TUBE_VECTOR:
-            {            
-              for(int j = 0 ; j < dom.tube_vector().size() ; j++)
-              {
-                if(nb_slices == -1)
-                  nb_slices = dom.tube_vector()[j].nb_slices();
-
-                v_slices.push_back(dom.tube_vector()[j].first_slice());
-              }
-            }
-            break;
-
-            default:
-              throw Exception(__func__, "domain is not a tube or a tube vector");
-          }
         }
 
-        // Adding each row of slices
-        for(int k = 0 ; k < nb_slices ; k++)
-        {
-          vector<Domain> v_slices_domains(v_slices.size());
-          for(size_t i = 0 ; i < v_slices.size() ; i++)
-            v_slices_domains[i] = Domain(const_cast<Slice&>(*v_slices[i]));
-
-          add(dyn_ctc, v_slices_domains); 
+        add_on_slices(dyn_ctc, v_domains);
 
-          for(auto& s : v_slices)
-            s = s->next_slice();
-        }
+        // Recording the constraint for the slices to come (streaming mode)
+        auto p = make_pair(&dyn_ctc, v_domains);
+        if(find(m_v_dyn_ctc_on_slices.begin(), m_v_dyn_ctc_on_slices.end(), p) == m_v_dyn_ctc_on_slices.end())
+          m_v_dyn_ctc_on_slices.push_back(p);
       }
 
       else // otherwise, dealing with the inter-temporal constraint as it is
@@ -380,30 +284,228 @@ namespace codac
     {
       Domain *ad = add_dom(Domain(tube));
       assert(ad->type() == Domain::Type::T_TUBE);
+
+      if(streaming() && t > tube.tdomain().ub())
+        extend_tdomain(t);
+
       ad->add_data(t, y, *this);
+
+      if(streaming() && m_streaming_horizon != numeric_limits<double>::infinity())
+        evict_before(t - m_streaming_horizon);
     }
     
     void ContractorNetwork::add_data(TubeVector& tube, double t, const IntervalVector& y)
     {
       Domain *ad = add_dom(Domain(tube));
       assert(ad->type() == Domain::Type::T_TUBE_VECTOR);
+
+      if(streaming() && t > tube.tdomain().ub())
+        extend_tdomain(t);
+
       ad->add_data(t, y, *this);
+
+      if(streaming() && m_streaming_horizon != numeric_limits<double>::infinity())
+        evict_before(t - m_streaming_horizon);
+    }
+
+    void ContractorNetwork::add_data(Tube& tube, const vector<double>& v_t, const vector<Interval>& v_y)
+    {
+      Domain *ad = add_dom(Domain(tube));
+      assert(ad->type() == Domain::Type::T_TUBE);
+
+      if(v_t.empty())
+        return;
+
+      if(streaming() && v_t.back() > tube.tdomain().ub())
+      {
+        // The batch is checked first: the tdomain is not extended for rejected data
+        if(v_t.size() != v_y.size())
+          throw Exception(__func__, "times and values not of same size");
+        ad->check_data(v_t);
+        extend_tdomain(v_t.back());
+      }
+
+      ad->add_data(v_t, v_y, *this);
+
+      if(streaming() && m_streaming_horizon != numeric_limits<double>::infinity())
+        evict_before(v_t.back() - m_streaming_horizon);
+    }
+    
+    void ContractorNetwork::add_data(TubeVector& tube, const vector<double>& v_t, const vector<IntervalVector>& v_y)
+    {
+      Domain *ad = add_dom(Domain(tube));
+      assert(ad->type() == Domain::Type::T_TUBE_VECTOR);
+
+      if(v_t.empty())
+        return;
+
+      if(streaming() && v_t.back() > tube.tdomain().ub())
+      {
+        ad->check_data(v_t, v_y, *this); // the tdomain is not extended for rejected data
+        extend_tdomain(v_t.back());
+      }
+
+      ad->add_data(v_t, v_y, *this);
+
+      if(streaming() && m_streaming_horizon != numeric_limits<double>::infinity())
+        evict_before(v_t.back() - m_streaming_horizon);
     }
 
   // Protected methods
 
+    void ContractorNetwork::add_on_slices(Ctc& static_ctc, const vector<Domain>& v_domains, int k0)
+    {
+      int n = Domain::total_size(v_domains);
+
+      for(int i = 0 ; i < n/static_ctc.nb_var ; i++) // in case we are dealing with array data
+      {
+        int k = k0; // k-th slice
+        int slices_nb = -1; // will be determined during the dowhile loop, if one dyn domain is present
+
+        do
+        {
+          // Creating a vector of pointers to domains
+          vector<Domain*> v_dom_ptr;
+          for(auto& dom : v_domains)
+          {
+            switch(dom.type())
+            {
+              case Domain::Type::T_INTERVAL:
+                assert(n/static_ctc.nb_var == 1); // no array configuration with scalar type
+              case Domain::Type::T_SLICE:
+                v_dom_ptr.push_back(add_dom(dom));
+                break;
+
+              case Domain::Type::T_INTERVAL_VECTOR:
+                if(n/static_ctc.nb_var == 1) // heterogeneous case
+                {
+                  // todo: ? add the vector itself, or each component as it is now:
+                  for(int j = 0 ; j < dom.interval_vector().size() ; j++)
+                    v_dom_ptr.push_back(add_dom(Domain::vector_component(const_cast<Domain&>(dom), j)));
+                }
+
+                else // array data case
+                {
+                  if(dom.interval_vector().size() != n/static_ctc.nb_var)
+                    throw Exception(__func__, "wrong vector dimension");
+                  v_dom_ptr.push_back(add_dom(Domain::vector_component(const_cast<Domain&>(dom), i)));
+                }
+                break;
+
+              case Domain::Type::T_TUBE:
+                assert(n/static_ctc.nb_var == 1); // no array configuration with scalar type
+                v_dom_ptr.push_back(add_dom(Domain(const_cast<Slice&>(*dom.tube().slice(k)))));
+                slices_nb = dom.tube().nb_slices();
+                break;
+
+              case Domain::Type::T_TUBE_VECTOR:
+                if(n/static_ctc.nb_var == 1) // heterogeneous case
+                {
+                  for(int j = 0 ; j < dom.tube_vector().size() ; j++)
+                    v_dom_ptr.push_back(add_dom(Domain(const_cast<Slice&>(*dom.tube_vector()[j].slice(k)))));
+                }
+
+                else // array data case
+                {
+                  if(dom.tube_vector().size() != n/static_ctc.nb_var)
+                    throw Exception(__func__, "wrong vector dimension");
+                  v_dom_ptr.push_back(add_dom(Domain(const_cast<Slice&>(*dom.tube_vector()[i].slice(k)))));
+                }
+
+                slices_nb = dom.tube_vector().nb_slices();
+                break;
+
+              default:
+                assert(false && "unhandled case");
+            }
+          }
+
+          assert((int)v_dom_ptr.size() == static_ctc.nb_var);
+
+          // Creating what would be this new contractor (defined with domains)
+          Contractor ctc(static_ctc, v_dom_ptr);
+
+          // Getting the actual contractor (maybe the same if not already added)
+          Contractor *ctc_ptr = add_ctc(ctc);
+
+          // Linking to the related domains
+          for(auto& dom : v_dom_ptr)
+            dom->add_ctc(ctc_ptr);
+
+          k++;
+        } while(k < slices_nb);
+      }
+    }
+
+
+    void ContractorNetwork::add_on_slices(DynCtc& dyn_ctc, const vector<Domain>& v_domains, int k0)
+    {
+      vector<const Slice*> v_slices;
+
+      // Vector initialization with the k0-th slices of each tube
+      int nb_slices = -1;
+      for(const auto& dom : v_domains)
+      {
+        switch(dom.type())
+        {
+          case Domain::Type::T_TUBE:
+          {
+            if(nb_slices == -1)
+              nb_slices = dom.tube().nb_slices();
+
+            v_slices.push_back(dom.tube().slice(k0));
+          }
+          break;
+
+          case Domain::Type::T_TUBE_VECTOR:
+          {            
+            for(int j = 0 ; j < dom.tube_vector().size() ; j++)
+            {
+              if(nb_slices == -1)
+                nb_slices = dom.tube_vector()[j].nb_slices();
+
+              v_slices.push_back(dom.tube_vector()[j].slice(k0));
+            }
+          }
+          break;
+
+          default:
+            throw Exception(__func__, "domain is not a tube or a tube vector");
+        }
+      }
+
+      // Adding each row of slices
+      for(int k = k0 ; k < nb_slices ; k++)
+      {
+        vector<Domain> v_slices_domains(v_slices.size());
+        for(size_t i = 0 ; i < v_slices.size() ; i++)
+          v_slices_domains[i] = Domain(const_cast<Slice&>(*v_slices[i]));
+
+        add(dyn_ctc, v_slices_domains); 
+
+        for(auto& s : v_slices)
+          s = s->next_slice();
+      }
+    }
+
     Domain* ContractorNetwork::add_dom(const Domain& ad)
     {
       if(ad.is_empty())
         throw Exception(__func__, "domain already empty when added to the CN");
 
       DomainHashcode hash(ad);
+      auto it = m_map_domains.find(hash);
 
-      if(m_map_domains.find(hash) != m_map_domains.end())
-        return m_map_domains[hash];
+      if(it != m_map_domains.end())
+        return it->second;
     
       Domain *new_dom = new Domain(ad);
-      m_map_domains[hash] = new_dom;
+      m_map_domains.insert(hash, new_dom);
+
+      // The updates of the tubes are tracked from now on
+      // (the contractors are first provided with the whole tdomain)
+      if(new_dom->type() == Domain::Type::T_TUBE || new_dom->type() == Domain::Type::T_TUBE_VECTOR)
+        new_dom->contracted_tdomain();
 
       // And add possible dependencies
 
@@ -449,14 +551,15 @@ namespace codac
 
           case Domain::Type::T_TUBE:
           {
-            vector<Domain*> v_doms(new_dom->tube().nb_slices() + 1);
+            // Bulk registration: n slices domains and n+1 component contractors
+            int n = new_dom->tube().nb_slices();
+            m_map_domains.reserve(m_map_domains.size() + n);
+            m_map_ctc.reserve(m_map_ctc.size() + n + 1);
+
+            vector<Domain*> v_doms(n + 1);
             v_doms[0] = new_dom;
-            int i = 0;
-            for(Slice *s = new_dom->tube().first_slice() ; s != NULL ; s = s->next_slice())
-            {
-              i++;
-              v_doms[i] = add_dom(Domain(*s));
-            }
+            for(int i = 0 ; i < n ; i++)
+              v_doms[i+1] = add_dom(Domain(*new_dom->tube().slice(i)));
 
             // Dependencies tube <-> slice
             Contractor *ac_component = add_ctc(Contractor(Contractor::Type::T_COMPONENT, v_doms));
@@ -466,10 +569,10 @@ namespace codac
               dom_i->add_ctc(ac_component);
 
             // Dependencies slice <-> slice
-            for(Slice *s = new_dom->tube().first_slice() ; s->next_slice() != NULL ; s = s->next_slice())
+            for(int i = 1 ; i < n ; i++)
             {
-              Domain *dom_i1 = add_dom(Domain(*s));
-              Domain *dom_i2 = add_dom(Domain(*(s->next_slice())));
+              Domain *dom_i1 = v_doms[i];
+              Domain *dom_i2 = v_doms[i+1];
 
               Contractor *ac_component_slices = add_ctc(Contractor(Contractor::Type::T_COMPONENT, {dom_i1, dom_i2}));
 
@@ -486,12 +589,12 @@ namespace codac
     Contractor* ContractorNetwork::add_ctc(const Contractor& ac)
     {
       ContractorHashcode hash(ac);
-      map<ContractorHashcode,Contractor*>::iterator it = m_map_ctc.find(hash);
+      auto it = m_map_ctc.find(hash);
 
       if(it == m_map_ctc.end())
       {
         Contractor *new_ctc = new Contractor(ac);
-        m_map_ctc[hash] = new_ctc;
+        m_map_ctc.insert(hash, new_ctc);
         add_ctc_to_queue(new_ctc, m_deque);
         return new_ctc;
       }
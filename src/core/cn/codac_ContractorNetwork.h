@@ -13,6 +13,10 @@
 #define __CODAC_CONTRACTORNETWORK_H__
 
 #include <deque>
+#include <chrono>
+#include <functional>
+#include <vector>
+#include <map>
 #include <initializer_list>
 #include "codac_Ctc.h"
 #include "codac_DynCtc.h"
@@ -20,6 +24,7 @@
 #include "codac_Contractor.h"
 #include "codac_CtcDeriv.h"
 #include "codac_Hashcode.h"
+#include "codac_HashRegistry.h"
 
 namespace ibex
 {
@@ -34,6 +39,7 @@ namespace codac
   class CtcDeriv;
   class DomainHashcode;
   class ContractorHashcode;
+  class ThreadPool;
 
   /**
    * \class ContractorNetwork
@@ -47,6 +53,17 @@ namespace codac
   {
     public:
 
+      /**
+       * \enum SchedulingPolicy
+       * \brief Defines the order in which the active contractors are processed
+       */
+      enum class SchedulingPolicy
+      {
+        LIFO, ///< last triggered contractors first (component contractors at the back of the queue), default policy
+        FIFO, ///< first triggered contractors first
+        PRIORITY ///< contractors with the best observed contraction ratio per computation time first
+      };
+
       /// \name Definition
       /// @{
 
@@ -202,6 +219,9 @@ namespace codac
        * Slices of the tube will be contracted only if provided data completely cover their tdomain.
        * Contracted slices will trigger related contractors, allowing constraint propagation in the graph.
        *
+       * \note In streaming mode (see `set_streaming()`), the tubes of the graph are extended
+       *       if \f$t\f$ goes beyond their tdomain, and the slices older than the horizon are evicted.
+       *
        * \param x the tube \f$[x](\cdot)\f$ to be contracted with continuous data
        * \param t time of measurement \f$t\f$ 
        * \param y bounded measurement, equivalent to the set \f$[x](t)=[y]\f$ 
@@ -217,12 +237,42 @@ namespace codac
        * Slices of the tube will be contracted only if provided data completely cover their tdomain.
        * Contracted slices will trigger related contractors, allowing constraint propagation in the graph.
        *
+       * \note In streaming mode (see `set_streaming()`), the tubes of the graph are extended
+       *       if \f$t\f$ goes beyond their tdomain, and the slices older than the horizon are evicted.
+       *
        * \param x the tube \f$[\mathbf{x}](\cdot)\f$ to be contracted with continuous data
        * \param t time of measurement \f$t\f$ 
        * \param y bounded measurement, equivalent to the set \f$[\mathbf{x}](t)=[\mathbf{y}]\f$ 
        */
       void add_data(TubeVector& x, double t, const IntervalVector& y);
 
+      /**
+       * \brief Adds a batch of continuous data \f$[y_j]\f$ to a tube \f$[x](\cdot)\f$ at times \f$t_j\f$
+       *        (used for realtime applications with high sampling rates).
+       *
+       * Equivalent to successive calls of `add_data(x,t,y)`, but each slice covered by the
+       * batch is contracted once, and its related contractors are triggered in one pass.
+       * No memory allocation is required once the first batches have been processed.
+       *
+       * \param x the tube \f$[x](\cdot)\f$ to be contracted with continuous data
+       * \param v_t increasing times of measurements \f$t_j\f$
+       * \param v_y bounded measurements, equivalent to the sets \f$[x](t_j)=[y_j]\f$
+       */
+      void add_data(Tube& x, const std::vector<double>& v_t, const std::vector<Interval>& v_y);
+
+      /**
+       * \brief Adds a batch of continuous data \f$[\mathbf{y}_j]\f$ to a tube \f$[\mathbf{x}](\cdot)\f$
+       *        at times \f$t_j\f$ (used for realtime applications with high sampling rates).
+       *
+       * Equivalent to successive calls of `add_data(x,t,y)`, but each slice covered by the
+       * batch is contracted once, and its related contractors are triggered in one pass.
+       *
+       * \param x the tube \f$[\mathbf{x}](\cdot)\f$ to be contracted with continuous data
+       * \param v_t increasing times of measurements \f$t_j\f$
+       * \param v_y bounded measurements, equivalent to the sets \f$[\mathbf{x}](t_j)=[\mathbf{y}_j]\f$
+       */
+      void add_data(TubeVector& x, const std::vector<double>& v_t, const std::vector<IntervalVector>& v_y);
+
       /// @}
       /// \name Contraction process
       /// @{
@@ -232,6 +282,8 @@ namespace codac
        *
        * Contractions are performed until a fixed point has been reached on the whole graph.
        *
+       * \note Times are measured with a monotonic wall clock (not the CPU time of the process).
+       *
        * \param verbose verbose mode, `false` by default
        * \return the computation time in seconds
        */
@@ -251,6 +303,38 @@ namespace codac
        */
       double contract_during(double dt, bool verbose = false);
 
+      /**
+       * \brief Launch the contraction process and stops at a given deadline
+       *
+       * Contractions are performed until a fixed point has been obtained on the whole graph,
+       * or if the deadline has been reached, or if the propagation has been interrupted by
+       * the callback function (see `set_callback()`).
+       *
+       * The propagation is interrupted between two contractions: the queue of active contractors
+       * and the saved volumes of the domains are kept, so that a next call to one of the
+       * `contract` methods resumes the propagation where it stopped. The fixed point is reached
+       * when `nb_ctc_in_stack()` returns zero.
+       *
+       * Note that the deadline may be slightly exceeded by the last contraction.
+       *
+       * \param deadline time point of the monotonic clock `std::chrono::steady_clock`
+       * \param verbose verbose mode, `false` by default
+       * \return the computation time in seconds
+       */
+      double contract_until(const std::chrono::steady_clock::time_point& deadline, bool verbose = false);
+
+      /**
+       * \brief Sets a function called periodically during the propagation process
+       *
+       * The function is called between two contractions, at most once every \f$dt\f$ seconds.
+       * If it returns `false`, the propagation is interrupted and can be resumed later.
+       *
+       * \param callback function returning `true` to continue the propagation,
+       *        or an empty function to remove the current callback
+       * \param dt minimal period between two calls, in seconds (\f$0\f$ for a call after each contraction)
+       */
+      void set_callback(const std::function<bool()>& callback, double dt = 0.);
+
       /**
        * \brief Sets the fixed point ratio defining the end of the propagation process.
        *
@@ -267,6 +351,58 @@ namespace codac
        */
       void set_fixedpoint_ratio(float r);
 
+      /**
+       * \brief Sets the number of threads used by the propagation process.
+       *
+       * With one thread (default value), the contractors are processed one by one in the
+       * order of the queue. With more threads, the contractors at the front of the queue
+       * are gathered into batches of contractors that do not share any memory (domains,
+       * adjacent slices, non-reentrant contractor objects), and each batch is processed
+       * concurrently. Contractors that cannot be safely run in parallel (tube-level,
+       * inter-temporal or vector contractors, tubes with a synthesis tree) are processed alone.
+       *
+       * \note The batches do not depend on the number of threads, and the triggering of
+       *       the contractors is done sequentially in the order of the batch: the resulting
+       *       fixed point is the same for any number of threads greater than one.
+       * \note The threads are created by this call and wait between two batches, so that
+       *       small batches do not pay for thread creation. Tube computations performed by
+       *       the contractors of a batch are then sequential (see ThreadPool).
+       *
+       * \param nb_threads number of threads, \f$n\geqslant 1\f$, or \f$0\f$ for the number
+       *        of concurrent threads supported by the implementation
+       */
+      void set_nb_threads(int nb_threads);
+
+      /**
+       * \brief Returns the number of threads used by the propagation process.
+       *
+       * \return number of threads
+       */
+      int nb_threads() const;
+
+      /**
+       * \brief Sets the order in which the active contractors are processed.
+       *
+       * The `PRIORITY` policy relies on statistics observed during the previous contractions:
+       * contractors that have never been called are processed first, then the ones with the
+       * best ratio between the volume reduction they obtained and their computation time.
+       * Contractors that barely contract their domains are postponed but still processed,
+       * so that the same fixed point is reached.
+       *
+       * \note The `PRIORITY` order depends on measured computation times, and may then
+       *       vary from one run to another.
+       *
+       * \param policy scheduling policy (`LIFO` by default)
+       */
+      void set_scheduling_policy(SchedulingPolicy policy);
+
+      /**
+       * \brief Returns the scheduling policy of the propagation process.
+       *
+       * \return the current policy
+       */
+      SchedulingPolicy scheduling_policy() const;
+
       /**
        * \brief Triggers on all contractors involved in the graph.
        *
@@ -323,9 +459,11 @@ namespace codac
        *        * sfdp - multiscale version of fdp for the layout of large graphs
        *        * twopi - radial layouts, nodes are placed on concentric circles depending their distance from a given root node
        *        * circo - circular layout, suitable for certain diagrams of multiple cyclic structures
+       * \param profiling if `true`, the contractors nodes are filled with a color depending
+       *        on their cumulated computation time (from white to red), `false` by default
        * \return system command success
        */
-      int print_dot_graph(const std::string& cn_name = "cn", const std::string& layer_model = "fdp") const;
+      int print_dot_graph(const std::string& cn_name = "cn", const std::string& layer_model = "fdp", bool profiling = false) const;
 
       /**
        * \brief Displays a synthesis of this ContractorNetwork
@@ -337,6 +475,97 @@ namespace codac
       friend std::ostream& operator<<(std::ostream& str, const ContractorNetwork& cn);
 
       /// @}
+      /// \name Profiling
+      /// @{
+
+      /**
+       * \brief Resets the statistics recorded for each contractor during the contractions
+       *
+       * \note The statistics are also used by the `PRIORITY` scheduling policy
+       */
+      void reset_profiling();
+
+      /**
+       * \brief Exports the statistics of the contractors in a CSV file
+       *
+       * For each contractor: its id, name, type, number of domains, number of calls,
+       * number of re-triggers, cumulated computation time (seconds), mean computation time
+       * (seconds) and cumulated relative volume reduction of its domains. The contractors
+       * are sorted by decreasing cumulated computation time.
+       *
+       * \param file_path path of the CSV file
+       */
+      void export_profiling_csv(const std::string& file_path) const;
+
+      /**
+       * \brief Exports the statistics of the contractors in a JSON file
+       *
+       * The file contains an array of objects with the same fields as in `export_profiling_csv()`.
+       *
+       * \param file_path path of the JSON file
+       */
+      void export_profiling_json(const std::string& file_path) const;
+
+      /// @}
+      /// \name Streaming (sliding window)
+      /// @{
+
+      /**
+       * \brief Enables the streaming mode, for realtime applications over long durations
+       *
+       * In this mode, the tubes of the graph are extended by new slices when data arrives beyond
+       * their tdomain (see `add_data()`), and the constraints previously added on their slices
+       * are applied on the new ones. The slices older than the horizon are evicted together
+       * with their contractors, so that the size of the graph remains bounded.
+       *
+       * \param dt timestep of the new slices
+       * \param horizon duration of the sliding window kept in the graph (no eviction by default)
+       */
+      void set_streaming(double dt, double horizon = std::numeric_limits<double>::infinity());
+
+      /**
+       * \brief Returns `true` if the streaming mode is enabled
+       *
+       * \return a boolean
+       */
+      bool streaming() const;
+
+      /**
+       * \brief Extends the tubes of the graph up to \f$t_f\f$
+       *
+       * New slices of width \f$dt\f$ (see `set_streaming()`) are appended to each tube, and
+       * registered in the graph with the constraints previously added on the former slices.
+       * The new upper bound is the first multiple of \f$dt\f$ (from the former one) not lower than \f$t_f\f$.
+       *
+       * \note This method must not be called during a contraction (for instance from a callback).
+       *
+       * \param tf new upper bound of the tdomains
+       */
+      void extend_tdomain(double tf);
+
+      /**
+       * \brief Evicts from the graph the slices whose tdomain ends before \f$t\f$
+       *
+       * The contractors involving these slices are removed. The evicted envelopes of each
+       * tube are summarized by their hull (see `evicted_codomain()`), while the input gate
+       * of the first remaining slice keeps the state of the tube at the beginning of the window.
+       * At least one slice is kept for each tube.
+       *
+       * \note This method must not be called during a contraction (for instance from a callback).
+       *
+       * \param t time before which the slices are evicted
+       */
+      void evict_before(double t);
+
+      /**
+       * \brief Returns the hull of the envelopes of the evicted slices of a tube
+       *
+       * \param x the tube \f$[x](\cdot)\f$
+       * \return the hull, or an empty set if no slice of \f$[x](\cdot)\f$ has been evicted
+       */
+      const Interval evicted_codomain(const Tube& x) const;
+
+      /// @}
 
     protected:
 
@@ -352,6 +581,33 @@ namespace codac
        */
       Domain* add_dom(const Domain& ad);
 
+      /**
+       * \brief Adds a static contractor on each slice of the given domains, from the \f$k_0\f$th one
+       *
+       * \param static_ctc Ctc contractor object
+       * \param v_domains a vector of abstract domains, already added in the graph
+       * \param k0 index of the first slice to be considered
+       */
+      void add_on_slices(Ctc& static_ctc, const std::vector<Domain>& v_domains, int k0 = 0);
+
+      /**
+       * \brief Adds a non inter-temporal dynamic contractor on each slice of the given tubes,
+       *        from the \f$k_0\f$th one
+       *
+       * \param dyn_ctc DynCtc contractor object
+       * \param v_domains a vector of tubes or tube vectors, already added in the graph
+       * \param k0 index of the first slice to be considered
+       */
+      void add_on_slices(DynCtc& dyn_ctc, const std::vector<Domain>& v_domains, int k0 = 0);
+
+      /**
+       * \brief Updates the domains of a contractor and its key in the registry
+       *
+       * \param ctc pointer to the Contractor, registered in the graph
+       * \param v_domains new vector of pointers to the domains of the contractor
+       */
+      void update_ctc_domains(Contractor *ctc, const std::vector<Domain*>& v_domains);
+
       /**
        * \brief Adds an abstract Contractor to the graph
        *
@@ -372,22 +628,93 @@ namespace codac
        */
       void add_ctc_to_queue(Contractor *ac, std::deque<Contractor*>& ctc_deque);
 
+      /**
+       * \brief Removes the next Contractor to be processed from the queue of active contractors,
+       *        according to the scheduling policy
+       *
+       * \return pointer to the Contractor
+       */
+      Contractor* pop_ctc_from_queue();
+
       /**
        * \brief Triggers on the contractors related to the given Domain
        *
+       * \note Incremental contractors (see `DynCtc::is_incremental()`) are also provided with
+       *       the tdomain over which the Domain has been contracted.
+       *
        * \param dom pointer to the Domain
        * \param ctc_to_avoid optional pointer to a Contractor to not activate
+       * \return the ratio between the new volume of the domain and its previously saved one
+       */
+      double trigger_ctc_related_to_dom(Domain *dom, Contractor *ctc_to_avoid = NULL);
+
+      /**
+       * \brief Lists the memory resources a contractor accesses during its contraction
+       *
+       * A resource is a pair (address, index): slices are identified by the address of
+       * their storage and their index, other resources by their address and a zero index.
+       * Two resources conflict if they share the same address and their indexes
+       * differ by at most one (the slice setters access the adjacent envelopes).
+       *
+       * \param ctc pointer to the Contractor
+       * \param v_resources vector to be filled with the resources
+       * \return `false` if the contractor cannot be processed concurrently with other ones
+       */
+      bool parallel_resources(Contractor *ctc, std::vector<std::pair<const void*,int> >& v_resources) const;
+
+      /**
+       * \brief Pops from the queue a batch of contractors that can be processed concurrently
+       *
+       * The batch is made of the first contractors of the queue that do not conflict with
+       * each other. The skipped contractors are kept in the queue, in the same order.
+       *
+       * \param v_batch vector to be filled with the pointers to the contractors
+       */
+      void pop_parallel_batch(std::vector<Contractor*>& v_batch);
+
+      /**
+       * \brief Contracts a batch of contractors over the available threads
+       *
+       * \param v_batch contractors that do not conflict with each other
+       * \param v_durations vector to be filled with the computation time of each contraction, in seconds
+       */
+      void contract_batch(const std::vector<Contractor*>& v_batch, std::vector<double>& v_durations) const;
+
+      /**
+       * \brief Compares the scheduling priorities of two contractors
+       *
+       * \param a first Contractor
+       * \param b second Contractor
+       * \return `true` if `a` has to be processed after `b`
+       */
+      static bool lower_priority(const Contractor *a, const Contractor *b);
+
+      /**
+       * \brief Returns the contractors of the graph, sorted by decreasing cumulated computation time
+       *
+       * \return vector of pointers to the contractors
        */
-      void trigger_ctc_related_to_dom(Domain *dom, Contractor *ctc_to_avoid = NULL);
+      std::vector<const Contractor*> contractors_by_cost() const;
 
     protected:
 
-      std::map<DomainHashcode,Domain*> m_map_domains; //!< pointers to the abstract Domain objects the graph is made of
-      std::map<ContractorHashcode,Contractor*> m_map_ctc; //!< pointers to the abstract Contractor objects the graph is made of
+      HashRegistry<DomainHashcode,Domain*> m_map_domains; //!< pointers to the abstract Domain objects the graph is made of
+      HashRegistry<ContractorHashcode,Contractor*> m_map_ctc; //!< pointers to the abstract Contractor objects the graph is made of
       std::deque<Contractor*> m_deque; //!< queue of active contractors
 
       float m_fixedpoint_ratio = 0.0001; //!< fixed point ratio for propagation limit
       double m_contraction_duration_max = std::numeric_limits<double>::infinity(); //!< computation time limit
+      std::function<bool()> m_callback; //!< optional function called during the propagation, that may interrupt it
+      double m_callback_period = 0.; //!< minimal period between two calls of the callback function, in seconds
+      int m_nb_threads = 1; //!< number of threads used by the propagation process
+      ThreadPool *m_pool = NULL; //!< threads processing the batches of contractors (NULL if sequential)
+      SchedulingPolicy m_scheduling_policy = SchedulingPolicy::LIFO; //!< order of the active contractors
+
+      double m_streaming_dt = 0.; //!< timestep of the slices appended in streaming mode (0 if disabled)
+      double m_streaming_horizon = std::numeric_limits<double>::infinity(); //!< duration of the sliding window in streaming mode
+      std::vector<std::pair<Ctc*,std::vector<Domain> > > m_v_static_ctc_on_slices; //!< static constraints applied on each slice of tubes
+      std::vector<std::pair<DynCtc*,std::vector<Domain> > > m_v_dyn_ctc_on_slices; //!< dynamic constraints applied on each slice of tubes
+      std::map<const Tube*,Interval> m_map_evicted_codomains; //!< hulls of the envelopes of the evicted slices
 
       CtcDeriv *m_ctc_deriv = NULL; //!< optional pointer to a CtcDeriv object that can be automatically added in the graph
       std::list<std::pair<Domain*,Domain*> > m_domains_related_to_ctcderiv;
@@ -0,0 +1,137 @@
+/** 
+ *  ContractorNetwork class : profiling
+ * ----------------------------------------------------------------------------
+ *  \date       2021
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include "codac_ContractorNetwork.h"
+#include "codac_Exception.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace codac
+{
+  static const string ctc_type_str(Contractor::Type type)
+  {
+    switch(type)
+    {
+      case Contractor::Type::T_COMPONENT:
+        return "component";
+      case Contractor::Type::T_EQUALITY:
+        return "equality";
+      case Contractor::Type::T_IBEX:
+        return "static";
+      case Contractor::Type::T_CODAC:
+        return "dynamic";
+      default:
+        assert(false && "unhandled case");
+        return "";
+    }
+  }
+
+  static const string csv_str(const string& str)
+  {
+    string output = "\"";
+    for(const auto& c : str)
+      output += (c == '"') ? "\"\"" : string(1, c);
+    return output + "\"";
+  }
+
+  static const string json_str(const string& str)
+  {
+    string output = "\"";
+    for(const auto& c : str)
+      output += (c == '"' || c == '\\') ? "\\" + string(1, c) : string(1, c);
+    return output + "\"";
+  }
+
+  // Public methods
+
+    // Profiling
+
+    void ContractorNetwork::reset_profiling()
+    {
+      for(auto& ctc : m_map_ctc)
+        ctc.second->reset_statistics();
+    }
+
+    void ContractorNetwork::export_profiling_csv(const string& file_path) const
+    {
+      ofstream csv_file(file_path);
+      if(!csv_file.is_open())
+        throw Exception(__func__, "error while writing file \"" + file_path + "\"");
+
+      csv_file << "id,name,type,nb_domains,nb_calls,nb_triggers,total_time,mean_time,total_reduction" << endl;
+      csv_file << setprecision(9);
+
+      for(const auto& ctc : contractors_by_cost())
+        csv_file << ctc->id() << ","
+                 << csv_str(ctc->name()) << ","
+                 << ctc_type_str(ctc->type()) << ","
+                 << ctc->domains().size() << ","
+                 << ctc->nb_contractions() << ","
+                 << ctc->nb_triggers() << ","
+                 << ctc->total_duration() << ","
+                 << (ctc->nb_contractions() == 0 ? 0. : ctc->total_duration() / ctc->nb_contractions()) << ","
+                 << ctc->total_reduction() << endl;
+
+      csv_file.close();
+    }
+
+    void ContractorNetwork::export_profiling_json(const string& file_path) const
+    {
+      ofstream json_file(file_path);
+      if(!json_file.is_open())
+        throw Exception(__func__, "error while writing file \"" + file_path + "\"");
+
+      json_file << "[" << endl;
+      json_file << setprecision(9);
+
+      vector<const Contractor*> v_ctc = contractors_by_cost();
+      for(size_t i = 0 ; i < v_ctc.size() ; i++)
+      {
+        const Contractor *ctc = v_ctc[i];
+        json_file << "  { \"id\": " << ctc->id()
+                  << ", \"name\": " << json_str(ctc->name())
+                  << ", \"type\": \"" << ctc_type_str(ctc->type()) << "\""
+                  << ", \"nb_domains\": " << ctc->domains().size()
+                  << ", \"nb_calls\": " << ctc->nb_contractions()
+                  << ", \"nb_triggers\": " << ctc->nb_triggers()
+                  << ", \"total_time\": " << ctc->total_duration()
+                  << ", \"mean_time\": " << (ctc->nb_contractions() == 0 ? 0. : ctc->total_duration() / ctc->nb_contractions())
+                  << ", \"total_reduction\": " << ctc->total_reduction()
+                  << " }" << (i+1 < v_ctc.size() ? "," : "") << endl;
+      }
+
+      json_file << "]" << endl;
+      json_file.close();
+    }
+
+  // Protected methods
+
+    vector<const Contractor*> ContractorNetwork::contractors_by_cost() const
+    {
+      vector<const Contractor*> v_ctc;
+      v_ctc.reserve(m_map_ctc.size());
+      for(const auto& ctc : m_map_ctc)
+        v_ctc.push_back(ctc.second);
+
+      sort(v_ctc.begin(), v_ctc.end(),
+        [](const Contractor *a, const Contractor *b)
+        {
+          if(a->total_duration() != b->total_duration())
+            return a->total_duration() > b->total_duration();
+          return a->id() < b->id();
+        });
+
+      return v_ctc;
+    }
+}
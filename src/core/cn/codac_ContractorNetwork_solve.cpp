@@ -8,9 +8,13 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
-#include <time.h>
+#include <set>
+#include <thread>
+#include <chrono>
+#include <algorithm>
 #include "codac_ContractorNetwork.h"
 #include "codac_Exception.h"
+#include "codac_ThreadPool.h"
 
 using namespace std;
 using namespace ibex;
@@ -23,36 +27,87 @@ namespace codac
 
     double ContractorNetwork::contract(bool verbose)
     {
-      clock_t t_start = clock();
+      chrono::steady_clock::time_point deadline = chrono::steady_clock::time_point::max();
+
+      if(!std::isinf(m_contraction_duration_max))
+      {
+        chrono::steady_clock::time_point t_now = chrono::steady_clock::now();
+        if(m_contraction_duration_max < chrono::duration<double>(deadline - t_now).count()) // no overflow
+          deadline = t_now
+            + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(m_contraction_duration_max));
+      }
+
+      return contract_until(deadline, verbose);
+    }
+
+    double ContractorNetwork::contract_until(const chrono::steady_clock::time_point& deadline, bool verbose)
+    {
+      chrono::steady_clock::time_point t_start = chrono::steady_clock::now();
+      chrono::steady_clock::time_point t_callback = t_start;
 
       if(verbose)
       {
         cout << "Contractor network has " << m_map_ctc.size()
              << " contractors and " << m_map_domains.size() << " domains" << endl;
         cout << "Computing, " << nb_ctc_in_stack() << " contractors currently in stack";
-        if(!std::isinf(m_contraction_duration_max))
-          cout << " during " << m_contraction_duration_max << "s";
+        if(deadline != chrono::steady_clock::time_point::max())
+          cout << " during " << chrono::duration<double>(deadline - t_start).count() << "s";
         cout << endl;
       }
 
-      while(!m_deque.empty()
-        && (double)(clock() - t_start)/CLOCKS_PER_SEC < m_contraction_duration_max)
+      while(!m_deque.empty() && chrono::steady_clock::now() < deadline)
       {
-        Contractor *ctc = m_deque.front();
-        m_deque.pop_front();
+        vector<Contractor*> v_batch;
+        vector<double> v_durations;
+
+        if(m_nb_threads > 1)
+          pop_parallel_batch(v_batch);
+        else
+          v_batch.push_back(pop_ctc_from_queue());
 
-        ctc->contract();
-        ctc->set_active(false);
+        contract_batch(v_batch, v_durations);
 
-        for(auto& ctc_dom : ctc->domains()) // for each domain related to this contractor
+        for(auto& ctc : v_batch)
+          ctc->set_active(false);
+
+        // Propagation is done sequentially, in the order of the batch
+        for(size_t i = 0 ; i < v_batch.size() ; i++)
         {
-          // If the domain has "changed" after the contraction
-          trigger_ctc_related_to_dom(ctc_dom, ctc);
+          double volume_ratio = 1.;
+
+          for(auto& ctc_dom : v_batch[i]->domains()) // for each domain related to this contractor
+          {
+            // If the domain has "changed" after the contraction
+            double r = trigger_ctc_related_to_dom(ctc_dom, v_batch[i]);
+            if(r < volume_ratio)
+              volume_ratio = r;
+          }
+
+          v_batch[i]->record_contraction(v_durations[i], volume_ratio);
+        }
+
+        // Contractors of the batch may have been triggered again before their priority update
+        if(m_scheduling_policy == SchedulingPolicy::PRIORITY && v_batch.size() > 1)
+          make_heap(m_deque.begin(), m_deque.end(), lower_priority);
+
+        // Periodic call of the user function, that may interrupt the propagation
+        if(m_callback && !m_deque.empty()
+          && chrono::duration<double>(chrono::steady_clock::now() - t_callback).count() >= m_callback_period)
+        {
+          t_callback = chrono::steady_clock::now();
+          if(!m_callback())
+          {
+            if(verbose)
+              cout << "  Propagation interrupted, " << nb_ctc_in_stack() << " contractors remaining in stack" << endl;
+            break;
+          }
         }
       }
 
+      double contraction_time = chrono::duration<double>(chrono::steady_clock::now() - t_start).count();
+
       if(verbose)
-        cout << "  Constraint propagation time: " << (double)(clock() - t_start)/CLOCKS_PER_SEC << "s" << endl;
+        cout << "  Constraint propagation time: " << contraction_time << "s" << endl;
 
       // Emptiness test
       // todo: test only contracted domains?
@@ -64,7 +119,7 @@ namespace codac
             break;
           }
 
-      return (double)(clock() - t_start)/CLOCKS_PER_SEC;
+      return contraction_time;
     }
 
     double ContractorNetwork::contract_during(double dt, bool verbose)
@@ -76,12 +131,49 @@ namespace codac
       return contraction_time;
     }
 
+    void ContractorNetwork::set_callback(const function<bool()>& callback, double dt)
+    {
+      assert(dt >= 0. && "invalid period");
+      m_callback = callback;
+      m_callback_period = dt;
+    }
+
     void ContractorNetwork::set_fixedpoint_ratio(float r)
     {
       assert(Interval(0.,1).contains(r) && "invalid ratio");
       m_fixedpoint_ratio = r;
     }
 
+    void ContractorNetwork::set_nb_threads(int nb_threads)
+    {
+      assert(nb_threads >= 0 && "invalid number of threads");
+      if(nb_threads == 0)
+        nb_threads = std::max(1, (int)std::thread::hardware_concurrency());
+      m_nb_threads = nb_threads;
+
+      if(m_pool != NULL)
+        delete m_pool;
+      m_pool = nb_threads > 1 ? new ThreadPool(nb_threads) : NULL;
+    }
+
+    int ContractorNetwork::nb_threads() const
+    {
+      return m_nb_threads;
+    }
+
+    void ContractorNetwork::set_scheduling_policy(SchedulingPolicy policy)
+    {
+      m_scheduling_policy = policy;
+
+      if(m_scheduling_policy == SchedulingPolicy::PRIORITY)
+        make_heap(m_deque.begin(), m_deque.end(), lower_priority);
+    }
+
+    ContractorNetwork::SchedulingPolicy ContractorNetwork::scheduling_policy() const
+    {
+      return m_scheduling_policy;
+    }
+
     void ContractorNetwork::trigger_all_contractors()
     {
       m_deque.clear();
@@ -89,6 +181,7 @@ namespace codac
       for(const auto& ctc : m_map_ctc)
       {
         ctc.second->set_active(true);
+        ctc.second->add_dirty_tdomain(Interval::ALL_REALS);
         add_ctc_to_queue(ctc.second, m_deque);
       }
     }
@@ -104,36 +197,235 @@ namespace codac
     {
       // todo: propagate for EQUALITY contractors even in case of poor contractions?
 
-      if(ac->type() == Contractor::Type::T_COMPONENT)
-        ctc_deque.push_back(ac);
+      switch(m_scheduling_policy)
+      {
+        case SchedulingPolicy::FIFO:
+          ctc_deque.push_back(ac);
+          break;
+
+        case SchedulingPolicy::PRIORITY:
+          ctc_deque.push_back(ac);
+          push_heap(ctc_deque.begin(), ctc_deque.end(), lower_priority);
+          break;
+
+        case SchedulingPolicy::LIFO:
+        default:
+          if(ac->type() == Contractor::Type::T_COMPONENT)
+            ctc_deque.push_back(ac);
+
+          else
+            ctc_deque.push_front(ac); // priority
+      }
+    }
+
+    Contractor* ContractorNetwork::pop_ctc_from_queue()
+    {
+      assert(!m_deque.empty());
+
+      if(m_scheduling_policy == SchedulingPolicy::PRIORITY)
+        pop_heap(m_deque.begin(), m_deque.end(), lower_priority);
 
       else
-        ctc_deque.push_front(ac); // priority
+      {
+        Contractor *ctc = m_deque.front();
+        m_deque.pop_front();
+        return ctc;
+      }
+
+      Contractor *ctc = m_deque.back();
+      m_deque.pop_back();
+      return ctc;
     }
 
-    void ContractorNetwork::trigger_ctc_related_to_dom(Domain *dom, Contractor *ctc_to_avoid)
+    double ContractorNetwork::trigger_ctc_related_to_dom(Domain *dom, Contractor *ctc_to_avoid)
     {
       double current_volume = dom->compute_volume(); // new volume after contraction
+      double volume_ratio = current_volume/dom->get_saved_volume();
+
+      // Incremental contractors are only provided with the contracted part of the domain,
+      // accumulated until their next contraction (even if they are not activated now)
 
-      if(current_volume/dom->get_saved_volume() < 1.-m_fixedpoint_ratio)
+      for(const auto& ctc_of_dom : dom->contractors())
+        if(ctc_of_dom->type() == Contractor::Type::T_CODAC && ctc_of_dom->codac_ctc().is_incremental())
+        {
+          Interval t = dom->contracted_tdomain();
+          if(!t.is_empty())
+            for(auto& c : dom->contractors())
+              if(c != ctc_to_avoid)
+                c->add_dirty_tdomain(t);
+          break;
+        }
+
+      if(volume_ratio < 1.-m_fixedpoint_ratio)
       {
         // We activate each contractor related to these domains, according to graph orientation
 
-        // Local deque, for specific order related to this domain
-        deque<Contractor*> ctc_deque;
+        if(m_scheduling_policy == SchedulingPolicy::LIFO)
+        {
+          // Local deque, for specific order related to this domain
+          deque<Contractor*> ctc_deque;
 
-        for(auto& ctc_of_dom : dom->contractors()) 
-          if(ctc_of_dom != ctc_to_avoid && !ctc_of_dom->is_active())
-          {
-            ctc_of_dom->set_active(true);
-            add_ctc_to_queue(ctc_of_dom, ctc_deque);
-          }
+          for(auto& ctc_of_dom : dom->contractors()) 
+            if(ctc_of_dom != ctc_to_avoid && !ctc_of_dom->is_active())
+            {
+              ctc_of_dom->set_active(true);
+              ctc_of_dom->record_trigger();
+              add_ctc_to_queue(ctc_of_dom, ctc_deque);
+            }
+
+          // Merging this local deque in the CN one
+          for(auto& c : ctc_deque)
+            m_deque.push_front(c);
+        }
 
-        // Merging this local deque in the CN one
-        for(auto& c : ctc_deque)
-          m_deque.push_front(c);
+        else
+        {
+          for(auto& ctc_of_dom : dom->contractors()) 
+            if(ctc_of_dom != ctc_to_avoid && !ctc_of_dom->is_active())
+            {
+              ctc_of_dom->set_active(true);
+              ctc_of_dom->record_trigger();
+              add_ctc_to_queue(ctc_of_dom, m_deque);
+            }
+        }
       }
       
       dom->set_volume(current_volume); // updating old volume
+      return volume_ratio;
+    }
+
+    bool ContractorNetwork::parallel_resources(Contractor *ctc, vector<pair<const void*,int> >& v_resources) const
+    {
+      v_resources.clear();
+
+      switch(ctc->type())
+      {
+        case Contractor::Type::T_COMPONENT:
+          return true; // symbolic contractor: no memory access
+
+        case Contractor::Type::T_IBEX:
+          // Ibex contractors are not reentrant (internal evaluation buffers)
+          v_resources.push_back(make_pair(&ctc->ibex_ctc(), 0));
+          break;
+
+        case Contractor::Type::T_CODAC:
+          if(ctc->codac_ctc().is_intertemporal())
+            return false;
+          if(typeid(ctc->codac_ctc()) != typeid(CtcDeriv)) // CtcDeriv is reentrant
+            v_resources.push_back(make_pair(&ctc->codac_ctc(), 0));
+          break;
+
+        default:
+          return false;
+      }
+
+      for(const auto& dom : ctc->domains())
+        switch(dom->type())
+        {
+          case Domain::Type::T_INTERVAL:
+            v_resources.push_back(make_pair(&dom->interval(), 0));
+            break;
+
+          case Domain::Type::T_SLICE:
+          {
+            const Slice& s = dom->slice();
+            if(s.m_synthesis_reference != NULL) // the tree is shared by all the slices of the tube
+              return false;
+            v_resources.push_back(make_pair(s.m_storage, s.m_id));
+          }
+          break;
+
+          default: // vectors may share their components with other domains
+            return false;
+        }
+
+      return true;
+    }
+
+    void ContractorNetwork::pop_parallel_batch(vector<Contractor*>& v_batch)
+    {
+      assert(!m_deque.empty());
+
+      // Fixed size of the window of contractors explored in the queue,
+      // so that batches do not depend on the number of threads
+      const int window_size = 1024;
+
+      set<pair<const void*,int> > s_locked;
+      deque<Contractor*> skipped_ctc;
+      vector<pair<const void*,int> > v_resources;
+
+      v_batch.clear();
+
+      for(int i = 0 ; i < window_size && !m_deque.empty() ; i++)
+      {
+        Contractor *ctc = m_deque.front();
+
+        if(!parallel_resources(ctc, v_resources))
+        {
+          if(v_batch.empty()) // this contractor is processed alone
+            v_batch.push_back(pop_ctc_from_queue());
+
+          break;
+        }
+
+        bool conflict = false;
+        for(const auto& r : v_resources)
+          if(s_locked.count(r) != 0
+            || s_locked.count(make_pair(r.first, r.second-1)) != 0
+            || s_locked.count(make_pair(r.first, r.second+1)) != 0)
+          {
+            conflict = true;
+            break;
+          }
+
+        pop_ctc_from_queue();
+
+        if(conflict)
+          skipped_ctc.push_back(ctc);
+
+        else
+        {
+          s_locked.insert(v_resources.begin(), v_resources.end());
+          v_batch.push_back(ctc);
+        }
+      }
+
+      // Skipped contractors are put back in front of the queue, in the same order
+      if(m_scheduling_policy == SchedulingPolicy::PRIORITY)
+        for(auto& ctc : skipped_ctc)
+          add_ctc_to_queue(ctc, m_deque);
+
+      else
+        for(auto it = skipped_ctc.rbegin() ; it != skipped_ctc.rend() ; it++)
+          m_deque.push_front(*it);
+    }
+
+    void ContractorNetwork::contract_batch(const vector<Contractor*>& v_batch, vector<double>& v_durations) const
+    {
+      v_durations.resize(v_batch.size());
+
+      auto contract_range = [&](int i0, int i1)
+      {
+        for(int i = i0 ; i < i1 ; i++)
+        {
+          chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+          v_batch[i]->contract();
+          v_durations[i] = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+        }
+      };
+
+      // One contractor per range: contractions are dynamically distributed over the threads
+      if(m_pool == NULL)
+        contract_range(0, v_batch.size());
+      else
+        m_pool->for_each_range(v_batch.size(), 1, contract_range);
+    }
+
+    bool ContractorNetwork::lower_priority(const Contractor *a, const Contractor *b)
+    {
+      double pa = a->priority(), pb = b->priority();
+      if(pa != pb)
+        return pa < pb;
+      return a->id() > b->id(); // oldest contractors first, for a deterministic order
     }
-}
\ No newline at end of file
+}
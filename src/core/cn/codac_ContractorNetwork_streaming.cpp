@@ -0,0 +1,259 @@
+/** 
+ *  ContractorNetwork class : streaming
+ * ----------------------------------------------------------------------------
+ *  \date       2021
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cmath>
+#include <algorithm>
+#include <unordered_set>
+#include "codac_ContractorNetwork.h"
+#include "codac_Exception.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace codac
+{
+  // Returns the tube component contractor of a tube domain (linking the tube to its slices)
+  static Contractor* tube_component(Domain *tube_dom)
+  {
+    assert(tube_dom->type() == Domain::Type::T_TUBE);
+
+    for(auto& ctc : tube_dom->contractors())
+      if(ctc->type() == Contractor::Type::T_COMPONENT && ctc->domains()[0] == tube_dom)
+        return ctc;
+
+    assert(false && "tube component not found");
+    return NULL;
+  }
+
+  // Updates the saved volumes of tube domains whose tdomain changed, and of the tube vectors containing them
+  static void update_volumes(const vector<Domain*>& v_tube_doms)
+  {
+    unordered_set<Domain*> set_doms;
+    for(auto& tube_dom : v_tube_doms)
+    {
+      set_doms.insert(tube_dom);
+      for(auto& ctc : tube_dom->contractors())
+        if(ctc->type() == Contractor::Type::T_COMPONENT
+          && ctc->domains()[0]->type() == Domain::Type::T_TUBE_VECTOR)
+          set_doms.insert(ctc->domains()[0]);
+    }
+
+    for(auto& dom : set_doms)
+      dom->set_volume(dom->compute_volume());
+  }
+
+  // Returns the first tube of a list of domains, used as a reference for the slicing
+  static const Tube* first_tube(const vector<Domain>& v_domains)
+  {
+    for(const auto& dom : v_domains)
+    {
+      if(dom.type() == Domain::Type::T_TUBE)
+        return &dom.tube();
+      if(dom.type() == Domain::Type::T_TUBE_VECTOR)
+        return &dom.tube_vector()[0];
+    }
+
+    return NULL;
+  }
+
+  // Public methods
+
+    // Streaming (sliding window)
+
+    void ContractorNetwork::set_streaming(double dt, double horizon)
+    {
+      if(dt <= 0.)
+        throw Exception(__func__, "the timestep must be positive");
+      if(horizon <= 0.)
+        throw Exception(__func__, "the horizon must be positive");
+
+      m_streaming_dt = dt;
+      m_streaming_horizon = horizon;
+    }
+
+    bool ContractorNetwork::streaming() const
+    {
+      return m_streaming_dt > 0.;
+    }
+
+    void ContractorNetwork::extend_tdomain(double tf)
+    {
+      if(!streaming())
+        throw Exception(__func__, "streaming mode not enabled");
+
+      // Number of slices of each tube before the extension
+      map<const Tube*,int> map_prev_nb_slices;
+
+      vector<Domain*> v_tubes;
+      for(const auto& dom : m_map_domains)
+        if(dom.second->type() == Domain::Type::T_TUBE && dom.second->tube().tdomain().ub() < tf)
+          v_tubes.push_back(dom.second);
+
+      for(auto& tube_dom : v_tubes)
+      {
+        Tube& x = tube_dom->tube();
+        int k0 = x.nb_slices();
+        map_prev_nb_slices[&x] = k0;
+
+        double ub = x.tdomain().ub();
+        x.extend_tdomain(ub + std::ceil((tf - ub) / m_streaming_dt) * m_streaming_dt, m_streaming_dt);
+
+        // Registering the new slices, linked to the tube
+        Contractor *ac_component = tube_component(tube_dom);
+        vector<Domain*> v_doms = ac_component->domains();
+        for(int k = k0 ; k < x.nb_slices() ; k++)
+        {
+          Domain *dom_k = add_dom(Domain(*x.slice(k)));
+          dom_k->add_ctc(ac_component);
+          v_doms.push_back(dom_k);
+
+          // Dependencies slice <-> slice
+          Contractor *ac_component_slices = add_ctc(Contractor(Contractor::Type::T_COMPONENT, { v_doms[k], dom_k }));
+          v_doms[k]->add_ctc(ac_component_slices);
+          dom_k->add_ctc(ac_component_slices);
+        }
+
+        update_ctc_domains(ac_component, v_doms);
+      }
+
+      // Applying the constraints previously added on slices
+
+      for(const auto& c : m_v_static_ctc_on_slices)
+      {
+        auto it = map_prev_nb_slices.find(first_tube(c.second));
+        if(it != map_prev_nb_slices.end())
+          add_on_slices(*c.first, c.second, it->second);
+      }
+
+      for(const auto& c : m_v_dyn_ctc_on_slices)
+      {
+        auto it = map_prev_nb_slices.find(first_tube(c.second));
+        if(it != map_prev_nb_slices.end())
+          add_on_slices(*c.first, c.second, it->second);
+      }
+
+      // The new slices are not contractions: the saved volumes are updated
+      update_volumes(v_tubes);
+    }
+
+    void ContractorNetwork::evict_before(double t)
+    {
+      unordered_set<Domain*> set_evicted_doms;
+      vector<pair<Domain*,int> > v_truncated_tubes; // tube domains and number of evicted slices
+
+      for(const auto& dom : m_map_domains)
+      {
+        if(dom.second->type() != Domain::Type::T_TUBE)
+          continue;
+
+        Tube& x = dom.second->tube();
+        int nb_evicted = 0;
+        while(nb_evicted < x.nb_slices() - 1 // at least one slice is kept
+          && x.slice(nb_evicted)->tdomain().ub() <= t)
+          nb_evicted++;
+
+        if(nb_evicted == 0)
+          continue;
+
+        auto it_hull = m_map_evicted_codomains.find(&x);
+        if(it_hull == m_map_evicted_codomains.end())
+          it_hull = m_map_evicted_codomains.insert(make_pair(&x, Interval::EMPTY_SET)).first;
+
+        for(int k = 0 ; k < nb_evicted ; k++)
+        {
+          auto it = m_map_domains.find(DomainHashcode(Domain(*x.slice(k))));
+          assert(it != m_map_domains.end());
+          set_evicted_doms.insert(it->second);
+          it_hull->second |= x.slice(k)->codomain();
+        }
+
+        v_truncated_tubes.push_back(make_pair(dom.second, nb_evicted));
+      }
+
+      if(v_truncated_tubes.empty())
+        return;
+
+      // Contractors involving evicted domains are removed,
+      // except the tube components that are updated
+
+      unordered_set<Contractor*> set_evicted_ctc;
+      for(const auto& ctc : m_map_ctc)
+        for(const auto& dom : ctc.second->domains())
+          if(set_evicted_doms.find(dom) != set_evicted_doms.end())
+          {
+            if(ctc.second->type() != Contractor::Type::T_COMPONENT
+              || ctc.second->domains()[0]->type() != Domain::Type::T_TUBE)
+              set_evicted_ctc.insert(ctc.second);
+            break;
+          }
+
+      for(auto& tube_dom : v_truncated_tubes)
+      {
+        Contractor *ac_component = tube_component(tube_dom.first);
+        vector<Domain*> v_doms = ac_component->domains();
+        v_doms.erase(v_doms.begin() + 1, v_doms.begin() + 1 + tube_dom.second);
+        update_ctc_domains(ac_component, v_doms);
+      }
+
+      m_deque.erase(remove_if(m_deque.begin(), m_deque.end(),
+        [&](Contractor *ctc) { return set_evicted_ctc.find(ctc) != set_evicted_ctc.end(); }),
+        m_deque.end());
+
+      if(m_scheduling_policy == SchedulingPolicy::PRIORITY)
+        make_heap(m_deque.begin(), m_deque.end(), lower_priority);
+
+      for(auto& ctc : set_evicted_ctc)
+        for(auto& dom : ctc->domains())
+          if(set_evicted_doms.find(dom) == set_evicted_doms.end())
+          {
+            vector<Contractor*>& v_ctc = dom->contractors();
+            v_ctc.erase(remove(v_ctc.begin(), v_ctc.end(), ctc), v_ctc.end());
+          }
+
+      m_map_ctc.remove_if(
+        [&](const pair<ContractorHashcode,Contractor*>& c) { return set_evicted_ctc.find(c.second) != set_evicted_ctc.end(); });
+      for(auto& ctc : set_evicted_ctc)
+        delete ctc;
+
+      m_map_domains.remove_if(
+        [&](const pair<DomainHashcode,Domain*>& d) { return set_evicted_doms.find(d.second) != set_evicted_doms.end(); });
+      for(auto& dom : set_evicted_doms)
+        delete dom;
+
+      // Truncating the tubes
+
+      vector<Domain*> v_tubes;
+      for(auto& tube_dom : v_truncated_tubes)
+      {
+        Tube& x = tube_dom.first->tube();
+        x.truncate_tdomain(Interval(x.slice(tube_dom.second)->tdomain().lb(), x.tdomain().ub()));
+        v_tubes.push_back(tube_dom.first);
+      }
+
+      update_volumes(v_tubes);
+    }
+
+    const Interval ContractorNetwork::evicted_codomain(const Tube& x) const
+    {
+      auto it = m_map_evicted_codomains.find(&x);
+      return it == m_map_evicted_codomains.end() ? Interval::EMPTY_SET : it->second;
+    }
+
+  // Protected methods
+
+    void ContractorNetwork::update_ctc_domains(Contractor *ctc, const vector<Domain*>& v_domains)
+    {
+      // Only the entry of this contractor is removed, without rehash of the registry
+      if(!m_map_ctc.erase(ContractorHashcode(*ctc)))
+        assert(false && "contractor not registered");
+      ctc->domains() = v_domains;
+      m_map_ctc.insert(ContractorHashcode(*ctc), ctc);
+    }
+}
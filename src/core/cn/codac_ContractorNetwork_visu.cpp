@@ -11,6 +11,7 @@
 #include <iostream>
 #include <fstream>
 #include "codac_Tools.h"
+#include "codac_ColorMap.h"
 #include "codac_ContractorNetwork.h"
 #include "codac_Exception.h"
 
@@ -59,7 +60,7 @@ namespace codac
         throw Exception(__func__, "contractor cannot be found in CN");
     }
 
-    int ContractorNetwork::print_dot_graph(const string& cn_name, const string& layer_model) const
+    int ContractorNetwork::print_dot_graph(const string& cn_name, const string& layer_model, bool profiling) const
     {
       if(m_map_domains.size() > 100 || m_map_ctc.size() > 100)
         cout << "Warning: important number of domains/contractors in the graph, may not be able to generate the diagram." << endl;
@@ -75,13 +76,29 @@ namespace codac
       for(const auto& dom : m_map_domains)
         dot_file << "  " << ("dom" + std::to_string(dom.second->id())) << " [shape=box, label=\"" << dom.second->dom_name(m_map_domains) << "\"];" << endl;
 
+      // Profiling overlay: colors from white (cheap) to red (most expensive contractor)
+      double max_duration = 0.;
+      ColorMap cost_colormap;
+      if(profiling)
+      {
+        for(const auto& ctc : m_map_ctc)
+          max_duration = std::max(max_duration, ctc.second->total_duration());
+        cost_colormap.add_color_point(make_rgb(255,255,255), 0.);
+        cost_colormap.add_color_point(make_rgb(214,39,40), 1.);
+      }
+
       dot_file << endl << "  // Contractors nodes" << endl;
       for(auto& ctc : m_map_ctc)
       {
         dot_file << "  " << ("ctc" + std::to_string(ctc.second->id()))
                  // Node style:
-                 << " [shape=circle, "
-                 << "label=\"" << ctc.second->name() << "\"];" << endl;
+                 << " [shape=circle, ";
+
+        if(profiling && max_duration > 0.)
+          dot_file << "style=filled, fillcolor=\""
+                   << rgb2hex(cost_colormap.color(ctc.second->total_duration() / max_duration)) << "\", ";
+
+        dot_file << "label=\"" << ctc.second->name() << "\"];" << endl;
       }
 
       dot_file << endl << "  // Relations" << endl;
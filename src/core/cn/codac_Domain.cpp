@@ -8,6 +8,7 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <cmath>
 #include "codac_Tools.h"
 #include "codac_Domain.h"
 #include "codac_Figure.h" // for add_suffix
@@ -20,6 +21,13 @@ namespace codac
 {
   int Domain::dom_counter = 0;
 
+  // Linear interpolation of the data at t, between two samples
+  static Interval interpolate(double t, double ta, const Interval& ya, double tb, const Interval& yb)
+  {
+    double r = (t - ta) / (tb - ta);
+    return Interval(ya.lb() + r * (yb.lb() - ya.lb())) | Interval(ya.ub() + r * (yb.ub() - ya.ub()));
+  }
+
   Domain::Domain()
     : m_type(Type::T_INTERVAL), m_memory_type(MemoryRef::M_DOUBLE)
   {
@@ -218,6 +226,7 @@ namespace codac
   const Domain& Domain::operator=(const Domain& ad)
   {
     m_volume = ad.m_volume;
+    m_v_dirty_trackers.clear(); // the updates are tracked for each domain
     m_v_ctc = ad.m_v_ctc;
     m_name = ad.m_name;
     m_dom_id = ad.m_dom_id;
@@ -487,6 +496,39 @@ namespace codac
     m_volume = vol;
   }
 
+  const Interval Domain::contracted_tdomain()
+  {
+    vector<const Tube*> v_x;
+
+    switch(m_type)
+    {
+      case Type::T_SLICE:
+        return slice().tdomain();
+
+      case Type::T_TUBE:
+        v_x.push_back(&tube());
+        break;
+
+      case Type::T_TUBE_VECTOR:
+        for(int i = 0 ; i < tube_vector().size() ; i++)
+          v_x.push_back(&tube_vector()[i]);
+        break;
+
+      default:
+        return Interval::ALL_REALS;
+    }
+
+    // The updates of the slices are recorded at write time by the tubes,
+    // for one tracker per component (created at the first call)
+
+    m_v_dirty_trackers.resize(v_x.size());
+
+    Interval t = Interval::EMPTY_SET;
+    for(size_t i = 0 ; i < v_x.size() ; i++)
+      t |= v_x[i]->dirty_tdomain(m_v_dirty_trackers[i]);
+    return t;
+  }
+
   bool Domain::is_empty() const
   {
     switch(m_type)
@@ -686,78 +728,171 @@ namespace codac
   void Domain::add_data(double t, const Interval& y, ContractorNetwork& cn)
   {
     assert(m_type == Type::T_TUBE);
-    // Note: t may be defined outside the tube definition
+    push_data(t, y);
+    flush_data(cn);
+  }
+  
+  void Domain::add_data(double t, const IntervalVector& y, ContractorNetwork& cn)
+  {
+    assert(m_type == Type::T_TUBE_VECTOR);
+    if(tube_vector().size() != y.size())
+      throw Exception(__func__, "tube and box not of same dimension");
 
-    if(m_traj_lb.not_defined())
+    // No component is updated if one of them rejects t
+    for(int i = 0 ; i < tube_vector().size() ; i++)
+      if(cn.add_dom(Domain(tube_vector()[i]))->m_data_t >= t)
+        throw Exception(__func__, "t does not represent new data since last call");
+
+    for(int i = 0 ; i < tube_vector().size() ; i++)
     {
-      m_traj_lb.set(y.lb(), t);
-      m_traj_ub.set(y.ub(), t);
-      return; // cannot add data with a single point
+      Domain *tube_i = cn.add_dom(Domain(tube_vector()[i]));
+      tube_i->add_data(t, y[i], cn);
     }
+  }
 
-    double prev_t = m_traj_lb.tdomain().ub();
-    if(t <= prev_t)
-      throw Exception(__func__, "t does not represent new data since last call");
-
-    // Updating the trajectory
-    m_traj_lb.set(y.lb(), t);
-    m_traj_ub.set(y.ub(), t);
+  void Domain::add_data(const vector<double>& v_t, const vector<Interval>& v_y, ContractorNetwork& cn)
+  {
+    assert(m_type == Type::T_TUBE);
+    if(v_t.size() != v_y.size())
+      throw Exception(__func__, "times and values not of same size");
+    check_data(v_t); // the whole batch is checked before any sample is stored
 
-    if(prev_t < tube().tdomain().lb())
-      return; // nothing can be done yet (outside tube definition)
+    for(size_t j = 0 ; j < v_t.size() ; j++)
+      push_data(v_t[j], v_y[j]);
+    flush_data(cn); // each covered slice is contracted once
+  }
 
-    Slice *prev_s;
+  void Domain::add_data(const vector<double>& v_t, const vector<IntervalVector>& v_y, ContractorNetwork& cn)
+  {
+    assert(m_type == Type::T_TUBE_VECTOR);
+    check_data(v_t, v_y, cn); // the whole batch is checked on each component before any sample is stored
 
-    if(t < tube().tdomain().ub())
+    for(int i = 0 ; i < tube_vector().size() ; i++)
     {
-      prev_s = tube().slice(t);
-      if(prev_s == tube().first_slice())
-        return; // the slice is not complete yet, and the previous one does not exist
+      Domain *tube_i = cn.add_dom(Domain(tube_vector()[i]));
+      for(size_t j = 0 ; j < v_t.size() ; j++)
+        tube_i->push_data(v_t[j], v_y[j][i]);
+      tube_i->flush_data(cn);
+    }
+  }
+  
+  void Domain::check_data(const vector<double>& v_t) const
+  {
+    assert(m_type == Type::T_TUBE);
 
-      prev_s = prev_s->prev_slice();
+    for(size_t j = 0 ; j < v_t.size() ; j++)
+    {
+      double t_prev = j == 0 ? m_data_t : v_t[j-1]; // NaN if no data has been added yet
+      if(v_t[j] <= t_prev || std::isnan(v_t[j]))
+        throw Exception(__func__, "t does not represent new data since last call");
     }
+  }
+
+  void Domain::check_data(const vector<double>& v_t, const vector<IntervalVector>& v_y, ContractorNetwork& cn)
+  {
+    assert(m_type == Type::T_TUBE_VECTOR);
+    if(v_t.size() != v_y.size())
+      throw Exception(__func__, "times and values not of same size");
+
+    for(size_t j = 0 ; j < v_y.size() ; j++)
+      if(tube_vector().size() != v_y[j].size())
+        throw Exception(__func__, "tube and box not of same dimension");
+
+    // The components may have received different data, from their own Domain objects
+    for(int i = 0 ; i < tube_vector().size() ; i++)
+      cn.add_dom(Domain(tube_vector()[i]))->check_data(v_t);
+  }
 
-    else // if data goes beyond tube's definition domain
+  void Domain::push_data(double t, const Interval& y)
+  {
+    assert(m_type == Type::T_TUBE);
+    // Note: t may be defined outside the tube definition
+
+    if(std::isnan(m_data_t))
     {
-      prev_s = tube().last_slice();
+      m_data_t0 = t;
+      m_data_t = t;
+      m_data_y = y;
+      m_data_hull = y;
+      return; // cannot add data with a single point
     }
 
-    // Contracting the tube
-    // A jump may have been done: several slices may exist between the current
-    // t and the previous one.
+    if(t <= m_data_t)
+      throw Exception(__func__, "t does not represent new data since last call");
+
+    const Tube& x = tube();
+    const Slice *s = NULL;
 
-    // So we iterate:
-    while(prev_s != NULL && prev_s->tdomain().is_subset(m_traj_lb.tdomain()))
+    if(m_data_t < x.tdomain().lb())
     {
-      Interval new_slice_envelope = (m_traj_lb(prev_s->tdomain()) | m_traj_ub(prev_s->tdomain()));
+      if(t >= x.tdomain().lb())
+      {
+        // The data enters the tube definition: the hull starts from the first gate
+        m_data_hull = interpolate(x.tdomain().lb(), m_data_t, m_data_y, t, y);
+        s = x.first_slice();
+      }
+    }
 
-      if(prev_s->codomain().is_subset(new_slice_envelope))
-        break;
+    else if(m_data_t < x.tdomain().ub())
+      s = x.slice(m_data_t); // if m_data_t is a gate, the hull has been reset on it
 
-      prev_s->set_envelope(new_slice_envelope);
+    // Each slice completed by the new sample is stored, with the hull of the data over it.
+    // A jump may have been done: several slices may exist between t and the previous sample.
+    while(s != NULL && s->tdomain().ub() <= t)
+    {
+      Interval y_ub = interpolate(s->tdomain().ub(), m_data_t, m_data_y, t, y);
+      m_data_hull |= y_ub;
 
-      // Flags a new change on the slice domain
-      cn.trigger_ctc_related_to_dom(cn.add_dom(Domain(*prev_s)));
+      if(s->tdomain().lb() >= m_data_t0) // the data covers the whole slice
+        m_v_data_slices.push_back(make_pair(const_cast<Slice*>(s), m_data_hull));
 
-      // Iterates
-      prev_s = prev_s->prev_slice();
+      m_data_hull = y_ub; // the next slice starts from the gate
+      s = s->next_slice();
     }
+
+    m_data_hull |= y;
+    m_data_t = t;
+    m_data_y = y;
   }
-  
-  void Domain::add_data(double t, const IntervalVector& y, ContractorNetwork& cn)
+
+  void Domain::flush_data(ContractorNetwork& cn)
   {
-    assert(m_type == Type::T_TUBE_VECTOR);
-    if(tube_vector().size() != y.size())
-      throw Exception(__func__, "tube and box not of same dimension");
+    assert(m_type == Type::T_TUBE);
 
-    for(int i = 0 ; i < tube_vector().size() ; i++)
+    if(m_v_data_slices.empty())
+      return;
+
+    // Domains of the slices, in the order of the tube component contractor
+    const vector<Domain*> *v_slices_doms = NULL;
+    for(const auto& ctc : m_v_ctc)
+      if(ctc->type() == Contractor::Type::T_COMPONENT && ctc->domains()[0] == this)
+      {
+        v_slices_doms = &ctc->domains();
+        break;
+      }
+
+    assert(v_slices_doms != NULL);
+    assert((int)v_slices_doms->size() == tube().nb_slices() + 1);
+
+    // Contracting the tube, from the last covered slice (as for one sample at a time)
+    for(auto it = m_v_data_slices.rbegin() ; it != m_v_data_slices.rend() ; ++it)
     {
-      Domain *tube_i = cn.add_dom(Domain(tube_vector()[i]));
-      tube_i->add_data(t, y[i], cn);
+      Slice *s = it->first;
+      if(s->codomain().is_subset(it->second))
+        continue; // no contraction
+
+      s->set_envelope(s->codomain() & it->second);
+
+      // Flags a new change on the slice domain
+      Domain *dom_s = (*v_slices_doms)[tube().index(s) + 1];
+      assert(&dom_s->slice() == s);
+      cn.trigger_ctc_related_to_dom(dom_s);
     }
+
+    m_v_data_slices.clear(); // the capacity is kept for the next calls
   }
-  
-  const string Domain::var_name(const map<DomainHashcode,Domain*> m_domains) const
+
+  const string Domain::var_name(const HashRegistry<DomainHashcode,Domain*>& m_domains) const
   {
     string output_name = m_name;
 
@@ -917,7 +1052,7 @@ namespace codac
     return n;
   }
 
-  const string Domain::dom_name(const map<DomainHashcode,Domain*> m_domains) const
+  const string Domain::dom_name(const HashRegistry<DomainHashcode,Domain*>& m_domains) const
   {
     string output_name = var_name(m_domains);
 
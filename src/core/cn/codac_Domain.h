@@ -13,6 +13,8 @@
 #define __CODAC_DOMAIN_H__
 
 #include <functional>
+#include <limits>
+#include <memory>
 #include "codac_Interval.h"
 #include "codac_IntervalVector.h"
 #include "codac_Slice.h"
@@ -21,6 +23,7 @@
 #include "codac_Contractor.h"
 #include "codac_ContractorNetwork.h"
 #include "codac_Hashcode.h"
+#include "codac_HashRegistry.h"
 
 namespace codac
 {
@@ -79,6 +82,7 @@ namespace codac
       double compute_volume() const;
       double get_saved_volume() const;
       void set_volume(double vol);
+      const Interval contracted_tdomain();
 
       bool is_empty() const;
       
@@ -93,8 +97,10 @@ namespace codac
 
       void add_data(double t, const Interval& y, ContractorNetwork& cn);
       void add_data(double t, const IntervalVector& y, ContractorNetwork& cn);
+      void add_data(const std::vector<double>& v_t, const std::vector<Interval>& v_y, ContractorNetwork& cn);
+      void add_data(const std::vector<double>& v_t, const std::vector<IntervalVector>& v_y, ContractorNetwork& cn);
 
-      const std::string dom_name(const std::map<DomainHashcode,Domain*> m_domains) const;
+      const std::string dom_name(const HashRegistry<DomainHashcode,Domain*>& m_domains) const;
       void set_name(const std::string& name);
 
       static bool all_dyn(const std::vector<Domain>& v_domains);
@@ -110,7 +116,11 @@ namespace codac
     protected:
 
       Domain(Type type, MemoryRef memory_type);
-      const std::string var_name(const std::map<DomainHashcode,Domain*> m_domains) const;
+      const std::string var_name(const HashRegistry<DomainHashcode,Domain*>& m_domains) const;
+      void check_data(const std::vector<double>& v_t) const;
+      void check_data(const std::vector<double>& v_t, const std::vector<IntervalVector>& v_y, ContractorNetwork& cn);
+      void push_data(double t, const Interval& y);
+      void flush_data(ContractorNetwork& cn);
 
       // Theoretical type of domain
 
@@ -149,14 +159,19 @@ namespace codac
         };
 
 
-      // todo: update this:
-      std::map<double,double> m_map_data_s_lb, m_map_data_s_ub;
-      std::map<double,Vector> m_map_data_lb, m_map_data_ub;
+      // Continuous data (tubes only), with constant memory:
+      // the data are linearly interpolated between two samples, so that the hull of the data
+      // over a slice is reached either on a sample or on the bounds of the slice
 
-      Trajectory m_traj_lb, m_traj_ub;
+        double m_data_t0 = std::numeric_limits<double>::quiet_NaN(); // time of the first sample
+        double m_data_t = std::numeric_limits<double>::quiet_NaN(); // time of the last sample
+        Interval m_data_y; // last sample
+        Interval m_data_hull; // running hull of the data over the slice containing m_data_t
+        std::vector<std::pair<Slice*,Interval> > m_v_data_slices; // slices covered by the data, to be contracted
 
       std::vector<Contractor*> m_v_ctc;
       double m_volume = 0.;
+      std::vector<std::shared_ptr<SlicesStorage::DirtyTDomain> > m_v_dirty_trackers; // updates of the tubes components, for contracted_tdomain()
 
       std::string m_name;
       int m_dom_id;
@@ -0,0 +1,232 @@
+/** 
+ *  \file
+ *  HashRegistry class
+ * ----------------------------------------------------------------------------
+ *  \date       2021
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_HASHREGISTRY_H__
+#define __CODAC_HASHREGISTRY_H__
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cassert>
+
+namespace codac
+{
+  /**
+   * \class HashRegistry
+   * \brief Flat hash table storing the domains or contractors of a ContractorNetwork
+   *
+   * \note The entries are stored contiguously, in their insertion order, and indexed by an
+   *       open-addressing table (linear probing) of integers. The keys must provide a
+   *       `size_t hash() const` method and an equality operator.
+   * \note Removals are mainly done in bulk (see remove_if()), as the graph of a ContractorNetwork
+   *       mainly grows, except in streaming mode where old slices are evicted.
+   *       A single entry can be removed in constant time (see erase()).
+   */
+  template<typename K,typename T>
+  class HashRegistry
+  {
+    public:
+
+      typedef typename std::vector<std::pair<K,T> >::iterator iterator;
+      typedef typename std::vector<std::pair<K,T> >::const_iterator const_iterator;
+
+      /**
+       * \brief Creates an empty registry
+       */
+      HashRegistry()
+      {
+
+      }
+
+      /**
+       * \brief Returns the number of entries
+       *
+       * \return the size of the registry
+       */
+      size_t size() const
+      {
+        return m_v_entries.size();
+      }
+
+      /**
+       * \brief Reserves memory for the given number of entries,
+       *        in order to avoid successive rehashes during bulk insertions
+       *
+       * \param n expected number of entries
+       */
+      void reserve(size_t n)
+      {
+        m_v_entries.reserve(n);
+        if(2*n > m_v_slots.size())
+          rehash(2*n);
+      }
+
+      /**
+       * \brief Looks for the entry related to the given key
+       *
+       * \param key the key of the entry
+       * \return an iterator to the entry, or `end()` if the key is not registered
+       */
+      iterator find(const K& key)
+      {
+        if(m_v_slots.empty())
+          return end();
+        int id = m_v_slots[slot(key)];
+        return id == -1 ? end() : m_v_entries.begin() + id;
+      }
+
+      /**
+       * \brief Looks for the entry related to the given key
+       *
+       * \param key the key of the entry
+       * \return a const iterator to the entry, or `end()` if the key is not registered
+       */
+      const_iterator find(const K& key) const
+      {
+        if(m_v_slots.empty())
+          return end();
+        int id = m_v_slots[slot(key)];
+        return id == -1 ? end() : m_v_entries.begin() + id;
+      }
+
+      /**
+       * \brief Registers a new entry
+       *
+       * \param key the key of the entry, that must not be already registered
+       * \param value the value of the entry
+       * \return an iterator to the new entry
+       */
+      iterator insert(const K& key, const T& value)
+      {
+        if(2*(m_v_entries.size()+1) > m_v_slots.size()) // load factor kept under 1/2
+          rehash(2*(m_v_entries.size()+1));
+
+        size_t i = slot(key);
+        assert(m_v_slots[i] == -1 && "key already registered");
+        m_v_slots[i] = m_v_entries.size();
+        m_v_entries.push_back(std::make_pair(key, value));
+        return m_v_entries.end() - 1;
+      }
+
+      /**
+       * \brief Removes the entry related to the given key
+       *
+       * \note The slot is freed by backward-shift deletion, without rehash. The last entry
+       *       is moved to the place of the removed one: it loses its insertion order.
+       *
+       * \param key the key of the entry
+       * \return `true` if the key was registered
+       */
+      bool erase(const K& key)
+      {
+        if(m_v_slots.empty())
+          return false;
+
+        size_t i = slot(key);
+        int id = m_v_slots[i];
+        if(id == -1)
+          return false;
+
+        // Backward-shift deletion: the next entries of the probing sequence are moved
+        // into the free slot, unless they are already placed between their home slot and it
+        size_t mask = m_v_slots.size() - 1;
+        size_t j = i;
+        while(true)
+        {
+          j = (j + 1) & mask;
+          if(m_v_slots[j] == -1)
+            break;
+
+          size_t home = m_v_entries[m_v_slots[j]].first.hash() & mask;
+          if(((j - home) & mask) >= ((j - i) & mask))
+          {
+            m_v_slots[i] = m_v_slots[j];
+            i = j;
+          }
+        }
+        m_v_slots[i] = -1;
+
+        // The last entry fills the place of the removed one
+        int last = m_v_entries.size() - 1;
+        if(id != last)
+        {
+          m_v_slots[slot(m_v_entries[last].first)] = id;
+          m_v_entries[id] = std::move(m_v_entries[last]);
+        }
+        m_v_entries.pop_back();
+        return true;
+      }
+
+      /**
+       * \brief Removes all the entries satisfying the given predicate
+       *
+       * \note The remaining entries keep their insertion order. The open-addressing
+       *       table is rebuilt once, so that the cost is linear in the number of entries.
+       *
+       * \param pred unary predicate on the `std::pair<K,T>` entries
+       * \return the number of removed entries
+       */
+      template<typename P>
+      size_t remove_if(P pred)
+      {
+        size_t n = m_v_entries.size();
+        m_v_entries.erase(std::remove_if(m_v_entries.begin(), m_v_entries.end(), pred), m_v_entries.end());
+        if(m_v_entries.size() != n)
+          rehash(m_v_slots.size());
+        return n - m_v_entries.size();
+      }
+
+      iterator begin() { return m_v_entries.begin(); }
+      iterator end() { return m_v_entries.end(); }
+      const_iterator begin() const { return m_v_entries.begin(); }
+      const_iterator end() const { return m_v_entries.end(); }
+
+    protected:
+
+      /**
+       * \brief Returns the slot of the key, or the first free slot on its probing sequence
+       *
+       * \param key the key to be found
+       * \return the index of the slot
+       */
+      size_t slot(const K& key) const
+      {
+        size_t mask = m_v_slots.size() - 1;
+        size_t i = key.hash() & mask;
+        while(m_v_slots[i] != -1 && !(m_v_entries[m_v_slots[i]].first == key))
+          i = (i + 1) & mask;
+        return i;
+      }
+
+      /**
+       * \brief Rebuilds the open-addressing table with a larger number of slots
+       *
+       * \param n minimal number of slots (rounded to the next power of two)
+       */
+      void rehash(size_t n)
+      {
+        size_t nb_slots = 16;
+        while(nb_slots < n)
+          nb_slots *= 2;
+
+        m_v_slots.assign(nb_slots, -1);
+        for(size_t k = 0 ; k < m_v_entries.size() ; k++)
+          m_v_slots[slot(m_v_entries[k].first)] = k;
+      }
+
+      // Class variables:
+
+        std::vector<std::pair<K,T> > m_v_entries; //!< registered entries, in insertion order
+        std::vector<int> m_v_slots; //!< open-addressing table of indexes in m_v_entries (-1 for free slots)
+  };
+}
+
+#endif
@@ -23,41 +23,47 @@ namespace codac
   ContractorHashcode::ContractorHashcode(const Contractor& ctc)
   {
     m_n = ctc.m_v_domains.size()+1;
-    m_ptr = new std::uintptr_t[m_n];
+    std::uintptr_t *ptr = m_small_ptr;
+
+    if(m_n > SMALL_SIZE)
+    {
+      m_v_large_ptr.resize(m_n);
+      ptr = m_v_large_ptr.data();
+    }
 
     for(size_t i = 0 ; i < m_n-1 ; i++)
-      m_ptr[i] = DomainHashcode::uintptr(*ctc.m_v_domains[i]);
+      ptr[i] = DomainHashcode::uintptr(*ctc.m_v_domains[i]);
 
     switch(ctc.m_type)
     {
       case Contractor::Type::T_EQUALITY:
-        m_ptr[m_n-1] = 0; // todo: check this
+        ptr[m_n-1] = 0; // todo: check this
         break;
 
       case Contractor::Type::T_COMPONENT:
-        m_ptr[m_n-1] = 1; // todo: check this
+        ptr[m_n-1] = 1; // todo: check this
         break;
         
       case Contractor::Type::T_IBEX:
-        m_ptr[m_n-1] = reinterpret_cast<std::uintptr_t>(&ctc.m_static_ctc.get());
-        assert(m_ptr[m_n-1] > 4); // reserved codes
+        ptr[m_n-1] = reinterpret_cast<std::uintptr_t>(&ctc.m_static_ctc.get());
+        assert(ptr[m_n-1] > 4); // reserved codes
         break;
 
       case Contractor::Type::T_CODAC:
 
         if(typeid(ctc.m_dyn_ctc.get()) == typeid(CtcEval))
-          m_ptr[m_n-1] = 2;
+          ptr[m_n-1] = 2;
 
         else if(typeid(ctc.m_dyn_ctc.get()) == typeid(CtcDeriv))
-          m_ptr[m_n-1] = 3;
+          ptr[m_n-1] = 3;
 
         else if(typeid(ctc.m_dyn_ctc.get()) == typeid(CtcDist))
-          m_ptr[m_n-1] = 4;
+          ptr[m_n-1] = 4;
 
         else
         {
-          m_ptr[m_n-1] = reinterpret_cast<std::uintptr_t>(&ctc.m_dyn_ctc.get());
-          assert(m_ptr[m_n-1] > 4); // reserved codes
+          ptr[m_n-1] = reinterpret_cast<std::uintptr_t>(&ctc.m_dyn_ctc.get());
+          assert(ptr[m_n-1] > 4); // reserved codes
         }
 
         break;
@@ -65,19 +71,33 @@ namespace codac
       default:
         assert(false && "unhandled case");
     }
+
+    m_hash = m_n;
+    for(size_t i = 0 ; i < m_n ; i++)
+      m_hash = DomainHashcode::mix(m_hash ^ ptr[i]);
   }
 
-  bool ContractorHashcode::operator<(const ContractorHashcode& a) const
+  bool ContractorHashcode::operator==(const ContractorHashcode& a) const
   {
-    for(size_t i = 0 ; i < std::min(m_n, a.m_n) ; i++)
-    {
-      if(m_ptr[i] == a.m_ptr[i])
-        continue;
+    if(m_hash != a.m_hash || m_n != a.m_n)
+      return false;
 
-      return m_ptr[i] < a.m_ptr[i];
-    }
+    const std::uintptr_t *ptr1 = ptr(), *ptr2 = a.ptr();
+    for(size_t i = 0 ; i < m_n ; i++)
+      if(ptr1[i] != ptr2[i])
+        return false;
+
+    return true;
+  }
+
+  size_t ContractorHashcode::hash() const
+  {
+    return m_hash;
+  }
 
-    return false;
+  const std::uintptr_t* ContractorHashcode::ptr() const
+  {
+    return m_n > SMALL_SIZE ? m_v_large_ptr.data() : m_small_ptr;
   }
 
   // DomainHashcode class
@@ -87,9 +107,24 @@ namespace codac
     m_ptr = DomainHashcode::uintptr(dom);
   }
 
-  bool DomainHashcode::operator<(const DomainHashcode& a) const
+  bool DomainHashcode::operator==(const DomainHashcode& a) const
+  {
+    return m_ptr == a.m_ptr;
+  }
+
+  size_t DomainHashcode::hash() const
+  {
+    return mix(m_ptr);
+  }
+
+  size_t DomainHashcode::mix(std::uintptr_t x)
   {
-    return m_ptr < a.m_ptr;
+    // Finalizer of the SplitMix64 generator: pointers are aligned,
+    // so that their low bits have to be mixed with the high ones
+    uint64_t z = static_cast<uint64_t>(x) + 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return static_cast<size_t>(z ^ (z >> 31));
   }
 
   uintptr_t DomainHashcode::uintptr(const Domain& dom)
@@ -13,6 +13,7 @@
 #define __CODAC_HASHCODE_H__
 
 #include <cstdint>
+#include <vector>
 #include "codac_Contractor.h"
 #include "codac_Domain.h"
 
@@ -26,12 +27,19 @@ namespace codac
     public:
 
       ContractorHashcode(const Contractor& ctc);
-      bool operator<(const ContractorHashcode& a) const;
+      bool operator==(const ContractorHashcode& a) const;
+      size_t hash() const;
 
     protected:
 
+      const std::uintptr_t* ptr() const;
+
+      static const size_t SMALL_SIZE = 6; // inline storage, for most of the contractors
+
       size_t m_n;
-      std::uintptr_t *m_ptr;
+      size_t m_hash;
+      std::uintptr_t m_small_ptr[SMALL_SIZE];
+      std::vector<std::uintptr_t> m_v_large_ptr; // only used for contractors with many domains
   };
 
   class DomainHashcode
@@ -39,9 +47,11 @@ namespace codac
     public:
 
       DomainHashcode(const Domain& dom);
-      bool operator<(const DomainHashcode& a) const;
+      bool operator==(const DomainHashcode& a) const;
+      size_t hash() const;
 
       static std::uintptr_t uintptr(const Domain& dom);
+      static size_t mix(std::uintptr_t x);
 
     protected:
 
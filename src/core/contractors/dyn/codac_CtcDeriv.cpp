@@ -12,6 +12,7 @@
 #include "codac_ConvexPolygon.h"
 #include "codac_Domain.h"
 #include "codac_DomainsTypeException.h"
+#include "codac_ThreadPool.h"
 
 using namespace std;
 using namespace ibex;
@@ -24,6 +25,21 @@ namespace codac
 
   }
 
+  void CtcDeriv::set_parallel_propagation(bool parallel_propagation)
+  {
+    m_parallel_propagation = parallel_propagation;
+  }
+
+  void CtcDeriv::set_incremental_mode(bool incremental_mode)
+  {
+    m_incremental_mode = incremental_mode;
+  }
+
+  bool CtcDeriv::is_incremental() const
+  {
+    return m_incremental_mode;
+  }
+
   // Static members for contractor signature (mainly used for CN Exceptions)
   const string CtcDeriv::m_ctc_name = "CtcDeriv";
   vector<string> CtcDeriv::m_str_expected_doms(
@@ -33,6 +49,136 @@ namespace codac
     "Slice, Slice[, Slice, Slice..]"
   });
   
+  /*
+   * Interval map x -> [max(lb_min, x.lb + lb_offset), min(ub_max, x.ub + ub_offset)],
+   * that is x -> c & (x + d), with c = [lb_min,ub_max] and d = [lb_offset,ub_offset].
+   * The composition of such maps is a map of the same form, which allows
+   * the propagation of the gates by a parallel prefix scan.
+   */
+  namespace
+  {
+    struct GateMap
+    {
+      double lb_min, lb_offset, ub_max, ub_offset;
+      bool constant; // the input of the map is not considered (lb_offset = -oo, ub_offset = +oo)
+    };
+
+    struct GateEmptiness
+    {
+      bool constant, empty;
+    };
+  }
+
+  static double add_down(double a, double b)
+  {
+    // Note: Interval(a) is empty for an infinite a
+    if(a == NEG_INFINITY || b == NEG_INFINITY)
+      return NEG_INFINITY;
+    return (Interval(a) + Interval(b)).lb();
+  }
+
+  static double add_up(double a, double b)
+  {
+    if(a == POS_INFINITY || b == POS_INFINITY)
+      return POS_INFINITY;
+    return (Interval(a) + Interval(b)).ub();
+  }
+
+  /*
+   * Forward propagation: g[k+1] = c[k] & (g[k] + d[k]) for the active slices,
+   * backward propagation: g[k] = c[k] & (g[k+1] + d[k]).
+   */
+  static void propagate_gates(vector<Interval>& g, const vector<Interval>& c, const vector<Interval>& d,
+    const vector<char>& active, bool forward, bool parallel)
+  {
+    const int n = c.size();
+    ThreadPool& pool = ThreadPool::shared();
+
+    if(!parallel || pool.nb_ranges(n, ThreadPool::grain_size()) == 1)
+    {
+      if(forward)
+      {
+        for(int k = 0 ; k < n ; k++)
+          if(active[k])
+            g[k+1] = c[k] & (g[k] + d[k]);
+      }
+
+      else
+      {
+        for(int k = n-1 ; k >= 0 ; k--)
+          if(active[k])
+            g[k] = c[k] & (g[k+1] + d[k]);
+      }
+
+      return;
+    }
+
+    // Maps in the order of the propagation, the first one being the initial gate
+
+    auto gate_id = [&](int j) { return forward ? j : n - j; }; // gate computed by the jth map
+    auto slice_id = [&](int j) { return forward ? j - 1 : n - j; }; // slice of the jth map, j > 0
+    vector<GateMap> v_maps(n + 1);
+
+    pool.for_each_range(n + 1, ThreadPool::grain_size(), [&](int j0, int j1)
+    {
+      for(int j = j0 ; j < j1 ; j++)
+      {
+        const Interval& x = g[gate_id(j)];
+
+        if(j == 0 || !active[slice_id(j)]) // gate not modified
+          v_maps[j] = x.is_empty()
+            ? GateMap({ NEG_INFINITY, NEG_INFINITY, POS_INFINITY, POS_INFINITY, true })
+            : GateMap({ x.lb(), NEG_INFINITY, x.ub(), POS_INFINITY, true });
+
+        else
+        {
+          int k = slice_id(j);
+          v_maps[j] = c[k].is_empty() || d[k].is_empty()
+            ? GateMap({ NEG_INFINITY, NEG_INFINITY, POS_INFINITY, POS_INFINITY, false })
+            : GateMap({ c[k].lb(), d[k].lb(), c[k].ub(), d[k].ub(), false });
+        }
+      }
+    });
+
+    pool.inclusive_scan(v_maps, ThreadPool::grain_size(), [](const GateMap& m1, const GateMap& m2)
+    {
+      if(m2.constant)
+        return m2;
+
+      return GateMap({
+        max(m2.lb_min, add_down(m1.lb_min, m2.lb_offset)), add_down(m1.lb_offset, m2.lb_offset),
+        min(m2.ub_max, add_up(m1.ub_max, m2.ub_offset)), add_up(m1.ub_offset, m2.ub_offset),
+        m1.constant });
+    });
+
+    // Once empty, a gate remains empty until a gate that is not modified
+
+    vector<GateEmptiness> v_empty(n + 1);
+
+    pool.for_each_range(n + 1, ThreadPool::grain_size(), [&](int j0, int j1)
+    {
+      for(int j = j0 ; j < j1 ; j++)
+      {
+        bool constant = j == 0 || !active[slice_id(j)];
+        bool empty = v_maps[j].lb_min > v_maps[j].ub_max
+          || (constant ? g[gate_id(j)].is_empty() : c[slice_id(j)].is_empty() || d[slice_id(j)].is_empty());
+        v_empty[j] = { constant, empty };
+      }
+    });
+
+    pool.inclusive_scan(v_empty, ThreadPool::grain_size(), [](const GateEmptiness& e1, const GateEmptiness& e2)
+    {
+      return e2.constant ? e2 : GateEmptiness({ e1.constant, e1.empty || e2.empty });
+    });
+
+    pool.for_each_range(n, ThreadPool::grain_size(), [&](int j0, int j1)
+    {
+      for(int j = j0 + 1 ; j <= j1 ; j++)
+        if(active[slice_id(j)])
+          g[gate_id(j)] = v_empty[j].empty ? Interval::EMPTY_SET : Interval(v_maps[j].lb_min, v_maps[j].ub_max);
+    });
+  }
+
   void CtcDeriv::contract(vector<Domain*>& v_domains)
   {
     // Tube scalar case:
@@ -73,10 +219,41 @@ namespace codac
       throw DomainsTypeException(m_ctc_name, v_domains, m_str_expected_doms);
   }
 
+  void CtcDeriv::contract_incremental(vector<Domain*>& v_domains, const Interval& dirty_tdomain)
+  {
+    // Tube scalar case:
+    if(v_domains[0]->type() == Domain::Type::T_TUBE && v_domains[1]->type() == Domain::Type::T_TUBE)
+    {
+      if(v_domains.size() != 2)
+        throw DomainsTypeException(m_ctc_name, v_domains, m_str_expected_doms);
+
+      contract_incremental(v_domains[0]->tube(), v_domains[1]->tube(), dirty_tdomain);
+    }
+
+    // Tube vector case:
+    else if(v_domains[0]->type() == Domain::Type::T_TUBE_VECTOR && v_domains[1]->type() == Domain::Type::T_TUBE_VECTOR)
+    {
+      if(v_domains.size() != 2)
+        throw DomainsTypeException(m_ctc_name, v_domains, m_str_expected_doms);
+      
+      contract_incremental(v_domains[0]->tube_vector(), v_domains[1]->tube_vector(), dirty_tdomain);
+    }
+
+    // Slice case: nothing to save
+    else
+      contract(v_domains);
+  }
+
   void CtcDeriv::contract(Tube& x, const Tube& v, TimePropag t_propa)
   {
     assert(x.tdomain() == v.tdomain());
     assert(Tube::same_slicing(x, v));
+
+    if(m_fast_mode)
+    {
+      contract_fast(x, v, t_propa);
+      return;
+    }
     
     if(t_propa & TimePropag::FORWARD)
     {
@@ -113,8 +290,87 @@ namespace codac
     assert(x.tdomain() == v.tdomain());
     assert(TubeVector::same_slicing(x, v));
 
+    ThreadPool& pool = ThreadPool::shared();
+
+    if(pool.nb_ranges(x.size(), 1) > 1 && pool.nb_ranges(x.nb_slices(), ThreadPool::grain_size()) < pool.nb_threads())
+    {
+      // Independent components, contracted in parallel
+      // (the slices of each component are then processed sequentially)
+      pool.for_each_range(x.size(), 1, [&](int i0, int i1)
+      {
+        for(int i = i0 ; i < i1 ; i++)
+          contract(x[i], v[i], t_propa);
+      });
+    }
+
+    else
+      for(int i = 0 ; i < x.size() ; i++)
+        contract(x[i], v[i], t_propa);
+  }
+
+  void CtcDeriv::contract_incremental(Tube& x, const Tube& v, const Interval& dirty_tdomain, TimePropag t_propa)
+  {
+    assert(x.tdomain() == v.tdomain());
+    assert(Tube::same_slicing(x, v));
+
+    Interval t = dirty_tdomain & x.tdomain();
+
+    if(t.is_empty())
+      return;
+
+    if(t == x.tdomain())
+    {
+      contract(x, v, t_propa);
+      return;
+    }
+
+    // Slices of the dirty part, including the ones sharing its bounding gates
+    int k0 = x.time_to_index(t.lb()), k1 = x.time_to_index(t.ub());
+    if(k0 > 0 && x.slice(k0)->tdomain().lb() == t.lb())
+      k0--;
+    if(k1 < x.nb_slices()-1 && x.slice(k1)->tdomain().ub() == t.ub())
+      k1++;
+
+    // Propagations stopped as soon as the gates are not contracted anymore
+    int k = k1;
+
+    if(t_propa & TimePropag::FORWARD)
+    {
+      for(k = k0 ; k < x.nb_slices() ; k++)
+      {
+        Slice *s_x = x.slice(k);
+        Interval outgate = s_x->output_gate();
+        contract(*s_x, *v.slice(k), t_propa);
+
+        if(k >= k1 && s_x->output_gate() == outgate)
+          break;
+      }
+
+      k = min(k, x.nb_slices()-1);
+    }
+
+    if(t_propa & TimePropag::BACKWARD)
+    {
+      for( ; k >= 0 ; k--)
+      {
+        Slice *s_x = x.slice(k);
+        Interval ingate = s_x->input_gate();
+        contract(*s_x, *v.slice(k), t_propa);
+
+        if(k <= k0 && s_x->input_gate() == ingate)
+          break;
+      }
+    }
+  }
+
+  void CtcDeriv::contract_incremental(TubeVector& x, const TubeVector& v, const Interval& dirty_tdomain, TimePropag t_propa)
+  {
+    assert(x.size() == v.size());
+    assert(x.tdomain() == v.tdomain());
+    assert(TubeVector::same_slicing(x, v));
+
     for(int i = 0 ; i < x.size() ; i++)
-      contract(x[i], v[i], t_propa);
+      contract_incremental(x[i], v[i], dirty_tdomain, t_propa);
   }
 
   void CtcDeriv::contract(Slice& x, const Slice& v, TimePropag t_propa)
@@ -201,6 +457,143 @@ namespace codac
     assert(volume >= x.volume() + v.volume() && "contraction rule not respected");
   }
 
+  void CtcDeriv::contract_fast(Tube& x, const Tube& v, TimePropag t_propa)
+  {
+    const int n = x.nb_slices();
+    vector<Interval> e(n), g(n+1), v_codomains(n);
+    vector<double> dt(n);
+    vector<char> active(n);
+
+    // The passes work on the above copies: the tube is only modified by the last
+    // one, so that a synthesis tree is updated once (see Tube::for_each_slice_range())
+    ThreadPool& pool = ThreadPool::shared();
+    auto for_each_range = [&](const function<void(int,int)>& f)
+    {
+      pool.for_each_range(n, ThreadPool::grain_size(), f);
+    };
+
+    for_each_range([&](int k0, int k1)
+    {
+      for(int k = k0 ; k < k1 ; k++)
+      {
+        const Slice *s_x = x.slice(k);
+        e[k] = s_x->codomain();
+        g[k] = s_x->input_gate();
+        v_codomains[k] = v.slice(k)->codomain();
+        dt[k] = s_x->tdomain().diam();
+        active[k] = s_x->tdomain().intersects(m_restricted_tdomain);
+      }
+    });
+
+    g[n] = x.last_slice()->output_gate();
+
+    // Each slice step of the fast contraction reduces to a gate propagation
+    // that depends only on the previous gate and on the initial envelopes,
+    // and to slice-local updates once the gates are known. The intermediate
+    // envelopes of a slice step are not needed by the gate propagation, since
+    // the projection of a gate over dt is a subset of its projection over [0,dt].
+
+    vector<Interval> c(n), d(n);
+    auto sweep = [&](bool forward)
+    {
+      // Gate of slice k propagated to the next one: c[k] & (gate + d[k])
+      for_each_range([&](int k0, int k1)
+      {
+        for(int k = k0 ; k < k1 ; k++)
+        {
+          d[k] = forward ? dt[k] * v_codomains[k] : -(dt[k] * v_codomains[k]);
+          c[k] = g[forward ? k+1 : k] & e[k];
+          if(forward && k+1 < n) c[k] &= e[k+1];
+          if(!forward && k > 0) c[k] &= e[k-1];
+        }
+      });
+
+      propagate_gates(g, c, d, active, forward, m_parallel_propagation);
+    };
+
+    if((t_propa & TimePropag::FORWARD) && (t_propa & TimePropag::BACKWARD))
+    {
+      // Forward sweep, each slice being contracted both ways
+
+      vector<Interval> g0(g); // gates before the sweep
+      sweep(true);
+
+      for_each_range([&](int k0, int k1)
+      {
+        for(int k = k0 ; k < k1 ; k++)
+          if(active[k])
+            e[k] &= g0[k+1] - Interval(0.,dt[k]) * v_codomains[k];
+      });
+
+      for_each_range([&](int k0, int k1)
+      {
+        for(int k = k0 ; k < k1 ; k++)
+          if(active[k])
+            g[k] &= (g0[k+1] - dt[k] * v_codomains[k]) & e[k] & (k > 0 ? e[k-1] : Interval::ALL_REALS);
+      });
+
+      // Backward sweep, each slice being contracted both ways
+
+      g0 = g;
+      sweep(false);
+
+      for_each_range([&](int k0, int k1)
+      {
+        for(int k = k0 ; k < k1 ; k++)
+          if(active[k])
+            e[k] &= g[k+1] - Interval(0.,dt[k]) * v_codomains[k];
+      });
+
+      for_each_range([&](int k0, int k1)
+      {
+        for(int k = k0 ; k < k1 ; k++)
+          if(active[k])
+            g[k+1] &= (g0[k] + dt[k] * v_codomains[k]) & e[k] & (k+1 < n ? e[k+1] : Interval::ALL_REALS);
+      });
+    }
+
+    else if(t_propa & TimePropag::FORWARD)
+    {
+      sweep(true);
+
+      for_each_range([&](int k0, int k1)
+      {
+        for(int k = k0 ; k < k1 ; k++)
+          if(active[k])
+          {
+            e[k] &= g[k] + Interval(0.,dt[k]) * v_codomains[k];
+            g[k] &= e[k];
+          }
+      });
+    }
+
+    else if(t_propa & TimePropag::BACKWARD)
+    {
+      sweep(false);
+
+      for_each_range([&](int k0, int k1)
+      {
+        for(int k = k0 ; k < k1 ; k++)
+          if(active[k])
+          {
+            e[k] &= g[k+1] - Interval(0.,dt[k]) * v_codomains[k];
+            g[k+1] &= e[k];
+          }
+      });
+    }
+
+    x.for_each_slice_range([&](int k0, int k1)
+    {
+      for(int k = k0 ; k < k1 ; k++)
+      {
+        x.slice(k)->set_envelope(e[k], false);
+        x.slice(k)->set_input_gate(g[k], false);
+      }
+    });
+
+    x.last_slice()->set_output_gate(g[n], false);
+  }
+
   void CtcDeriv::contract_gates(Slice& x, const Slice& v)
   {
     assert(x.tdomain() == v.tdomain());
@@ -35,6 +35,37 @@ namespace codac
        */
       CtcDeriv();
 
+      /**
+       * \brief Specifies whether the gates are propagated in parallel, in fast mode
+       *
+       * \note The forward and backward propagations of the gates are then computed by
+       *       parallel prefix scans (see `ThreadPool::set_nb_threads()`), each step being an
+       *       interval map \f$[x]\mapsto[c]\cap([x]+\delta\cdot[v])\f$ whose compositions are of the same form.
+       * \note The composed maps are evaluated with outward rounding: the results are guaranteed,
+       *       but may differ from the sequential propagation by a few ulps.
+       *
+       * \param parallel_propagation if true, parallel propagation enabled (only with `DynCtc::set_fast_mode()`)
+       */
+      void set_parallel_propagation(bool parallel_propagation = true);
+
+      /**
+       * \brief Specifies whether the contractions in a CN are limited to the contracted parts of the tubes
+       *
+       * \note The CN then provides the tdomain over which the tubes have been contracted
+       *       since the last call (see `contract_incremental()`). The other slices are
+       *       assumed to be already consistent with the derivative.
+       *
+       * \param incremental_mode if true, incremental mode enabled
+       */
+      void set_incremental_mode(bool incremental_mode = true);
+
+      /**
+       * \brief Tests if the incremental mode is enabled
+       *
+       * \return `true` if the CN provides the contracted parts of the tubes
+       */
+      bool is_incremental() const;
+
       /*
        * \brief Contracts a set of abstract domains
        *
@@ -44,12 +75,26 @@ namespace codac
        */
       void contract(std::vector<Domain*>& v_domains);
 
+      /*
+       * \brief Contracts a set of abstract domains that have been contracted
+       *        over a part of their tdomain only (incremental mode)
+       *
+       * \param v_domains vector of Domain pointers
+       * \param dirty_tdomain union of the tdomains over which the domains have been contracted
+       */
+      void contract_incremental(std::vector<Domain*>& v_domains, const Interval& dirty_tdomain);
+
       /**
        * \brief \f$\mathcal{C}_{\frac{d}{dt}}\big([x](\cdot),[v](\cdot)\big)\f$:
        *        contracts the tube \f$[x](\cdot)\f$ with respect to its derivative \f$[v](\cdot)\f$.
        *
        * \pre \f$[x](\cdot)\f$ and \f$[v](\cdot)\f$ must share the same slicing and tdomain.
        *
+       * \note In fast mode (see `DynCtc::set_fast_mode()`), the slices are contracted by
+       *       a propagation of the gates followed by slice-local envelope updates,
+       *       possibly in parallel (see `ThreadPool::set_nb_threads()`). The result is the same
+       *       as contracting the slices one after the other (up to rounding, see `set_parallel_propagation()`).
+       *
        * \param x the scalar tube \f$[x](\cdot)\f$
        * \param v the scalar derivative tube \f$[v](\cdot)\f$
        * \param t_propa an optional temporal way of propagation
@@ -63,6 +108,9 @@ namespace codac
        *
        * \pre \f$[\mathbf{x}](\cdot)\f$ and \f$[\mathbf{v}](\cdot)\f$ must share the same dimension, slicing and tdomain.
        *
+       * \note The components are contracted in parallel if the shared ThreadPool
+       *       has more threads than ranges of slices to process.
+       *
        * \param x the n-dimensional tube \f$[\mathbf{x}](\cdot)\f$
        * \param v the n-dimensional derivative tube \f$[\mathbf{v}](\cdot)\f$
        * \param t_propa an optional temporal way of propagation
@@ -70,6 +118,38 @@ namespace codac
        */
       void contract(TubeVector& x, const TubeVector& v, TimePropag t_propa = TimePropag::FORWARD | TimePropag::BACKWARD);
 
+      /**
+       * \brief \f$\mathcal{C}_{\frac{d}{dt}}\big([x](\cdot),[v](\cdot)\big)\f$, after a contraction of
+       *        \f$[x](\cdot)\f$ or \f$[v](\cdot)\f$ over \f$[t]\f$ only.
+       *
+       * \pre \f$[x](\cdot)\f$ and \f$[v](\cdot)\f$ must share the same slicing and tdomain.
+       *
+       * \note The slices are contracted from \f$[t]\f$, forward and backward, until
+       *       the gates are not contracted anymore. The slices out of this range are
+       *       assumed to be already consistent with the derivative.
+       *
+       * \param x the scalar tube \f$[x](\cdot)\f$
+       * \param v the scalar derivative tube \f$[v](\cdot)\f$
+       * \param dirty_tdomain the tdomain \f$[t]\f$ over which the tubes have been contracted
+       * \param t_propa an optional temporal way of propagation
+       *                (forward or backward in time, both ways by default)
+       */
+      void contract_incremental(Tube& x, const Tube& v, const Interval& dirty_tdomain, TimePropag t_propa = TimePropag::FORWARD | TimePropag::BACKWARD);
+
+      /**
+       * \brief \f$\mathcal{C}_{\frac{d}{dt}}\big([\mathbf{x}](\cdot),[\mathbf{v}](\cdot)\big)\f$, after a contraction of
+       *        \f$[\mathbf{x}](\cdot)\f$ or \f$[\mathbf{v}](\cdot)\f$ over \f$[t]\f$ only.
+       *
+       * \pre \f$[\mathbf{x}](\cdot)\f$ and \f$[\mathbf{v}](\cdot)\f$ must share the same dimension, slicing and tdomain.
+       *
+       * \param x the n-dimensional tube \f$[\mathbf{x}](\cdot)\f$
+       * \param v the n-dimensional derivative tube \f$[\mathbf{v}](\cdot)\f$
+       * \param dirty_tdomain the tdomain \f$[t]\f$ over which the tubes have been contracted
+       * \param t_propa an optional temporal way of propagation
+       *                (forward or backward in time, both ways by default)
+       */
+      void contract_incremental(TubeVector& x, const TubeVector& v, const Interval& dirty_tdomain, TimePropag t_propa = TimePropag::FORWARD | TimePropag::BACKWARD);
+
       /**
        * \brief \f$\mathcal{C}_{\frac{d}{dt}}\big(\llbracket x\rrbracket(\cdot),\llbracket v\rrbracket(\cdot)\big)\f$:
        *        contracts the slice \f$\llbracket x\rrbracket(\cdot)\f$ with respect to its derivative \f$\llbracket v\rrbracket(\cdot)\f$.
@@ -85,6 +165,18 @@ namespace codac
 
     protected:
 
+      /**
+       * \brief Fast contraction of a tube (`m_fast_mode`), processing the slices by batches
+       *
+       * \note The gates are propagated first (see `set_parallel_propagation()`); the envelopes and the gates
+       *       depending only on their own slice are then updated by ranges of slices.
+       *
+       * \param x the scalar tube \f$[x](\cdot)\f$
+       * \param v the scalar derivative tube \f$[v](\cdot)\f$
+       * \param t_propa the temporal way of propagation
+       */
+      void contract_fast(Tube& x, const Tube& v, TimePropag t_propa);
+
       /**
        * \brief Contracts input and output gates of a slice regarding its derivative set
        *
@@ -100,6 +192,9 @@ namespace codac
       
       friend class CtcEval; // contract_gates used by CtcEval
 
+      bool m_parallel_propagation = false; //!< if `true`, gates are propagated by parallel prefix scans in fast mode
+      bool m_incremental_mode = false; //!< if `true`, only the contracted parts of the tubes are processed in a CN
+
       static const std::string m_ctc_name; //!< class name (mainly used for CN Exceptions)
       static std::vector<std::string> m_str_expected_doms; //!< allowed domains signatures (mainly used for CN Exceptions)
       friend class ContractorNetwork;
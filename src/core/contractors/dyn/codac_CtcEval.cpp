@@ -9,6 +9,7 @@
  */
 
 #include <list>
+#include <algorithm>
 #include "codac_CtcEval.h"
 #include "codac_CtcDeriv.h"
 #include "codac_Domain.h"
@@ -20,6 +21,29 @@ using namespace ibex;
 
 namespace codac
 {
+  // todo: remove this (or use Polygons with truncation)
+  static void unbound(Tube& y)
+  {
+    // Bounds set to +-BOUNDED_INFINITY before the inversions are set back to infinity
+    for(Slice *s = y.first_slice() ; s != NULL ; s = s->next_slice())
+    {
+      Interval envelope = s->codomain();
+      if(envelope.ub() == BOUNDED_INFINITY) envelope = Interval(envelope.lb(),POS_INFINITY);
+      if(envelope.lb() == -BOUNDED_INFINITY) envelope |= Interval(NEG_INFINITY,envelope.ub());
+      s->set_envelope(envelope);
+
+      Interval ingate = s->input_gate();
+      if(ingate.ub() == BOUNDED_INFINITY) ingate = Interval(ingate.lb(),POS_INFINITY);
+      if(ingate.lb() == -BOUNDED_INFINITY) ingate = Interval(NEG_INFINITY,ingate.ub());
+      s->set_input_gate(ingate);
+
+      Interval outgate = s->output_gate();
+      if(outgate.ub() == BOUNDED_INFINITY) outgate = Interval(outgate.lb(),POS_INFINITY);
+      if(outgate.lb() == -BOUNDED_INFINITY) outgate = Interval(NEG_INFINITY,outgate.ub());
+      s->set_output_gate(outgate);
+    }
+  }
+
   CtcEval::CtcEval()
     : DynCtc(true) // inter-temporal as [t] may involve several times
   {
@@ -123,9 +147,6 @@ namespace codac
 
         y.remove_gate(t);
         w.remove_gate(t);
-
-        y.delete_synthesis_tree(); // todo: update tree if created, instead of delete
-        w.delete_synthesis_tree(); // todo: update tree if created, instead of delete
     }
 
     if(z.is_empty() || y.is_empty())
@@ -190,76 +211,9 @@ namespace codac
         ctc_deriv.restrict_tdomain(m_restricted_tdomain);
         ctc_deriv.set_fast_mode(m_fast_mode);
 
-        Interval front_gate(y.size());
-        list<Interval> l_gates;
-        Slice *s_y;
-        Slice *s_w;
-
-        // 1. Forward propagation
-
-          s_y = y.slice(t.lb());
-          s_w = w.slice(t.lb());
-
-          front_gate = s_y->input_gate() & z;
-            // Mathematically, front_gate should not be empty at this point.
-            // Due to numerical approximations, the computation of t by the invert method
-            // provides a wider enclosure t'. The evaluation of y[t'.lb()] may not
-            // intersect z and so the front_gate becomes empty.
-            // An epsilon inflation could be used to overcome this problem. Or:
-            if(front_gate.is_empty())
-            {
-              if(s_y->input_gate().ub() < z.lb()) front_gate = z.lb();
-              else front_gate = z.ub();
-            }
-
-          l_gates.push_front(front_gate);
+        // 1-2. Forward and backward propagations of the evaluation over [t]
 
-          while(s_y != NULL && s_y->tdomain().lb() < t.ub())
-          {
-            // Forward propagation of the evaluation
-            front_gate += s_y->tdomain().diam() * s_w->codomain(); // projection
-            front_gate |= z; // evaluation
-            front_gate &= s_y->output_gate(); // contraction
-
-            // Storing temporarily fwd propagation 
-            l_gates.push_front(front_gate);
-
-            // Iteration
-            s_y = s_y->next_slice();
-            s_w = s_w->next_slice();
-          }
-
-        // 2. Backward propagation
-
-          s_y = y.slice(ibex::previous_float(t.ub()));
-          s_w = w.slice(ibex::previous_float(t.ub()));
-
-          front_gate = s_y->output_gate() & z;
-            // Overcoming numerical approximations, same remark as before:
-            if(front_gate.is_empty())
-            {
-              if(s_y->output_gate().ub() < z.lb()) front_gate = z.lb();
-              else front_gate = z.ub();
-            }
-
-          s_y->set_output_gate(l_gates.front() | front_gate);
-
-          while(s_y != NULL && s_y->tdomain().lb() >= t.lb())
-          {
-            // Backward propagation of the evaluation
-            front_gate -= s_y->tdomain().diam() * s_w->codomain(); // projection
-            front_gate |= z; // evaluation
-            front_gate &= s_y->input_gate(); // contraction
-
-            // Updating tube
-            l_gates.pop_front();
-            s_y->set_input_gate(l_gates.front() | front_gate);
-            ctc_deriv.contract_gates(*s_y, *s_w);
-
-            // Iteration
-            s_y = s_y->prev_slice();
-            s_w = s_w->prev_slice();
-          }
+          propagate_evaluation(t, z, y, w, ctc_deriv);
 
         // 3. Envelopes contraction
 
@@ -295,31 +249,11 @@ namespace codac
 
               y.remove_gate(v_gates_to_remove[i]);
               w.remove_gate(v_gates_to_remove[i]);
-
-              y.delete_synthesis_tree(); // todo: update tree if created, instead of delete
-              w.delete_synthesis_tree(); // todo: update tree if created, instead of delete
           }
       }
 
       // todo: remove this (or use Polygons with truncation)
-
-        for(Slice *s = y.first_slice() ; s != NULL ; s = s->next_slice())
-        {
-          Interval envelope = s->codomain();
-          if(envelope.ub() == BOUNDED_INFINITY) envelope = Interval(envelope.lb(),POS_INFINITY);
-          if(envelope.lb() == -BOUNDED_INFINITY) envelope |= Interval(NEG_INFINITY,envelope.ub());
-          s->set_envelope(envelope);
-
-          Interval ingate = s->input_gate();
-          if(ingate.ub() == BOUNDED_INFINITY) ingate = Interval(ingate.lb(),POS_INFINITY);
-          if(ingate.lb() == -BOUNDED_INFINITY) ingate = Interval(NEG_INFINITY,ingate.ub());
-          s->set_input_gate(ingate);
-
-          Interval outgate = s->output_gate();
-          if(outgate.ub() == BOUNDED_INFINITY) outgate = Interval(outgate.lb(),POS_INFINITY);
-          if(outgate.lb() == -BOUNDED_INFINITY) outgate = Interval(NEG_INFINITY,outgate.ub());
-          s->set_output_gate(outgate);
-        }
+      unbound(y);
     }
 
     if(t.is_empty() || z.is_empty() || y.is_empty())
@@ -332,6 +266,83 @@ namespace codac
     assert(volume >= y.volume() + w.volume() && "contraction rule not respected");
   }
 
+  void CtcEval::propagate_evaluation(const Interval& t, const Interval& z, Tube& y, Tube& w, CtcDeriv& ctc_deriv)
+  {
+    assert(!t.is_degenerated());
+    assert(y.gate_exists(t.lb()) && y.gate_exists(t.ub()));
+
+    Interval front_gate(y.size());
+    list<Interval> l_gates;
+    Slice *s_y;
+    Slice *s_w;
+
+    // 1. Forward propagation
+
+      s_y = y.slice(t.lb());
+      s_w = w.slice(t.lb());
+
+      front_gate = s_y->input_gate() & z;
+        // Mathematically, front_gate should not be empty at this point.
+        // Due to numerical approximations, the computation of t by the invert method
+        // provides a wider enclosure t'. The evaluation of y[t'.lb()] may not
+        // intersect z and so the front_gate becomes empty.
+        // An epsilon inflation could be used to overcome this problem. Or:
+        if(front_gate.is_empty())
+        {
+          if(s_y->input_gate().ub() < z.lb()) front_gate = z.lb();
+          else front_gate = z.ub();
+        }
+
+      l_gates.push_front(front_gate);
+
+      while(s_y != NULL && s_y->tdomain().lb() < t.ub())
+      {
+        // Forward propagation of the evaluation
+        front_gate += s_y->tdomain().diam() * s_w->codomain(); // projection
+        front_gate |= z; // evaluation
+        front_gate &= s_y->output_gate(); // contraction
+
+        // Storing temporarily fwd propagation 
+        l_gates.push_front(front_gate);
+
+        // Iteration
+        s_y = s_y->next_slice();
+        s_w = s_w->next_slice();
+      }
+
+    // 2. Backward propagation
+
+      s_y = y.slice(ibex::previous_float(t.ub()));
+      s_w = w.slice(ibex::previous_float(t.ub()));
+
+      front_gate = s_y->output_gate() & z;
+        // Overcoming numerical approximations, same remark as before:
+        if(front_gate.is_empty())
+        {
+          if(s_y->output_gate().ub() < z.lb()) front_gate = z.lb();
+          else front_gate = z.ub();
+        }
+
+      s_y->set_output_gate(l_gates.front() | front_gate);
+
+      while(s_y != NULL && s_y->tdomain().lb() >= t.lb())
+      {
+        // Backward propagation of the evaluation
+        front_gate -= s_y->tdomain().diam() * s_w->codomain(); // projection
+        front_gate |= z; // evaluation
+        front_gate &= s_y->input_gate(); // contraction
+
+        // Updating tube
+        l_gates.pop_front();
+        s_y->set_input_gate(l_gates.front() | front_gate);
+        ctc_deriv.contract_gates(*s_y, *s_w);
+
+        // Iteration
+        s_y = s_y->prev_slice();
+        s_w = s_w->prev_slice();
+      }
+  }
+
   void CtcEval::contract(double t, IntervalVector& z, TubeVector& y, TubeVector& w)
   {
     assert(!std::isnan(t));
@@ -429,6 +440,233 @@ namespace codac
     contract(_t, _z, y, w);
   }*/
 
+  void CtcEval::contract(vector<Interval>& v_t, vector<Interval>& v_z, Tube& y, Tube& w)
+  {
+    assert(y.tdomain() == w.tdomain());
+    assert(Tube::same_slicing(y, w));
+    #ifndef NDEBUG
+      double volume = y.volume() + w.volume(); // for last assert
+    #endif
+
+    if(v_t.size() != v_z.size())
+      throw DomainsSizeException(m_ctc_name);
+
+    auto set_empty = [&]()
+    {
+      for(size_t i = 0 ; i < v_t.size() ; i++)
+      {
+        v_t[i].set_empty();
+        v_z[i].set_empty();
+      }
+
+      y.set_empty();
+      w.set_empty();
+    };
+
+    bool empty = y.is_empty() || w.is_empty();
+    for(size_t i = 0 ; i < v_t.size() && !empty ; i++)
+      empty = v_t[i].is_empty() || v_z[i].is_empty();
+
+    if(empty)
+    {
+      set_empty();
+      return;
+    }
+
+    y &= Interval(-BOUNDED_INFINITY,BOUNDED_INFINITY); // todo: remove this
+    w &= Interval(-BOUNDED_INFINITY,BOUNDED_INFINITY); // todo: remove this
+
+    // 1. Evaluations contraction, and values of the gates to be created at the bounds of the [t]s
+
+      vector<pair<double,Interval> > v_gates;
+      v_gates.reserve(2*v_t.size());
+
+      for(size_t i = 0 ; i < v_t.size() ; i++)
+      {
+        v_t[i] &= y.tdomain();
+        if(!v_t[i].is_degenerated())
+          v_t[i] &= y.invert(v_z[i], w, v_t[i]);
+
+        if(!v_t[i].is_empty())
+          v_z[i] &= v_t[i].is_degenerated() ? y.interpol(v_t[i].lb(), w) : y.interpol(v_t[i], w);
+
+        if(v_t[i].is_empty() || v_z[i].is_empty())
+        {
+          set_empty();
+          return;
+        }
+
+        if(v_t[i].is_degenerated())
+          v_gates.push_back(make_pair(v_t[i].lb(), v_z[i]));
+
+        else
+        {
+          v_gates.push_back(make_pair(v_t[i].lb(), y.interpol(v_t[i].lb(), w)));
+          v_gates.push_back(make_pair(v_t[i].ub(), y.interpol(v_t[i].ub(), w)));
+        }
+      }
+
+      sort(v_gates.begin(), v_gates.end(),
+        [](const pair<double,Interval>& a, const pair<double,Interval>& b) { return a.first < b.first; });
+
+    // 2. Sampling of the tubes at all the times, in one pass over the slices
+
+      // As for successive evaluations, the gates of degenerate [t]s
+      // are kept when the propagation is enabled
+      vector<double> v_kept_t;
+      if(m_preserve_slicing && m_propagation_enabled)
+      {
+        for(const auto& t : v_t)
+          if(t.is_degenerated())
+            v_kept_t.push_back(t.lb());
+        sort(v_kept_t.begin(), v_kept_t.end());
+      }
+
+      vector<double> v_gates_t, v_gates_to_remove;
+      v_gates_t.reserve(v_gates.size());
+
+      for(const auto& g : v_gates)
+        if(v_gates_t.empty() || g.first != v_gates_t.back())
+        {
+          v_gates_t.push_back(g.first);
+          if(m_preserve_slicing && !y.gate_exists(g.first) // will exist then
+            && !binary_search(v_kept_t.begin(), v_kept_t.end(), g.first))
+            v_gates_to_remove.push_back(g.first);
+        }
+
+      y.sample(v_gates_t);
+      w.sample(v_gates_t); // w is also sampled to stay compliant with y
+      assert(Tube::same_slicing(y, w));
+
+      for(const auto& g : v_gates)
+        y.set(y(g.first) & g.second, g.first);
+
+    // 3. Propagation of each evaluation over its [t]
+
+      CtcDeriv ctc_deriv;
+      ctc_deriv.restrict_tdomain(m_restricted_tdomain);
+      ctc_deriv.set_fast_mode(m_fast_mode);
+
+      for(size_t i = 0 ; i < v_t.size() ; i++)
+        if(!v_t[i].is_degenerated())
+          propagate_evaluation(v_t[i], v_z[i], y, w, ctc_deriv);
+
+    // 4. Envelopes contraction, one sweep for all the evaluations
+
+      if(m_propagation_enabled)
+        ctc_deriv.contract(y, w);
+
+    // 5. Evaluations contraction
+
+      for(size_t i = 0 ; i < v_t.size() ; i++)
+        if(!v_t[i].is_degenerated())
+        {
+          v_t[i] &= y.invert(v_z[i], w, v_t[i]);
+          if(!v_t[i].is_empty())
+            v_z[i] &= y.interpol(v_t[i], w);
+        }
+
+    // 6. If requested, preserving the initial slicing
+
+      if(!v_gates_to_remove.empty())
+      {
+        // The gates will be lost during the final operation for
+        // preserving the slicing. So we need to propagate locally
+        // the information on nearby slices, to keep the information,
+        // and then merge them.
+
+        CtcDeriv ctc_deriv_local;
+
+        for(const auto& t : v_gates_to_remove)
+        {
+          Slice *s_y = y.slice(t);
+          Slice *s_w = w.slice(t);
+          ctc_deriv_local.contract(*s_y->prev_slice(), *s_w->prev_slice());
+          ctc_deriv_local.contract(*s_y, *s_w);
+        }
+
+        y.remove_gates(v_gates_to_remove);
+        w.remove_gates(v_gates_to_remove);
+      }
+
+    // todo: remove this (or use Polygons with truncation)
+    unbound(y);
+
+    empty = y.is_empty();
+    for(size_t i = 0 ; i < v_t.size() && !empty ; i++)
+      empty = v_t[i].is_empty() || v_z[i].is_empty();
+
+    if(empty)
+    {
+      for(size_t i = 0 ; i < v_t.size() ; i++)
+      {
+        v_t[i].set_empty();
+        v_z[i].set_empty();
+      }
+
+      y.set_empty();
+    }
+
+    assert(volume >= y.volume() + w.volume() && "contraction rule not respected");
+  }
+
+  void CtcEval::contract(vector<Interval>& v_t, vector<IntervalVector>& v_z, TubeVector& y, TubeVector& w)
+  {
+    assert(y.size() == w.size());
+    assert(y.tdomain() == w.tdomain());
+    assert(TubeVector::same_slicing(y, w));
+
+    if(v_t.size() != v_z.size() || y.size() != w.size())
+      throw DomainsSizeException(m_ctc_name);
+
+    for(const auto& z : v_z)
+      if(z.size() != y.size())
+        throw DomainsSizeException(m_ctc_name);
+
+    bool empty = y.is_empty() || w.is_empty();
+    for(size_t j = 0 ; j < v_t.size() && !empty ; j++)
+      empty = v_t[j].is_empty() || v_z[j].is_empty();
+
+    if(empty)
+    {
+      for(size_t j = 0 ; j < v_t.size() ; j++)
+      {
+        v_t[j].set_empty();
+        v_z[j].set_empty();
+      }
+
+      y.set_empty();
+      w.set_empty();
+      return;
+    }
+
+    for(size_t j = 0 ; j < v_t.size() ; j++)
+    {
+      v_t[j] &= y.invert(v_z[j]);
+      v_z[j] &= y(v_t[j]);
+    }
+
+    vector<Interval> v_t_result(v_t.size(), Interval::EMPTY_SET);
+
+    for(int i = 0 ; i < y.size() ; i++)
+    {
+      vector<Interval> v_ti(v_t), v_zi(v_z.size());
+      for(size_t j = 0 ; j < v_z.size() ; j++)
+        v_zi[j] = v_z[j][i];
+
+      contract(v_ti, v_zi, y[i], w[i]);
+
+      for(size_t j = 0 ; j < v_z.size() ; j++)
+      {
+        v_z[j][i] = v_zi[j];
+        v_t_result[j] |= v_ti[j];
+      }
+    }
+
+    for(size_t j = 0 ; j < v_t.size() ; j++)
+      v_t[j] &= v_t_result[j];
+  }
+
   void CtcEval::contract(Interval& t, Interval& z, const Tube& y)
   {
     if(t.is_empty() || z.is_empty() || y.is_empty())
@@ -16,6 +16,8 @@
 
 namespace codac
 {
+  class CtcDeriv;
+
   /**
    * \class CtcEval
    * \brief \f$\mathcal{C}_\textrm{eval}\f$ that contracts a tube \f$[y](\cdot)\f$ with
@@ -102,6 +104,37 @@ namespace codac
        */
       void contract(Interval& t, IntervalVector& z, TubeVector& y, TubeVector& w);
 
+      /**
+       * \brief \f$\mathcal{C}_\textrm{eval}\big([t_i],[z_i],[y](\cdot),[w](\cdot)\big)\f$ for a batch of evaluations:
+       *        contracts the tube \f$[y](\cdot)\f$ and the evaluations \f$[t_i]\times[z_i]\f$.
+       *
+       * \note The tubes are sampled at all the bounds of the \f$[t_i]\f$ in one pass over the slices,
+       *       and the evaluations are propagated by a single forward/backward sweep over the tube,
+       *       instead of one per evaluation. The evaluations do not need to be sorted.
+       * \note The slicing of \f$[y](\cdot)\f$ and \f$[w](\cdot)\f$ may be changed.
+       *
+       * \param v_t the uncertain tdomains \f$[t_i]\f$ of the evaluations
+       * \param v_z the bounded evaluations \f$[z_i]\f$
+       * \param y the scalar tube \f$[y](\cdot)\f$
+       * \param w the scalar derivative tube \f$[w](\cdot)\f$
+       */
+      void contract(std::vector<Interval>& v_t, std::vector<Interval>& v_z, Tube& y, Tube& w);
+
+      /**
+       * \brief \f$\mathcal{C}_\textrm{eval}\big([t_i],[\mathbf{z}_i],[\mathbf{y}](\cdot),[\mathbf{w}](\cdot)\big)\f$ for a batch of evaluations:
+       *        contracts the tube \f$[\mathbf{y}](\cdot)\f$ and the evaluations \f$[t_i]\times[\mathbf{z}_i]\f$.
+       *
+       * \note The components are contracted one after the other, each with a single sweep
+       *       (see the scalar case).
+       * \note The slicing of \f$[\mathbf{y}](\cdot)\f$ and \f$[\mathbf{w}](\cdot)\f$ may be changed.
+       *
+       * \param v_t the uncertain tdomains \f$[t_i]\f$ of the evaluations
+       * \param v_z the bounded evaluations \f$[\mathbf{z}_i]\f$
+       * \param y the n-dimensional tube \f$[\mathbf{y}](\cdot)\f$
+       * \param w the n-dimensional derivative tube \f$[\mathbf{w}](\cdot)\f$
+       */
+      void contract(std::vector<Interval>& v_t, std::vector<IntervalVector>& v_z, TubeVector& y, TubeVector& w);
+
       /**
        * \brief \f$\mathcal{C}_\textrm{eval}\big([t],[z],[y](\cdot)\big)\f$:
        *        contracts the evaluation \f$[t]\times[z]\f$ only.
@@ -124,6 +157,20 @@ namespace codac
 
     protected:
 
+      /**
+       * \brief Propagates an evaluation \f$[t]\times[z]\f$ forward and backward
+       *        over the gates of the slices covering \f$[t]\f$
+       *
+       * \pre \f$[y](\cdot)\f$ and \f$[w](\cdot)\f$ must be sampled at \f$t^-\f$ and \f$t^+\f$.
+       *
+       * \param t the uncertain tdomain \f$[t]\f$ of the evaluation (not degenerated)
+       * \param z the bounded evaluation \f$[z]\f$
+       * \param y the scalar tube \f$[y](\cdot)\f$
+       * \param w the scalar derivative tube \f$[w](\cdot)\f$
+       * \param ctc_deriv the \f$\mathcal{C}_{\frac{d}{dt}}\f$ contractor used on the gates
+       */
+      void propagate_evaluation(const Interval& t, const Interval& z, Tube& y, Tube& w, CtcDeriv& ctc_deriv);
+
       bool m_propagation_enabled = true; //!< if `true`, a complete temporal propagation will be performed
 
       static const std::string m_ctc_name; //!< class name (mainly used for CN Exceptions)
@@ -26,6 +26,11 @@ namespace codac
 
   }
 
+  void DynCtc::contract_incremental(vector<Domain*>& v_domains, const Interval& dirty_tdomain)
+  {
+    contract(v_domains);
+  }
+
   void DynCtc::preserve_slicing(bool preserve)
   {
     m_preserve_slicing = preserve;
@@ -45,4 +50,9 @@ namespace codac
   {
     return m_intertemporal;
   }
+
+  bool DynCtc::is_incremental() const
+  {
+    return false;
+  }
 }
\ No newline at end of file
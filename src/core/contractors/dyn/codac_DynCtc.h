@@ -83,6 +83,18 @@ namespace codac
        */
       virtual void contract(std::vector<Domain*>& v_domains) = 0;
 
+      /*
+       * \brief Contracts a set of abstract domains that have been contracted
+       *        over a part of their tdomain only, since the last call
+       *
+       * This method is called by the CN for incremental contractors (see `is_incremental()`).
+       * By default, the domains are entirely contracted.
+       *
+       * \param v_domains vector of Domain pointers
+       * \param dirty_tdomain union of the tdomains over which the domains have been contracted
+       */
+      virtual void contract_incremental(std::vector<Domain*>& v_domains, const Interval& dirty_tdomain);
+
       /**
        * \brief Specifies whether the contractor can impact the tube's slicing or not
        *
@@ -113,6 +125,14 @@ namespace codac
        */
       bool is_intertemporal() const;
 
+      /**
+       * \brief Tests if the contractor can be limited to the parts of the domains
+       *        that have been contracted since its last call
+       *
+       * \return `true` if the CN has to call `contract_incremental()`
+       */
+      virtual bool is_incremental() const;
+
     protected:
 
       bool m_preserve_slicing = true; //!< if `true`, tube's slicing will not be affected by the contractor
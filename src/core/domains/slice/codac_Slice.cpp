@@ -22,11 +22,10 @@ namespace codac
     // Definition
 
     Slice::Slice(const Interval& tdomain, const Interval& codomain)
-      : m_tdomain(tdomain), m_codomain(codomain)
+      : m_own_storage(true)
     {
       assert(valid_tdomain(tdomain));
-      m_input_gate = new Interval(codomain);
-      m_output_gate = new Interval(codomain);
+      m_storage = new SlicesStorage(this, tdomain, codomain);
     }
 
     Slice::Slice(const Slice& x)
@@ -37,13 +36,13 @@ namespace codac
 
     Slice::~Slice()
     {
-      // Links to other slices are destroyed
-      if(m_prev_slice != NULL) m_prev_slice->m_next_slice = NULL;
-      if(m_next_slice != NULL) m_next_slice->m_prev_slice = NULL;
-
-      // Gates are deleted if not shared with other slices
-      if(m_prev_slice == NULL) delete m_input_gate;
-      if(m_next_slice == NULL) delete m_output_gate;
+      // The values of a tube's slice belong to the tube:
+      // only the storage of a standalone slice is deleted here
+      if(m_own_storage)
+      {
+        m_storage->m_v_slices.clear();
+        delete m_storage;
+      }
     }
 
     int Slice::size() const
@@ -53,10 +52,14 @@ namespace codac
 
     const Slice& Slice::operator=(const Slice& x)
     {
-      m_tdomain = x.m_tdomain;
-      m_codomain = x.m_codomain;
-      *m_input_gate = *x.m_input_gate;
-      *m_output_gate = *x.m_output_gate;
+      if(m_storage->records_updates()
+        && (codomain() != x.codomain() || input_gate() != x.input_gate() || output_gate() != x.output_gate()))
+        m_storage->add_dirty_tdomain(tdomain() | x.tdomain());
+
+      set_tdomain(x.tdomain());
+      m_storage->m_v_codomains[m_id] = x.codomain();
+      m_storage->m_v_gates[m_id] = x.input_gate();
+      m_storage->m_v_gates[m_id+1] = x.output_gate();
       
       if(m_synthesis_reference != NULL)
       {
@@ -69,7 +72,7 @@ namespace codac
     
     const Interval Slice::tdomain() const
     {
-      return m_tdomain;
+      return Interval(m_storage->m_v_t[m_id], m_storage->m_v_t[m_id+1]);
     }
 
     // Slices structure
@@ -81,7 +84,7 @@ namespace codac
 
     const Slice* Slice::prev_slice() const
     {
-      return m_prev_slice;
+      return m_id > 0 ? m_storage->m_v_slices[m_id-1] : NULL;
     }
 
     Slice* Slice::next_slice()
@@ -91,31 +94,31 @@ namespace codac
 
     const Slice* Slice::next_slice() const
     {
-      return m_next_slice;
+      return m_id + 1 < m_storage->nb_slices() ? m_storage->m_v_slices[m_id+1] : NULL;
     }
 
     const Interval Slice::input_gate() const
     {
-      return *m_input_gate;
+      return m_storage->m_v_gates[m_id];
     }
     
     const Interval Slice::output_gate() const
     {
-      return *m_output_gate;
+      return m_storage->m_v_gates[m_id+1];
     }
     
     // Accessing values
 
     const Interval Slice::codomain() const
     {
-      return m_codomain;
+      return m_storage->m_v_codomains[m_id];
     }
     
     const IntervalVector Slice::box() const
     {
       IntervalVector box(2);
       box[0] = tdomain();
-      box[1] = m_codomain;
+      box[1] = codomain();
       return box;
     }
     
@@ -133,12 +136,12 @@ namespace codac
     
     double Slice::diam() const
     {
-      return diam(m_codomain);
+      return diam(codomain());
     }
     
     double Slice::volume() const
     {
-      return m_tdomain.diam() * diam(m_codomain);
+      return tdomain().diam() * diam(codomain());
     }
 
     const Interval Slice::operator()(double t) const
@@ -149,13 +152,13 @@ namespace codac
       if(!tdomain().contains(t))
         return Interval::all_reals();
 
-      else if(t == m_tdomain.lb())
+      else if(t == tdomain().lb())
         return input_gate();
 
-      else if(t == m_tdomain.ub())
+      else if(t == tdomain().ub())
         return output_gate();
 
-      return m_codomain;
+      return codomain();
     }
 
     const Interval Slice::operator()(const Interval& t) const
@@ -170,7 +173,7 @@ namespace codac
         return (*this)(t.lb());
 
       else
-        return m_codomain;
+        return codomain();
     }
 
     const pair<Interval,Interval> Slice::eval(const Interval& t) const
@@ -195,10 +198,10 @@ namespace codac
         p_eval.second |= output_gate().ub();
       }
 
-      if(t.is_subset(tdomain()) && t != m_tdomain.lb() && t != m_tdomain.ub())
+      if(t.is_subset(tdomain()) && t != tdomain().lb() && t != tdomain().ub())
       {
-        p_eval.first |= m_codomain.lb();
-        p_eval.second |= m_codomain.ub();
+        p_eval.first |= codomain().lb();
+        p_eval.second |= codomain().ub();
       }
 
       return p_eval;
@@ -225,8 +228,8 @@ namespace codac
         return codomain();
 
       else if(t.is_degenerated())
-        return (output_gate() - (m_tdomain.ub() - t) * v.codomain())
-             & (input_gate() + (t - m_tdomain.lb()) * v.codomain());
+        return (output_gate() - (tdomain().ub() - t) * v.codomain())
+             & (input_gate() + (t - tdomain().lb()) * v.codomain());
 
       else
       {
@@ -246,29 +249,29 @@ namespace codac
       else if(search_tdomain.lb() < tdomain().lb() || search_tdomain.ub() > tdomain().ub())
         return Interval::all_reals();
 
-      else if((m_tdomain & search_tdomain) == m_tdomain && m_codomain.is_subset(y))
-        return m_tdomain;
+      else if((tdomain() & search_tdomain) == tdomain() && codomain().is_subset(y))
+        return tdomain();
 
-      else if(search_tdomain == m_tdomain.lb())
+      else if(search_tdomain == tdomain().lb())
       {
         if(y.intersects(input_gate()))
-          return m_tdomain.lb();
+          return tdomain().lb();
         else
           return Interval::EMPTY_SET;
       }
 
-      else if(search_tdomain == m_tdomain.ub())
+      else if(search_tdomain == tdomain().ub())
       {
         if(y.intersects(output_gate()))
-          return m_tdomain.ub();
+          return tdomain().ub();
         else
           return Interval::EMPTY_SET;
       }
 
       else
       {
-        if(y.intersects(m_codomain))
-          return search_tdomain & m_tdomain;
+        if(y.intersects(codomain()))
+          return search_tdomain & tdomain();
         else
           return Interval::EMPTY_SET;
       }
@@ -285,29 +288,29 @@ namespace codac
       else if(search_tdomain.lb() < tdomain().lb() || search_tdomain.ub() > tdomain().ub())
         return Interval::all_reals();
 
-      else if((m_tdomain & search_tdomain) == m_tdomain && m_codomain.is_subset(y))
-        return m_tdomain;
+      else if((tdomain() & search_tdomain) == tdomain() && codomain().is_subset(y))
+        return tdomain();
 
-      else if(search_tdomain == m_tdomain.lb())
+      else if(search_tdomain == tdomain().lb())
       {
         if(y.intersects(input_gate()))
-          return m_tdomain.lb();
+          return tdomain().lb();
         else
           return Interval::EMPTY_SET;
       }
 
-      else if(search_tdomain == m_tdomain.ub())
+      else if(search_tdomain == tdomain().ub())
       {
         if(y.intersects(output_gate()))
-          return m_tdomain.ub();
+          return tdomain().ub();
         else
           return Interval::EMPTY_SET;
       }
 
       else if(v.codomain() == Interval::all_reals())
       {
-        if(y.intersects(m_codomain))
-          return search_tdomain & m_tdomain;
+        if(y.intersects(codomain()))
+          return search_tdomain & tdomain();
         else
           return Interval::EMPTY_SET;
       }
@@ -379,19 +382,19 @@ namespace codac
     
     bool Slice::is_empty() const
     {
-      return m_codomain.is_empty() || input_gate().is_empty() || output_gate().is_empty();
+      return codomain().is_empty() || input_gate().is_empty() || output_gate().is_empty();
     }
 
     const BoolInterval Slice::contains(const Trajectory& x) const
     {
       assert(tdomain().is_subset(x.tdomain()));
 
-      Interval traj_tdomain = x(m_tdomain);
+      Interval traj_tdomain = x(tdomain());
       // We use x(Interval(double)) for reliable evaluation:
-      Interval traj_input = x(Interval(m_tdomain.lb()));
-      Interval traj_output = x(Interval(m_tdomain.ub()));
+      Interval traj_input = x(Interval(tdomain().lb()));
+      Interval traj_output = x(Interval(tdomain().ub()));
 
-      if(!traj_tdomain.intersects(m_codomain)
+      if(!traj_tdomain.intersects(codomain())
       || !traj_input.intersects(input_gate())
       || !traj_output.intersects(output_gate()))
         return NO;
@@ -401,15 +404,15 @@ namespace codac
         if(!traj_input.is_subset(input_gate()) || !traj_output.is_subset(output_gate()))
           return MAYBE;
 
-        else if(traj_tdomain.is_subset(m_codomain))
+        else if(traj_tdomain.is_subset(codomain()))
           return YES;
 
-        else // too much pessimism for the trajectory evaluation on m_tdomain
+        else // too much pessimism for the trajectory evaluation on tdomain()
         {
           // Bisections are performed to reach an accurate evaluation
 
           list<Interval> s_subtdomains;
-          s_subtdomains.push_front(m_tdomain);
+          s_subtdomains.push_front(tdomain());
 
           while(!s_subtdomains.empty())
           {
@@ -418,12 +421,12 @@ namespace codac
 
             Interval thinner_eval = x(t);
 
-            if(!thinner_eval.intersects(m_codomain))
+            if(!thinner_eval.intersects(codomain()))
             {
               return NO;
             }
 
-            else if(!thinner_eval.is_subset(m_codomain))
+            else if(!thinner_eval.is_subset(codomain()))
             {
               if(t.diam() < EPSILON_CONTAINS)
                 return MAYBE;
@@ -442,15 +445,28 @@ namespace codac
 
     void Slice::set(const Interval& y)
     {
-      m_codomain = y;
+      // The previous values are only kept if the updates are recorded
+      const bool record = m_storage->records_updates();
+      Interval prev_envelope, prev_input_gate, prev_output_gate;
+      if(record)
+      {
+        prev_envelope = codomain();
+        prev_input_gate = input_gate();
+        prev_output_gate = output_gate();
+      }
+
+      m_storage->m_v_codomains[m_id] = y;
 
-      *m_input_gate = y;
+      m_storage->m_v_gates[m_id] = y;
       if(prev_slice() != NULL)
-        *m_input_gate &= prev_slice()->codomain();
+        m_storage->m_v_gates[m_id] &= prev_slice()->codomain();
 
-      *m_output_gate = y;
+      m_storage->m_v_gates[m_id+1] = y;
       if(next_slice() != NULL)
-        *m_output_gate &= next_slice()->codomain();
+        m_storage->m_v_gates[m_id+1] &= next_slice()->codomain();
+
+      if(record && (codomain() != prev_envelope || input_gate() != prev_input_gate || output_gate() != prev_output_gate))
+        m_storage->add_dirty_tdomain(tdomain());
 
       if(m_synthesis_reference != NULL)
       {
@@ -466,14 +482,27 @@ namespace codac
 
     void Slice::set_envelope(const Interval& envelope, bool slice_consistency)
     {
-      m_codomain = envelope;
+      // The previous values are only kept if the updates are recorded
+      const bool record = m_storage->records_updates();
+      Interval prev_envelope, prev_input_gate, prev_output_gate;
+      if(record)
+      {
+        prev_envelope = codomain();
+        prev_input_gate = input_gate();
+        prev_output_gate = output_gate();
+      }
+
+      m_storage->m_v_codomains[m_id] = envelope;
 
       if(slice_consistency)
       {
-        *m_input_gate &= m_codomain;
-        *m_output_gate &= m_codomain;
+        m_storage->m_v_gates[m_id] &= envelope;
+        m_storage->m_v_gates[m_id+1] &= envelope;
       }
 
+      if(record && (codomain() != prev_envelope || input_gate() != prev_input_gate || output_gate() != prev_output_gate))
+        m_storage->add_dirty_tdomain(tdomain());
+
       if(m_synthesis_reference != NULL)
       {
         m_synthesis_reference->request_values_update();
@@ -483,15 +512,23 @@ namespace codac
 
     void Slice::set_input_gate(const Interval& input_gate, bool slice_consistency)
     {
-      *m_input_gate = input_gate;
+      const bool record = m_storage->records_updates();
+      Interval prev_input_gate;
+      if(record)
+        prev_input_gate = this->input_gate();
+
+      m_storage->m_v_gates[m_id] = input_gate;
 
       if(slice_consistency)
       {
-        *m_input_gate &= m_codomain;
+        m_storage->m_v_gates[m_id] &= codomain();
         if(prev_slice() != NULL)
-          *m_input_gate &= prev_slice()->codomain();
+          m_storage->m_v_gates[m_id] &= prev_slice()->codomain();
       }
 
+      if(record && this->input_gate() != prev_input_gate)
+        m_storage->add_dirty_tdomain(Interval(tdomain().lb()));
+
       if(m_synthesis_reference != NULL)
       {
         m_synthesis_reference->request_values_update();
@@ -501,15 +538,23 @@ namespace codac
 
     void Slice::set_output_gate(const Interval& output_gate, bool slice_consistency)
     {
-      *m_output_gate = output_gate;
+      const bool record = m_storage->records_updates();
+      Interval prev_output_gate;
+      if(record)
+        prev_output_gate = this->output_gate();
+
+      m_storage->m_v_gates[m_id+1] = output_gate;
 
       if(slice_consistency)
       {
-        *m_output_gate &= m_codomain;
+        m_storage->m_v_gates[m_id+1] &= codomain();
         if(next_slice() != NULL)
-          *m_output_gate &= next_slice()->codomain();
+          m_storage->m_v_gates[m_id+1] &= next_slice()->codomain();
       }
 
+      if(record && this->output_gate() != prev_output_gate)
+        m_storage->add_dirty_tdomain(Interval(tdomain().ub()));
+
       if(m_synthesis_reference != NULL)
       {
         m_synthesis_reference->request_values_update();
@@ -522,9 +567,9 @@ namespace codac
       assert(rad >= 0.);
       
       Interval e(-rad,rad);
-      set_envelope(m_codomain + e);
-      set_input_gate(*m_input_gate + e);
-      set_output_gate(*m_output_gate + e);
+      set_envelope(codomain() + e);
+      set_input_gate(input_gate() + e);
+      set_output_gate(output_gate() + e);
       
       return *this;
     }
@@ -539,78 +584,27 @@ namespace codac
 
 
   // Protected methods
-    
-    void Slice::set_tdomain(const Interval& tdomain)
-    {
-      assert(valid_tdomain(tdomain));
-      m_tdomain = tdomain;
-    }
-
-    void Slice::shift_tdomain(double shift_ref)
-    {
-      set_tdomain(m_tdomain + shift_ref);
 
-      if(m_synthesis_reference != NULL)
-      {
-        // todo: update tdomain structure
-      }
-    }
-
-    // Slices structure
-
-    void Slice::chain_slices(Slice *first_slice, Slice *second_slice)
+    Slice::Slice(SlicesStorage *storage, int k)
+      : m_storage(storage), m_id(k)
     {
-      if(first_slice != NULL)
-        first_slice->m_next_slice = second_slice;
-
-      if(second_slice != NULL)
-        second_slice->m_prev_slice = first_slice;
-
-      if(first_slice != NULL && second_slice != NULL)
-      {
-        if(second_slice->m_input_gate != NULL)
-        {
-          *first_slice->m_output_gate &= *second_slice->m_input_gate;
-          // todo: memory leak there? second_slice->m_input_gate should be deleted
-        }
-        second_slice->m_input_gate = first_slice->m_output_gate;
-      }
+      assert(storage != NULL);
     }
-
-    void Slice::merge_slices(Slice *first_slice, Slice *&second_slice)
+    
+    void Slice::set_tdomain(const Interval& tdomain)
     {
-      assert(first_slice != NULL && second_slice != NULL);
-      assert(first_slice->next_slice() == second_slice);
-      assert(first_slice->tdomain().ub() == second_slice->tdomain().lb());
-      assert(first_slice->m_output_gate == second_slice->m_input_gate);
-
-      Slice *next_slice_after_merge = second_slice->next_slice(); // may be NULL
-
-      first_slice->set_envelope(first_slice->codomain() | second_slice->codomain());
-      first_slice->set_tdomain(first_slice->tdomain() | second_slice->tdomain());
-
-      // Deleting objects after fusion
-      first_slice->m_output_gate = new Interval(second_slice->output_gate());
-
-      second_slice->m_prev_slice = NULL;
-      second_slice->m_next_slice = NULL;
-      delete second_slice; // will destroy both input/output gates because
-                           // pointers to neighbor slices have been set to NULL
-
-      // Chaining slices
-      first_slice->m_next_slice = next_slice_after_merge;
-      if(next_slice_after_merge != NULL)
-      {
-        next_slice_after_merge->m_prev_slice = first_slice;
-        next_slice_after_merge->m_input_gate = first_slice->m_output_gate;
-      }
+      assert(valid_tdomain(tdomain));
+      if(m_storage->records_updates() && tdomain != this->tdomain())
+        m_storage->add_dirty_tdomain(tdomain);
+      m_storage->m_v_t[m_id] = tdomain.lb();
+      m_storage->m_v_t[m_id+1] = tdomain.ub();
     }
 
     // Access values
 
     const IntervalVector Slice::codomain_box() const
     {
-      return IntervalVector(m_codomain);
+      return IntervalVector(codomain());
     }
 
     // Setting values
@@ -18,6 +18,7 @@
 #include "codac_ConvexPolygon.h"
 #include "codac_TubeTreeSynthesis.h"
 #include "codac_BoolInterval.h"
+#include "codac_SlicesStorage.h"
 
 namespace codac
 {
@@ -618,42 +619,23 @@ namespace codac
     protected:
 
       /**
-       * \brief Specifies the temporal domain \f$[t_0,t_f]\f$ of this slice
-       *
-       * \note Method necessary for Tube::sample()
+       * \brief Creates a view on the kth slice of a SlicesStorage
        *
-       * \param tdomain the new temporal domain to be set
-       */
-      void set_tdomain(const Interval& tdomain);
-
-      /**
-       * \brief Shifts the tdomain \f$[t_0,t_f]\f$ of \f$\llbracket x\rrbracket(\cdot)\f$
+       * \note Constructor used by SlicesStorage for the slices of a tube
        *
-       * \param a the offset value so that \f$[t^k_0,t^k_f]:=[t^k_0+a,t^k_f+a]\f$ 
+       * \param storage the storage of the slices values
+       * \param k the index of the slice in the storage
        */
-      void shift_tdomain(double a);
+      explicit Slice(SlicesStorage *storage, int k);
 
       /**
-       * \brief Chains the two slices so that they share pointers and a common gate
-       *
-       * \note Links to other slices will be lost
-       *
-       * \param first_slice a pointer to the first Slice object
-       * \param second_slice a pointer to the second Slice object
-       * \return void
-       */
-      static void chain_slices(Slice *first_slice, Slice *second_slice);
-
-      /**
-       * \brief Merges the two slices to keep only one
+       * \brief Specifies the temporal domain \f$[t_0,t_f]\f$ of this slice
        *
-       * \note One slice object and gate will be removed during the operation.
+       * \note The time bounds are shared with the neighbor slices, if any
        *
-       * \param first_slice a pointer to the first Slice object
-       * \param second_slice a pointer to the second Slice object
-       * \return void
+       * \param tdomain the new temporal domain to be set
        */
-      static void merge_slices(Slice *first_slice, Slice *&second_slice);
+      void set_tdomain(const Interval& tdomain);
 
       /**
        * \brief Returns the box \f$\llbracket x\rrbracket([t_0,t_f])\f$
@@ -666,15 +648,16 @@ namespace codac
 
       // Class variables:
 
-        Interval m_tdomain; //!< temporal domain \f$[t_0,t_f]\f$ of the slice
-        Interval m_codomain = Interval::ALL_REALS; //!< envelope of the slice
-        Interval *m_input_gate = NULL, *m_output_gate = NULL; //!< input and output gates
-        Slice *m_prev_slice = NULL, *m_next_slice = NULL; //!< pointers to previous and next slices of the related tube
+        SlicesStorage *m_storage = NULL; //!< pointer to the values of the slice (shared with the slices of the related tube)
+        int m_id = 0; //!< index of the slice in m_storage
+        bool m_own_storage = false; //!< true if m_storage is owned by this slice (slice not belonging to a tube)
         mutable TubeTreeSynthesis *m_synthesis_reference = NULL; //!< pointer to a leaf of the optional synthesis tree of the related tube
 
       friend class Tube;
+      friend class SlicesStorage;
       friend class TubeTreeSynthesis;
       friend class CtcEval;
+      friend class ContractorNetwork;
       friend void deserialize_Tube(std::ifstream& bin_file, Tube *&tube);
   };
 }
@@ -0,0 +1,368 @@
+/** 
+ *  SlicesStorage class
+ * ----------------------------------------------------------------------------
+ *  \date       2021
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <algorithm>
+#include "codac_SlicesStorage.h"
+#include "codac_Slice.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace codac
+{
+  // Public methods
+
+    // Definition
+
+    SlicesStorage::SlicesStorage(const Interval& tdomain, const Interval& codomain)
+      : SlicesStorage(vector<double>({ tdomain.lb(), tdomain.ub() }), codomain)
+    {
+
+    }
+
+    SlicesStorage::SlicesStorage(const vector<double>& v_t, const Interval& codomain)
+      : m_v_t(v_t), m_v_codomains(v_t.size() - 1, codomain), m_v_gates(v_t.size(), codomain)
+    {
+      assert(v_t.size() > 1);
+
+      m_v_slices.reserve(nb_slices());
+      for(int k = 0 ; k < nb_slices() ; k++)
+        m_v_slices.push_back(new Slice(this, k));
+    }
+
+    SlicesStorage::SlicesStorage(const SlicesStorage& x)
+      : m_v_t(x.m_v_t), m_v_codomains(x.m_v_codomains), m_v_gates(x.m_v_gates)
+    {
+      m_v_slices.reserve(nb_slices());
+      for(int k = 0 ; k < nb_slices() ; k++)
+        m_v_slices.push_back(new Slice(this, k));
+    }
+
+    SlicesStorage::~SlicesStorage()
+    {
+      for(auto& s : m_v_slices)
+        delete s;
+    }
+
+    int SlicesStorage::nb_slices() const
+    {
+      return m_v_codomains.size();
+    }
+
+    const Interval SlicesStorage::tdomain() const
+    {
+      return Interval(m_v_t.front(), m_v_t.back());
+    }
+
+    Slice* SlicesStorage::slice(int k)
+    {
+      return const_cast<Slice*>(static_cast<const SlicesStorage&>(*this).slice(k));
+    }
+
+    const Slice* SlicesStorage::slice(int k) const
+    {
+      assert(k >= 0 && k < nb_slices());
+      return m_v_slices[k];
+    }
+
+    int SlicesStorage::time_to_index(double t) const
+    {
+      assert(tdomain().contains(t));
+      int k = upper_bound(m_v_t.begin(), m_v_t.end(), t) - m_v_t.begin() - 1;
+      return std::min(k, nb_slices() - 1); // t_n belongs to the last slice
+    }
+
+    const vector<double>& SlicesStorage::t_bounds() const
+    {
+      return m_v_t;
+    }
+
+    const vector<Interval>& SlicesStorage::codomains() const
+    {
+      return m_v_codomains;
+    }
+
+    const vector<Interval>& SlicesStorage::gates() const
+    {
+      return m_v_gates;
+    }
+
+    const Interval SlicesStorage::dirty_tdomain(shared_ptr<DirtyTDomain>& tracker)
+    {
+      if(!tracker || find_if(m_v_trackers.begin(), m_v_trackers.end(),
+        [&tracker](const weak_ptr<DirtyTDomain>& w) { return w.lock() == tracker; }) == m_v_trackers.end())
+      {
+        // The trackers of deleted callers are removed on registration
+        m_v_trackers.erase(remove_if(m_v_trackers.begin(), m_v_trackers.end(),
+          [](const weak_ptr<DirtyTDomain>& w) { return w.expired(); }), m_v_trackers.end());
+
+        tracker = make_shared<DirtyTDomain>();
+        m_v_trackers.push_back(tracker);
+        return Interval::ALL_REALS; // previous updates are unknown
+      }
+
+      double lb = tracker->lb.exchange(POS_INFINITY);
+      double ub = tracker->ub.exchange(NEG_INFINITY);
+      return lb > ub ? Interval::EMPTY_SET : Interval(lb, ub);
+    }
+
+
+  // Protected methods
+
+    SlicesStorage::SlicesStorage(Slice *owner, const Interval& tdomain, const Interval& codomain)
+      : m_v_t({ tdomain.lb(), tdomain.ub() }), m_v_codomains(1, codomain), m_v_gates(2, codomain),
+        m_v_slices(1, owner)
+    {
+      assert(owner != NULL);
+    }
+
+    void SlicesStorage::sample(int k, double t)
+    {
+      assert(k >= 0 && k < nb_slices());
+      assert(m_v_t[k] < t && t < m_v_t[k+1]);
+
+      // The new gate is not consistent yet with the two new slices
+      add_dirty_tdomain(Interval(m_v_t[k], m_v_t[k+1]));
+
+      m_v_t.insert(m_v_t.begin() + k + 1, t);
+      m_v_gates.insert(m_v_gates.begin() + k + 1, m_v_codomains[k]);
+      m_v_codomains.insert(m_v_codomains.begin() + k + 1, m_v_codomains[k]);
+      m_v_slices.insert(m_v_slices.begin() + k + 1, new Slice(this, k + 1));
+      update_views_ids(k + 2);
+    }
+
+    void SlicesStorage::sample(const vector<double>& v_t)
+    {
+      assert(is_sorted(v_t.begin(), v_t.end()));
+
+      vector<double> v_new_t;
+      vector<Interval> v_new_codomains, v_new_gates;
+      vector<Slice*> v_new_slices;
+      Interval dirty_t = Interval::EMPTY_SET; // hull of the sampled slices
+      v_new_t.reserve(m_v_t.size() + v_t.size());
+      v_new_gates.reserve(m_v_gates.size() + v_t.size());
+      v_new_codomains.reserve(m_v_codomains.size() + v_t.size());
+      v_new_slices.reserve(m_v_slices.size() + v_t.size());
+
+      size_t i = 0;
+      for(int k = 0 ; k < nb_slices() ; k++)
+      {
+        v_new_t.push_back(m_v_t[k]);
+        v_new_gates.push_back(m_v_gates[k]);
+        v_new_codomains.push_back(m_v_codomains[k]);
+        v_new_slices.push_back(m_v_slices[k]);
+
+        for( ; i < v_t.size() && v_t[i] < m_v_t[k+1] ; i++)
+          if(v_t[i] > v_new_t.back()) // existing gates and duplicates are ignored
+          {
+            dirty_t |= Interval(m_v_t[k], m_v_t[k+1]);
+            v_new_t.push_back(v_t[i]);
+            v_new_gates.push_back(m_v_codomains[k]);
+            v_new_codomains.push_back(m_v_codomains[k]);
+            v_new_slices.push_back(new Slice(this, 0));
+          }
+      }
+
+      v_new_t.push_back(m_v_t.back());
+      v_new_gates.push_back(m_v_gates.back());
+
+      m_v_t.swap(v_new_t);
+      m_v_gates.swap(v_new_gates);
+      m_v_codomains.swap(v_new_codomains);
+      m_v_slices.swap(v_new_slices);
+      update_views_ids();
+
+      if(!dirty_t.is_empty())
+        add_dirty_tdomain(dirty_t);
+    }
+
+    void SlicesStorage::push_back(double t, const Interval& codomain)
+    {
+      assert(t > m_v_t.back());
+
+      add_dirty_tdomain(Interval(m_v_t.back(), t));
+      m_v_t.push_back(t);
+      m_v_codomains.push_back(codomain);
+      m_v_gates.push_back(codomain);
+      m_v_slices.push_back(new Slice(this, nb_slices() - 1));
+    }
+
+    void SlicesStorage::merge(int k)
+    {
+      assert(k >= 0 && k < nb_slices() - 1);
+
+      add_dirty_tdomain(Interval(m_v_t[k], m_v_t[k+2]));
+      m_v_codomains[k] |= m_v_codomains[k+1];
+      m_v_gates[k] &= m_v_codomains[k];
+
+      m_v_t.erase(m_v_t.begin() + k + 1);
+      m_v_gates.erase(m_v_gates.begin() + k + 1);
+      m_v_codomains.erase(m_v_codomains.begin() + k + 1);
+      delete m_v_slices[k+1];
+      m_v_slices.erase(m_v_slices.begin() + k + 1);
+      update_views_ids(k + 1);
+    }
+
+    void SlicesStorage::merge(const vector<int>& v_k)
+    {
+      assert(is_sorted(v_k.begin(), v_k.end()));
+
+      if(v_k.empty())
+        return;
+
+      size_t i = 0;
+      int j = 0; // index of the current merged slice
+      vector<char> v_merged(nb_slices(), false);
+
+      for(int k = 1 ; k < nb_slices() ; k++)
+      {
+        while(i < v_k.size() && v_k[i] < k-1)
+          i++;
+
+        if(i < v_k.size() && v_k[i] == k-1) // the gate k is removed
+        {
+          m_v_codomains[j] |= m_v_codomains[k];
+          v_merged[j] = true;
+          delete m_v_slices[k];
+        }
+
+        else
+        {
+          j++;
+          m_v_t[j] = m_v_t[k];
+          m_v_gates[j] = m_v_gates[k];
+          m_v_codomains[j] = m_v_codomains[k];
+          m_v_slices[j] = m_v_slices[k];
+        }
+      }
+
+      m_v_t[j+1] = m_v_t.back();
+      m_v_gates[j+1] = m_v_gates.back();
+
+      Interval dirty_t = Interval::EMPTY_SET; // hull of the merged slices
+      for(int k = 0 ; k <= j ; k++)
+        if(v_merged[k])
+        {
+          m_v_gates[k] &= m_v_codomains[k];
+          dirty_t |= Interval(m_v_t[k], m_v_t[k+1]);
+        }
+
+      m_v_t.resize(j+2);
+      m_v_gates.resize(j+2);
+      m_v_codomains.resize(j+1);
+      m_v_slices.resize(j+1);
+      update_views_ids();
+
+      if(!dirty_t.is_empty())
+        add_dirty_tdomain(dirty_t);
+    }
+
+    void SlicesStorage::truncate(int k0, int kf)
+    {
+      assert(k0 >= 0 && k0 <= kf && kf < nb_slices());
+
+      for(int k = 0 ; k < nb_slices() ; k++)
+        if(k < k0 || k > kf)
+          delete m_v_slices[k];
+
+      // Slices after kf
+      m_v_t.erase(m_v_t.begin() + kf + 2, m_v_t.end());
+      m_v_gates.erase(m_v_gates.begin() + kf + 2, m_v_gates.end());
+      m_v_codomains.erase(m_v_codomains.begin() + kf + 1, m_v_codomains.end());
+      m_v_slices.erase(m_v_slices.begin() + kf + 1, m_v_slices.end());
+
+      // Slices before k0
+      m_v_t.erase(m_v_t.begin(), m_v_t.begin() + k0);
+      m_v_gates.erase(m_v_gates.begin(), m_v_gates.begin() + k0);
+      m_v_codomains.erase(m_v_codomains.begin(), m_v_codomains.begin() + k0);
+      m_v_slices.erase(m_v_slices.begin(), m_v_slices.begin() + k0);
+
+      update_views_ids();
+    }
+
+    void SlicesStorage::shift_tdomain(double a)
+    {
+      for(auto& t : m_v_t)
+        t += a;
+
+      add_dirty_tdomain(Interval::ALL_REALS); // the previous tdomains are meaningless
+    }
+
+    void SlicesStorage::update_views_ids(int k)
+    {
+      for( ; k < nb_slices() ; k++)
+        m_v_slices[k]->m_id = k;
+    }
+
+    void SlicesStorage::add_dirty_tdomain(const Interval& t)
+    {
+      assert(!t.is_empty());
+
+      // The slices of a same storage may be updated in parallel: the bounds are updated atomically
+      for(const auto& w : m_v_trackers)
+        if(shared_ptr<DirtyTDomain> tracker = w.lock())
+        {
+          double lb = tracker->lb.load();
+          while(t.lb() < lb && !tracker->lb.compare_exchange_weak(lb, t.lb()));
+          double ub = tracker->ub.load();
+          while(t.ub() > ub && !tracker->ub.compare_exchange_weak(ub, t.ub()));
+        }
+    }
+
+    bool SlicesStorage::records_updates() const
+    {
+      return !m_v_trackers.empty() && !m_bulk_update;
+    }
+
+    const vector<Interval> SlicesStorage::begin_range_update(int k0, int k1) const
+    {
+      assert(k0 >= 0 && k0 <= k1 && k1 <= nb_slices());
+
+      vector<Interval> v_prev;
+      if(m_v_trackers.empty())
+        return v_prev;
+
+      // The output gate of the range is the input gate of the next one: it is only
+      // compared for the last range, the output gate of the tube having no other range
+      int k_gates = k1 == nb_slices() ? k1 + 1 : k1;
+      v_prev.reserve(k1 - k0 + k_gates - k0);
+      v_prev.insert(v_prev.end(), m_v_codomains.begin() + k0, m_v_codomains.begin() + k1);
+      v_prev.insert(v_prev.end(), m_v_gates.begin() + k0, m_v_gates.begin() + k_gates);
+      return v_prev;
+    }
+
+    void SlicesStorage::end_range_update(int k0, int k1, const vector<Interval>& v_prev)
+    {
+      if(m_v_trackers.empty())
+        return;
+
+      const int n = k1 - k0;
+      int k_gates = k1 == nb_slices() ? k1 + 1 : k1;
+      assert((int)v_prev.size() == n + k_gates - k0);
+      double t_lb = POS_INFINITY, t_ub = NEG_INFINITY;
+
+      for(int k = k0 ; k < k1 ; k++)
+        if(m_v_codomains[k] != v_prev[k - k0])
+        {
+          t_lb = std::min(t_lb, m_v_t[k]);
+          t_ub = std::max(t_ub, m_v_t[k+1]);
+        }
+
+      for(int k = k0 ; k < k_gates ; k++)
+        if(m_v_gates[k] != v_prev[n + k - k0])
+        {
+          t_lb = std::min(t_lb, m_v_t[k]);
+          t_ub = std::max(t_ub, m_v_t[k]);
+        }
+
+      if(t_lb <= t_ub) // one update of the trackers for the whole range
+        add_dirty_tdomain(Interval(t_lb, t_ub));
+    }
+}
@@ -0,0 +1,317 @@
+/** 
+ *  \file
+ *  SlicesStorage class
+ * ----------------------------------------------------------------------------
+ *  \date       2021
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_SLICESSTORAGE_H__
+#define __CODAC_SLICESSTORAGE_H__
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <iosfwd>
+#include "codac_Interval.h"
+
+namespace codac
+{
+  class Slice;
+  class Tube;
+  class TubeTreeSynthesis;
+
+  /**
+   * \class SlicesStorage
+   * \brief Contiguous storage of the slices values of a one dimensional tube
+   *
+   * \note The values are stored in a structure-of-arrays layout: for \f$n\f$ slices,
+   *       the \f$n+1\f$ time bounds \f$t_0<\dots<t_n\f$, the \f$n\f$ envelopes and the
+   *       \f$n+1\f$ gates are stored in three vectors. The gate \f$k\f$ is both the input
+   *       gate of the \f$k\f$th slice and the output gate of the \f$(k-1)\f$th slice.
+   * \note Slice objects are lightweight views on this storage (an index),
+   *       so that slices can be accessed in constant time.
+   * \note The updates of the values are recorded at write time, in temporal terms,
+   *       for the trackers registered on the storage (see `dirty_tdomain()`).
+   */
+  class SlicesStorage
+  {
+    public:
+
+      /**
+       * \struct DirtyTDomain
+       * \brief Hull of the tdomains over which the values have been updated, for one tracker
+       *
+       * \note The bounds are atomic, as the slices may be updated in parallel (see `Tube::for_each_slice_range()`)
+       */
+      struct DirtyTDomain
+      {
+        DirtyTDomain() : lb(POS_INFINITY), ub(NEG_INFINITY) { }
+
+        std::atomic<double> lb; //!< lower bound of the hull (\f$+\infty\f$ if no update)
+        std::atomic<double> ub; //!< upper bound of the hull (\f$-\infty\f$ if no update)
+      };
+
+      /// \name Definition
+      /// @{
+
+      /**
+       * \brief Creates a storage of one slice
+       *
+       * \param tdomain Interval temporal domain \f$[t_0,t_f]\f$
+       * \param codomain Interval value of the slice (all reals \f$[-\infty,\infty]\f$ by default)
+       */
+      explicit SlicesStorage(const Interval& tdomain, const Interval& codomain = Interval::ALL_REALS);
+
+      /**
+       * \brief Creates a storage of \f$n\f$ slices from their time bounds
+       *
+       * \param v_t the \f$n+1\f$ increasing time bounds \f$t_0<\dots<t_n\f$
+       * \param codomain Interval value of the slices and the gates (all reals \f$[-\infty,\infty]\f$ by default)
+       */
+      explicit SlicesStorage(const std::vector<double>& v_t, const Interval& codomain = Interval::ALL_REALS);
+
+      /**
+       * \brief Creates a copy of the storage, with new Slice views
+       *
+       * \param x SlicesStorage to be duplicated
+       */
+      SlicesStorage(const SlicesStorage& x);
+
+      /**
+       * \brief The storage is not assignable: its Slice views are referenced by their tube
+       */
+      SlicesStorage& operator=(const SlicesStorage&) = delete;
+
+      /**
+       * \brief SlicesStorage destructor
+       *
+       * \note The Slice views are deleted together with the storage
+       */
+      ~SlicesStorage();
+
+      /**
+       * \brief Returns the number of slices
+       *
+       * \return an integer
+       */
+      int nb_slices() const;
+
+      /**
+       * \brief Returns the temporal definition domain of the stored slices
+       *
+       * \return an Interval object \f$[t_0,t_n]\f$
+       */
+      const Interval tdomain() const;
+
+      /**
+       * \brief Returns a pointer to the kth Slice view
+       *
+       * \param k the index of the slice
+       * \return a pointer to the corresponding Slice
+       */
+      Slice* slice(int k);
+
+      /**
+       * \brief Returns a constant pointer to the kth Slice view
+       *
+       * \param k the index of the slice
+       * \return a const pointer to the corresponding Slice
+       */
+      const Slice* slice(int k) const;
+
+      /**
+       * \brief Returns the index of the slice defined at \f$t\f$
+       *
+       * \note Binary search over the sorted time bounds: \f$\mathcal{O}(\log(n))\f$
+       * \note If two slices are defined at \f$t\f$ (common gate), then the second one is considered,
+       *       except at \f$t_n\f$ where the last slice is returned
+       *
+       * \param t the temporal key (double, must belong to the tdomain)
+       * \return the index of the slice
+       */
+      int time_to_index(double t) const;
+
+      /**
+       * \brief Returns the \f$n+1\f$ time bounds of the slices
+       *
+       * \return a const reference to the vector of bounds
+       */
+      const std::vector<double>& t_bounds() const;
+
+      /**
+       * \brief Returns the \f$n\f$ envelopes of the slices
+       *
+       * \return a const reference to the vector of envelopes
+       */
+      const std::vector<Interval>& codomains() const;
+
+      /**
+       * \brief Returns the \f$n+1\f$ gates of the slices
+       *
+       * \return a const reference to the vector of gates
+       */
+      const std::vector<Interval>& gates() const;
+
+      /**
+       * \brief Returns the hull of the tdomains over which the values have been updated
+       *        since the previous call with the same tracker, and resets it
+       *
+       * \note The updates are recorded by the setters of the slices, only if a value changed.
+       *       A sampling or a merge of slices only updates the tdomain of the related slices.
+       * \note If the tracker is not registered on this storage (first call, or storage replaced),
+       *       it is created and registered: the previous updates are unknown,
+       *       so that \f$[-\infty,\infty]\f$ is returned.
+       *
+       * \param tracker the tracker of the caller
+       * \return an Interval object, empty if no value has been updated
+       */
+      const Interval dirty_tdomain(std::shared_ptr<DirtyTDomain>& tracker);
+
+      /// @}
+
+    protected:
+
+      /**
+       * \brief Creates a storage of one slice, viewed by an existing Slice object
+       *
+       * \note Constructor used by standalone Slice objects
+       *
+       * \param owner the Slice object owning this storage
+       * \param tdomain Interval temporal domain \f$[t_0,t_f]\f$
+       * \param codomain Interval value of the slice
+       */
+      explicit SlicesStorage(Slice *owner, const Interval& tdomain, const Interval& codomain);
+
+      /**
+       * \brief Splits the kth slice at \f$t\f$
+       *
+       * \note The new slice \f$k+1\f$ is a copy of the kth one,
+       *       and the new gate is set to their common envelope
+       *
+       * \param k the index of the slice to be sampled
+       * \param t the temporal key, interior to the tdomain of the slice
+       */
+      void sample(int k, double t);
+
+      /**
+       * \brief Splits the slices at several times, in one pass over the storage
+       *
+       * \note Each new slice is a copy of the sampled one, as for `sample(int,double)`.
+       *       Times already defining a gate are ignored.
+       *
+       * \param v_t the sorted temporal keys, interior to the tdomain
+       */
+      void sample(const std::vector<double>& v_t);
+
+      /**
+       * \brief Appends a new slice after the last one
+       *
+       * \note The output gate of the previous last slice becomes the input gate of the new one
+       *
+       * \param t the new upper bound of the tdomain, greater than the current one
+       * \param codomain Interval value of the new slice and of its output gate
+       */
+      void push_back(double t, const Interval& codomain);
+
+      /**
+       * \brief Merges the kth and \f$(k+1)\f$th slices to keep only one
+       *
+       * \note The gate between the two slices is removed
+       *
+       * \param k the index of the first slice
+       */
+      void merge(int k);
+
+      /**
+       * \brief Merges several slices with their next one, in one pass over the storage
+       *
+       * \note Equivalent to successive calls to `merge(int)`, from the last index
+       *
+       * \param v_k the sorted indexes of the slices to be merged with their next one
+       */
+      void merge(const std::vector<int>& v_k);
+
+      /**
+       * \brief Keeps only the slices from index \f$k_0\f$ to index \f$k_f\f$
+       *
+       * \param k0 index of the first slice to be kept
+       * \param kf index of the last slice to be kept
+       */
+      void truncate(int k0, int kf);
+
+      /**
+       * \brief Shifts the time bounds of all the slices
+       *
+       * \param a the offset value so that \f$t_k:=t_k+a\f$
+       */
+      void shift_tdomain(double a);
+
+      /**
+       * \brief Updates the index of the Slice views, from the kth one
+       *
+       * \param k the index of the first view to be updated
+       */
+      void update_views_ids(int k = 0);
+
+      /**
+       * \brief Records an update of the values over a tdomain, for each registered tracker
+       *
+       * \param t the tdomain of the updated values
+       */
+      void add_dirty_tdomain(const Interval& t);
+
+      /**
+       * \brief Returns `true` if the setters of the slices have to record their updates
+       *
+       * \note Not the case without tracker, or during a bulk update of ranges of slices
+       *       (see `begin_range_update()`)
+       *
+       * \return `true` if the updates are recorded value by value
+       */
+      bool records_updates() const;
+
+      /**
+       * \brief Returns the values of a range of slices before its bulk update
+       *
+       * \note The setters of the slices do not record their updates during the bulk update:
+       *       the range is compared once to these values by `end_range_update()`
+       *
+       * \param k0 index of the first slice of the range
+       * \param k1 index following the last slice of the range
+       * \return the envelopes and then the gates of the slices, empty if there is no tracker
+       */
+      const std::vector<Interval> begin_range_update(int k0, int k1) const;
+
+      /**
+       * \brief Records the hull of the slices of a range whose values have been updated
+       *
+       * \note One update of the trackers for the whole range
+       *
+       * \param k0 index of the first slice of the range
+       * \param k1 index following the last slice of the range
+       * \param v_prev the values returned by `begin_range_update()` for this range
+       */
+      void end_range_update(int k0, int k1, const std::vector<Interval>& v_prev);
+
+      // Class variables:
+
+        std::vector<double> m_v_t; //!< time bounds \f$t_0<\dots<t_n\f$ of the slices
+        std::vector<Interval> m_v_codomains; //!< envelopes of the slices
+        std::vector<Interval> m_v_gates; //!< gates of the slices, shared by consecutive slices
+        std::vector<Slice*> m_v_slices; //!< Slice views on this storage
+        std::vector<std::weak_ptr<DirtyTDomain> > m_v_trackers; //!< trackers of the updated tdomains (not copied with the storage)
+        bool m_bulk_update = false; //!< ranges of slices are being updated (see `Tube::for_each_slice_range()`)
+
+      friend class Slice;
+      friend class Tube;
+      friend class TubeVector;
+      friend class MappedTube;
+      friend void deserialize_Tube(std::ifstream& bin_file, Tube *&tube);
+  };
+}
+
+#endif
@@ -8,10 +8,12 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <algorithm>
 #include "codac_Tube.h"
 #include "codac_Exception.h"
 #include "codac_CtcDeriv.h"
 #include "codac_CtcEval.h"
+#include "codac_ThreadPool.h"
 #include "codac_serialize_trajectories.h"
 #include "ibex_LargestFirst.h"
 #include "ibex_NoBisectableVariableException.h"
@@ -35,7 +37,7 @@ namespace codac
       assert(valid_tdomain(tdomain));
 
       // By default, the tube is defined as one single slice
-      m_first_slice = new Slice(tdomain, codomain);
+      m_slices = new SlicesStorage(tdomain, codomain);
       
       // Redundant information for fast access
       m_tdomain = tdomain;
@@ -49,7 +51,7 @@ namespace codac
       // Redundant information for fast access
       m_tdomain = tdomain;
 
-      Slice *prev_slice = NULL, *slice;
+      vector<double> v_t(1, tdomain.lb());
       double lb, ub = tdomain.lb();
 
       if(timestep == 0.)
@@ -59,24 +61,11 @@ namespace codac
       {
         lb = ub; // we guarantee all slices are adjacent
         ub = std::min(lb + timestep, tdomain.ub()); // the tdomain of the last slice may be smaller
-
-        slice = new Slice(Interval(lb,ub));
-
-        if(prev_slice != NULL)
-        {
-          delete slice->m_input_gate;
-          slice->m_input_gate = NULL;
-          Slice::chain_slices(prev_slice, slice);
-        }
-
-        prev_slice = slice;
-        if(m_first_slice == NULL) m_first_slice = slice;
-        slice = slice->next_slice();
+        v_t.push_back(ub);
 
       } while(ub < tdomain.ub());
 
-      if(codomain != Interval::ALL_REALS)
-        set(codomain);
+      m_slices = new SlicesStorage(v_t, codomain);
 
       if(m_enable_synthesis)
         create_synthesis_tree();
@@ -108,15 +97,13 @@ namespace codac
         tube_tdomain |= v_tdomains[i];
       }
 
-      m_first_slice = new Slice(tube_tdomain, Interval::ALL_REALS);
-      Slice *s = m_first_slice;
+      vector<double> v_t(1, tube_tdomain.lb());
+      for(size_t i = 0 ; i < v_tdomains.size() ; i++)
+        v_t.push_back(v_tdomains[i].ub());
 
+      m_slices = new SlicesStorage(v_t);
       for(size_t i = 0 ; i < v_tdomains.size() ; i++)
-      {
-        sample(v_tdomains[i].ub(), s);
-        s->set_envelope(v_codomains[i]);
-        s = s->next_slice();
-      }
+        m_slices->slice(i)->set_envelope(v_codomains[i]);
       
       // Redundant information for fast access
       m_tdomain = tube_tdomain;
@@ -127,6 +114,11 @@ namespace codac
       *this = x;
     }
 
+    Tube::Tube(Tube&& x) noexcept
+    {
+      *this = std::move(x);
+    }
+
     Tube::Tube(const Tube& x, const TFnc& f, int f_image_id)
       : Tube(x)
     {
@@ -172,14 +164,7 @@ namespace codac
     Tube::~Tube()
     {
       delete_synthesis_tree();
-
-      Slice *slice = first_slice();
-      while(slice != NULL)
-      {
-        Slice *next_slice = slice->next_slice();
-        delete slice;
-        slice = next_slice;
-      }
+      delete m_slices;
     }
 
     int Tube::size() const
@@ -199,50 +184,50 @@ namespace codac
 
     const Tube& Tube::operator=(const Tube& x)
     {
-      // Destroying already existing structure
+      if(this == &x)
+        return *this;
 
-        Slice *prev_slice, *slice = first_slice();
-        while(slice != NULL)
-        {
-          Slice *next_slice = slice->next_slice();
-          delete slice;
-          slice = next_slice;
-        }
+      if(m_slices != NULL && x.m_slices != NULL && same_slicing(*this, x))
+      {
+        // Values copied in place: the structure is kept
+        *this = TubeRef(x);
+        return *this;
+      }
+
+      // Destroying already existing structure
 
         delete_synthesis_tree();
+        delete m_slices;
       
       // Creating new structure
 
-        prev_slice = NULL; slice = NULL;
+        m_slices = x.m_slices == NULL ? NULL : new SlicesStorage(*x.m_slices);
 
-        for(const Slice *s = x.first_slice() ; s != NULL ; s = s->next_slice())
-        {
-          if(slice == NULL)
-          {
-            slice = new Slice(*s);
-            m_first_slice = slice;
-          }
+        // Redundant information for fast access
+        m_tdomain = x.tdomain();
 
-          else
-          {
-            slice->m_next_slice = new Slice(*s);
-            slice = slice->next_slice();
-          }
+      if(m_enable_synthesis)
+        create_synthesis_tree();
 
-          if(prev_slice != NULL)
-          {
-            delete slice->m_input_gate;
-            slice->m_input_gate = NULL;
-            Slice::chain_slices(prev_slice, slice);
-          }
+      return *this;
+    }
 
-          prev_slice = slice;
-        }
+    const Tube& Tube::operator=(Tube&& x) noexcept
+    {
+      if(this == &x)
+        return *this;
 
-        // Redundant information for fast access
-        m_tdomain = x.tdomain();
+      // Synthesis trees refer to their tube: they are not exchanged
+      delete_synthesis_tree();
+      x.delete_synthesis_tree();
 
-      if(m_enable_synthesis)
+      // The structures are exchanged: the previous one is destroyed with x
+      std::swap(m_slices, x.m_slices);
+      std::swap(m_tdomain, x.m_tdomain);
+      if(x.m_slices == NULL) // x was moved into a new tube
+        x.m_tdomain = Interval::EMPTY_SET;
+
+      if(m_enable_synthesis && m_slices != NULL)
         create_synthesis_tree();
 
       return *this;
@@ -328,16 +313,7 @@ namespace codac
 
     int Tube::nb_slices() const
     {
-      if(m_synthesis_tree != NULL) // fast evaluation
-        return m_synthesis_tree->nb_slices();
-      
-      else
-      {
-        int size = 0;
-        for(const Slice *s = first_slice() ; s != NULL ; s = s->next_slice())
-          size ++;
-        return size;
-      }
+      return m_slices == NULL ? 0 : m_slices->nb_slices();
     }
 
     Slice* Tube::slice(int slice_id)
@@ -347,25 +323,10 @@ namespace codac
 
     const Slice* Tube::slice(int slice_id) const
     {
-      if(slice_id < 0 && slice_id >= nb_slices())
+      if(slice_id < 0 || slice_id >= nb_slices())
         return NULL;
 
-      if(m_synthesis_tree != NULL) // fast access
-        return m_synthesis_tree->slice(slice_id);
-      
-      else
-      {
-        int i = 0;
-
-        for(const Slice *s = first_slice() ; s != NULL ; s = s->next_slice())
-        {
-          if(i == slice_id)
-            return s;
-          i++;
-        }
-
-        return NULL;
-      }
+      return m_slices->slice(slice_id); // constant-time access
     }
 
     Slice* Tube::slice(double t)
@@ -378,22 +339,7 @@ namespace codac
       if(!tdomain().contains(t))
         return NULL;
 
-      if(m_synthesis_tree != NULL) // fast evaluation
-        return m_synthesis_tree->slice(t);
-      
-      else
-      {
-        const Slice *last_s = NULL;
-        for(const Slice *s = first_slice() ; s != NULL ; s = s->next_slice())
-        {
-          if(t < s->tdomain().ub())
-            return s;
-          last_s = s;
-        }
-        
-        assert(last_s != NULL);
-        return last_s;
-      }
+      return m_slices->slice(m_slices->time_to_index(t)); // binary search
     }
 
     Slice* Tube::first_slice()
@@ -403,7 +349,7 @@ namespace codac
 
     const Slice* Tube::first_slice() const
     {
-      return m_first_slice;
+      return m_slices == NULL ? NULL : m_slices->slice(0);
     }
 
     Slice* Tube::last_slice()
@@ -413,16 +359,7 @@ namespace codac
 
     const Slice* Tube::last_slice() const
     {
-      if(m_synthesis_tree != NULL) // fast evaluation
-        return m_synthesis_tree->slice(nb_slices() - 1);
-      
-      else
-      {
-        for(const Slice *s = first_slice() ; true ; s = s->next_slice())
-          if(s->next_slice() == NULL)
-            return s;
-        return NULL;
-      }
+      return m_slices == NULL ? NULL : m_slices->slice(nb_slices() - 1);
     }
 
     Slice* Tube::wider_slice()
@@ -478,35 +415,14 @@ namespace codac
     int Tube::time_to_index(double t) const
     {
       assert(tdomain().contains(t));
-
-      if(m_synthesis_tree != NULL) // fast evaluation
-        return m_synthesis_tree->time_to_index(t);
-      
-      else
-      {
-        int i = -1;
-        for(const Slice *s = first_slice() ; s != NULL ; s = s->next_slice())
-        {
-          i++;
-          if(t < s->tdomain().ub())
-            return i;
-        }
-
-        return i;
-      }
+      return m_slices->time_to_index(t); // binary search
     }
 
     int Tube::index(const Slice* slice) const
     {
-      int i = 0;
-      const Slice *it = first_slice();
-      while(it != NULL && it != slice)
-      {
-        it = it->next_slice();
-        if(it == NULL) return -1;
-        i++;
-      }
-      return i;
+      if(slice == NULL || slice->m_storage != m_slices)
+        return -1;
+      return slice->m_id;
     }
 
     void Tube::sample(double t)
@@ -531,21 +447,24 @@ namespace codac
 
       else
       {
-        delete_synthesis_tree(); // todo: update tree if created, instead of delete
+        assert(slice_to_be_sampled->m_storage == m_slices);
+        int k = slice_to_be_sampled->m_id;
 
-        Slice *next_slice = slice_to_be_sampled->next_slice();
+        if(m_synthesis_tree != NULL) // the primitive values after t will be updated
+          slice_to_be_sampled->m_synthesis_reference->request_integrals_update();
 
-        // Creating new slice
-        Slice *new_slice = new Slice(*slice_to_be_sampled);
-        new_slice->set_tdomain(Interval(t, slice_to_be_sampled->tdomain().ub()));
-        slice_to_be_sampled->set_tdomain(Interval(slice_to_be_sampled->tdomain().lb(), t));
+        // The new slice is a copy of the sampled one, with a new gate at t
+        m_slices->sample(k, t);
 
-        // Updated slices structure
-        delete new_slice->m_input_gate;
-        new_slice->m_input_gate = NULL;
-        Slice::chain_slices(new_slice, next_slice);
-        Slice::chain_slices(slice_to_be_sampled, new_slice);
-        new_slice->set_input_gate(new_slice->codomain());
+        if(m_synthesis_tree != NULL) // local update: the leaf is split in two leaves
+        {
+          TubeTreeSynthesis *node = slice_to_be_sampled->m_synthesis_reference;
+          node->split(m_slices->slice(k + 1));
+
+          // The tree is rebuilt if the local updates make it too unbalanced
+          if(node->depth() > 2 * ceil(log2(nb_slices())) + 1)
+            create_synthesis_tree();
+        }
       }
     }
 
@@ -553,8 +472,6 @@ namespace codac
     {
       assert(tdomain().contains(t));
 
-      delete_synthesis_tree(); // todo: update tree if created, instead of delete
-
       sample(t);
       Slice *s = slice(t);
       if(t == s->tdomain().lb())
@@ -567,8 +484,23 @@ namespace codac
     {
       assert(tdomain() == x.tdomain());
 
-      for(const Slice *s = x.first_slice() ; s != NULL ; s = s->next_slice())
-        sample(s->tdomain().ub());
+      sample(x.m_slices->t_bounds());
+    }
+
+    void Tube::sample(const vector<double>& v_t)
+    {
+      assert(is_sorted(v_t.begin(), v_t.end()));
+      assert(v_t.empty() || tdomain().contains(v_t.front()));
+      assert(v_t.empty() || tdomain().contains(v_t.back()));
+
+      // The synthesis tree is built again afterwards, as many leaves may be split
+      bool synthesis = m_synthesis_tree != NULL;
+      delete_synthesis_tree();
+
+      m_slices->sample(v_t);
+
+      if(synthesis)
+        create_synthesis_tree();
     }
 
     bool Tube::gate_exists(double t) const
@@ -583,24 +515,112 @@ namespace codac
 
       Slice *s2 = slice(t);
       assert(s2->tdomain().lb() == t && "the gate must already exist");
+
       Slice *s1 = s2->prev_slice();
+      TubeTreeSynthesis *removed_leaf = NULL;
+
+      if(m_synthesis_tree != NULL) // the envelope of s1 and the next primitive values will be updated
+      {
+        s1->m_synthesis_reference->request_integrals_update();
+        removed_leaf = s2->m_synthesis_reference;
+      }
+
+      m_slices->merge(s1->m_id); // s2 is deleted
+
+      if(removed_leaf != NULL) // local update: the leaf of s2 is removed
+      {
+        TubeTreeSynthesis::remove_leaf(removed_leaf);
+        s1->m_synthesis_reference->update_structure();
+      }
+    }
+
+    void Tube::remove_gates(const vector<double>& v_t)
+    {
+      assert(is_sorted(v_t.begin(), v_t.end()));
+
+      vector<int> v_k;
+      v_k.reserve(v_t.size());
 
-      Slice::merge_slices(s1, s2);
+      for(const auto& t : v_t)
+      {
+        assert(tdomain().contains(t));
+        assert(t != tdomain().lb() && t != tdomain().ub() && "cannot remove initial/final gates");
+
+        int k = time_to_index(t);
+        assert(m_slices->t_bounds()[k] == t && "the gate must already exist");
+        v_k.push_back(k - 1);
+      }
+
+      bool synthesis = m_synthesis_tree != NULL;
+      delete_synthesis_tree();
+
+      m_slices->merge(v_k);
+
+      if(synthesis)
+        create_synthesis_tree();
     }
 
     void Tube::merge_similar_slices(double distance_threshold)
     {
-      Slice *s2 = first_slice();
-      while(s2 != NULL)
+      int k = 1;
+      while(k < nb_slices())
       {
-        Slice *s1 = s2->prev_slice();
-        Slice *next_slice = s2->next_slice();
+        if(distance(m_slices->m_v_codomains[k-1], m_slices->m_v_codomains[k]) < distance_threshold)
+          remove_gate(m_slices->m_v_t[k]); // the merged slice is then compared to the next one
 
-        if(s1 != NULL && distance(s1->codomain(),s2->codomain()) < distance_threshold)
-            Slice::merge_slices(s1, s2);
-      
-        s2 = next_slice;
+        else
+          k++;
+      }
+    }
+
+    void Tube::for_each_slice_range(const function<void(int,int)>& f)
+    {
+      // The updates of the slices are recorded once per range, not value by value
+      SlicesStorage *storage = m_slices;
+      auto f_range = [&f,storage](int k0, int k1)
+      {
+        const vector<Interval> v_prev = storage->begin_range_update(k0, k1);
+        f(k0, k1);
+        storage->end_range_update(k0, k1, v_prev);
+      };
+
+      ThreadPool& pool = ThreadPool::shared();
+      const bool parallel = pool.nb_ranges(nb_slices(), ThreadPool::grain_size()) > 1;
+
+      // The synthesis tree cannot be updated concurrently: it is built again afterwards
+      bool synthesis = parallel && m_synthesis_tree != NULL;
+      if(parallel)
+        delete_synthesis_tree();
+
+      exception_ptr e;
+      m_slices->m_bulk_update = true;
+
+      try
+      {
+        if(parallel)
+          pool.for_each_range(nb_slices(), ThreadPool::grain_size(), f_range);
+        else
+          f_range(0, nb_slices()); // sequential computation
       }
+
+      catch(...)
+      {
+        e = current_exception();
+        m_slices->add_dirty_tdomain(tdomain()); // the updated ranges are unknown
+      }
+
+      m_slices->m_bulk_update = false;
+
+      if(synthesis)
+        create_synthesis_tree();
+
+      if(e)
+        rethrow_exception(e);
+    }
+
+    const Interval Tube::dirty_tdomain(shared_ptr<SlicesStorage::DirtyTDomain>& tracker) const
+    {
+      return m_slices->dirty_tdomain(tracker);
     }
 
     // Accessing values
@@ -757,12 +777,8 @@ namespace codac
 
     void Tube::invert(const Interval& y, vector<Interval> &v_t, const Interval& search_tdomain) const
     {
-      // todo: optimize this:
-      // todo: fast inversion with binary tree considering derivative information
       v_t.clear();
 
-      // todo: tree computations
-
       if(search_tdomain.is_empty())
         return;
 
@@ -774,6 +790,38 @@ namespace codac
 
       Interval invert = Interval::EMPTY_SET;
 
+      if(m_synthesis_tree != NULL) // fast inversion
+      {
+        // Only the slices whose codomain intersects y are inverted
+        vector<int> v_k;
+        m_synthesis_tree->intersecting_slices(y,
+          time_to_index(search_tdomain.lb()), time_to_index(search_tdomain.ub()), v_k);
+
+        for(size_t i = 0 ; i < v_k.size() ; i++)
+        {
+          if(i > 0 && v_k[i] != v_k[i-1] + 1 && !invert.is_empty()) // skipped slices: empty inversion
+          {
+            v_t.push_back(invert);
+            invert.set_empty();
+          }
+
+          const Slice *s_x = slice(v_k[i]);
+          Interval local_invert = s_x->invert(y, search_tdomain & s_x->tdomain());
+          if(local_invert.is_empty() && !invert.is_empty())
+          {
+            v_t.push_back(invert);
+            invert.set_empty();
+          }
+
+          else
+            invert |= local_invert;
+        }
+
+        if(!invert.is_empty())
+          v_t.push_back(invert);
+        return;
+      }
+
       const Slice *s_x = slice(search_tdomain.lb());
       while(s_x != NULL && s_x->tdomain().lb() <= search_tdomain.ub())
       {
@@ -805,10 +853,28 @@ namespace codac
       else if(search_tdomain.lb() < tdomain().lb() || search_tdomain.ub() > tdomain().ub())
         return Interval::all_reals();
 
-      // todo: tree computations
-
       Interval invert = Interval::EMPTY_SET;
 
+      if(m_synthesis_tree != NULL) // fast inversion
+      {
+        // Only the slices whose codomain intersects y are inverted,
+        // among the slices starting before search_tdomain.ub()
+        int kf = time_to_index(search_tdomain.ub());
+        if(m_slices->t_bounds()[kf] == search_tdomain.ub())
+          kf--;
+
+        vector<int> v_k;
+        m_synthesis_tree->intersecting_slices(y, time_to_index(search_tdomain.lb()), kf, v_k);
+
+        for(const auto& k : v_k)
+        {
+          const Slice *s_x = slice(k);
+          invert |= s_x->invert(y, *v.slice(k), search_tdomain & s_x->tdomain());
+        }
+
+        return invert;
+      }
+
       const Slice *s_x = slice(search_tdomain.lb());
       const Slice *s_v = v.slice(search_tdomain.lb());
       while(s_x != NULL && s_x->tdomain().lb() < search_tdomain.ub())
@@ -827,8 +893,6 @@ namespace codac
       assert(same_slicing(*this, v));
       v_t.clear();
 
-      // todo: tree computations
-
       if(search_tdomain.is_empty())
         return;
 
@@ -840,6 +904,38 @@ namespace codac
 
       Interval invert = Interval::EMPTY_SET;
 
+      if(m_synthesis_tree != NULL) // fast inversion
+      {
+        // Only the slices whose codomain intersects y are inverted
+        vector<int> v_k;
+        m_synthesis_tree->intersecting_slices(y,
+          time_to_index(search_tdomain.lb()), time_to_index(search_tdomain.ub()), v_k);
+
+        for(size_t i = 0 ; i < v_k.size() ; i++)
+        {
+          if(i > 0 && v_k[i] != v_k[i-1] + 1 && !invert.is_empty()) // skipped slices: empty inversion
+          {
+            v_t.push_back(invert);
+            invert.set_empty();
+          }
+
+          const Slice *s_x = slice(v_k[i]);
+          Interval local_invert = s_x->invert(y, *v.slice(v_k[i]), search_tdomain & s_x->tdomain());
+          if(local_invert.is_empty() && !invert.is_empty())
+          {
+            v_t.push_back(invert);
+            invert.set_empty();
+          }
+
+          else
+            invert |= local_invert;
+        }
+
+        if(!invert.is_empty())
+          v_t.push_back(invert);
+        return;
+      }
+
       const Slice *s_x = slice(search_tdomain.lb());
       const Slice *s_v = v.slice(search_tdomain.lb());
       while(s_x != NULL && s_x->tdomain().lb() <= search_tdomain.ub())
@@ -1206,38 +1302,58 @@ namespace codac
       assert(valid_tdomain(t));
       assert(tdomain().is_superset(t));
 
+      delete_synthesis_tree(); // rebuilt below, as most of the leaves may be removed
+
       // The first slice is the slice containing t.lb()
-      while(!m_first_slice->tdomain().contains(t.lb()))
-      {
-        Slice *s_next = m_first_slice->next_slice();
-        delete m_first_slice;
-        m_first_slice = s_next;
-      }
+      // (if t.lb() is a gate, the slice after this gate)
+      int k0 = time_to_index(t.lb());
 
-      m_first_slice->set_tdomain(t & m_first_slice->tdomain());
+      // The last slice is the one containing t.ub()
+      // (if t.ub() is a gate, the slice before this gate)
+      int kf = time_to_index(t.ub());
+      if(kf > k0 && t.ub() == m_slices->t_bounds()[kf])
+        kf--;
 
-      // After this iteration, the last slice will be the one containing t.ub()
-      Slice *s_last = last_slice();
-      while(!s_last->tdomain().contains(t.ub()))
+      m_slices->truncate(k0, kf);
+      first_slice()->set_tdomain(t & first_slice()->tdomain());
+      last_slice()->set_tdomain(t & last_slice()->tdomain());
+
+      m_tdomain = t;
+      if(m_enable_synthesis)
+        create_synthesis_tree();
+      return *this;
+    }
+
+    Tube& Tube::extend_tdomain(double tf, double timestep, const Interval& codomain)
+    {
+      assert(tf > tdomain().ub());
+      assert(timestep >= 0.); // if 0., equivalent to no sampling
+
+      if(timestep == 0.)
+        timestep = tf - tdomain().ub();
+
+      double ub = tdomain().ub();
+      do
       {
-        Slice *s_prev = s_last->prev_slice();
-        delete s_last;
-        s_last = s_prev;
-      }
+        ub = std::min(ub + timestep, tf); // the tdomain of the last slice may be smaller
+        m_slices->push_back(ub, codomain);
 
-      s_last->set_tdomain(t & s_last->tdomain());
+      } while(ub < tf);
 
-      m_tdomain = t;
-      delete_synthesis_tree(); // todo: update tree if created, instead of delete
+      m_tdomain = Interval(m_tdomain.lb(), tf);
+      if(m_enable_synthesis)
+        create_synthesis_tree(); // new leaves
       return *this;
     }
 
     void Tube::shift_tdomain(double shift_ref)
     {
-      for(Slice *s = first_slice() ; s != NULL ; s = s->next_slice())
-        s->shift_tdomain(shift_ref);
+      m_slices->shift_tdomain(shift_ref);
       m_tdomain += shift_ref;
-      delete_synthesis_tree();
+      if(m_enable_synthesis)
+        create_synthesis_tree(); // all the tdomains of the tree are updated
+      else
+        delete_synthesis_tree();
     }
 
     // Bisection
@@ -1436,18 +1552,15 @@ namespace codac
     
     bool Tube::same_slicing(const Tube& x1, const Tube& x2)
     {
-      if(x1.nb_slices() != x2.nb_slices())
-        return false;
+      if(&x1 == &x2)
+        return true;
 
-      const Slice *s2 = x2.first_slice();
-      for(const Slice *s1 = x1.first_slice() ; s1 != NULL ; s1 = s1->next_slice())
-      {
-        if(s1->tdomain() != s2->tdomain())
-          return false;
-        s2 = s2->next_slice();
-      }
+      // A moved-from tube has no slices
+      if(x1.m_slices == NULL || x2.m_slices == NULL)
+        return x1.m_slices == x2.m_slices;
 
-      return true;
+      // Comparison of the contiguous arrays of time bounds
+      return x1.m_slices->t_bounds() == x2.m_slices->t_bounds();
     }
 
     void Tube::enable_synthesis(bool enable) const
@@ -1519,9 +1632,7 @@ namespace codac
       m_enable_synthesis = true;
       delete_synthesis_tree();
 
-      vector<const Slice*> v_slices;
-      for(const Slice* s = first_slice() ; s != NULL ; s = s->next_slice())
-        v_slices.push_back(s);
+      vector<const Slice*> v_slices(m_slices->m_v_slices.begin(), m_slices->m_v_slices.end());
 
       m_synthesis_tree = new TubeTreeSynthesis(this, 0, nb_slices() - 1, v_slices);
     }
@@ -15,10 +15,14 @@
 #include <map>
 #include <list>
 #include <vector>
+#include <functional>
+#include <memory>
 #include "codac_TFnc.h"
 #include "codac_Slice.h"
+#include "codac_SlicesStorage.h"
 #include "codac_Trajectory.h"
 #include "codac_serialize_tubes.h"
+#include "codac_tube_expr.h"
 #include "codac_tube_arithmetic.h"
 #include "codac_TubeTreeSynthesis.h"
 #include "codac_Polygon.h"
@@ -32,6 +36,7 @@ namespace codac
   class TFnc;
   class Tube;
   class Slice;
+  class SlicesStorage;
   class Trajectory;
   class TubeTreeSynthesis;
 
@@ -98,6 +103,13 @@ namespace codac
        */
       Tube(const Tube& x);
 
+      /**
+       * \brief Creates a scalar tube from a temporary one, without copying its slices
+       *
+       * \param x Tube to be moved, left without slices: it can only be destroyed or reassigned
+       */
+      Tube(Tube&& x) noexcept;
+
       /**
        * \brief Creates a copy of a scalar tube \f$[x](\cdot)\f$, with the same time
        *        discretization but a specific codomain defined by a TFnc object
@@ -160,6 +172,21 @@ namespace codac
        */
       explicit Tube(const std::string& binary_file_name, Trajectory *&traj);
 
+      /**
+       * \brief Creates a scalar tube from the evaluation of an arithmetic expression on tubes
+       *
+       * \note The slicing of the tube is the union of the slicings of the tube operands.
+       *       The expression is evaluated in a single pass over the slices.
+       *
+       * \param x the expression, for instance `x1 + 2.*sin(x2)`
+       */
+      template<typename E>
+      Tube(const TubeExpr<E>& x) : Tube(*x.derived().tube())
+      {
+        x.derived().sample(*this);
+        eval_tube_expr(*this, x);
+      }
+
       /**
        * \brief Tube destructor
        */
@@ -183,11 +210,40 @@ namespace codac
       /**
        * \brief Returns a copy of a Tube
        *
+       * \note If both tubes share the same slicing, the values are copied in place without allocation
+       *
        * \param x the Tube object to be copied
        * \return a new Tube object with same slicing and values
        */
       const Tube& operator=(const Tube& x);
 
+      /**
+       * \brief Moves a temporary Tube into this one, without copying its slices
+       *
+       * \param x the Tube object to be moved, left without slices: it can only be destroyed or reassigned
+       * \return a reference to this tube
+       */
+      const Tube& operator=(Tube&& x) noexcept;
+
+      /**
+       * \brief Sets this tube to the evaluation of an arithmetic expression on tubes
+       *
+       * \note If the tube operands share the slicing of this tube, the values are
+       *       computed in place without allocation. This tube may be one of the operands.
+       *
+       * \param x the expression, for instance `x1 + 2.*sin(x2)`
+       * \return a reference to this tube
+       */
+      template<typename E>
+      const Tube& operator=(const TubeExpr<E>& x)
+      {
+        if(m_slices != NULL && x.derived().same_slicing(*this))
+          eval_tube_expr(*this, x);
+        else
+          *this = Tube(x);
+        return *this;
+      }
+
       /**
        * \brief Returns the temporal definition domain of this tube
        *
@@ -402,6 +458,15 @@ namespace codac
        */
       void sample(const Tube& x);
 
+      /**
+       * \brief Samples this tube at several times, in one pass over the slices
+       *
+       * \note Equivalent to successive calls to `sample(double)`, with a linear complexity
+       *
+       * \param v_t the sorted temporal keys (must belong to the Tube's tdomain)
+       */
+      void sample(const std::vector<double>& v_t);
+
       /**
        * \brief Tests if a gate exists at time \f$t\f$
        *
@@ -417,6 +482,15 @@ namespace codac
        */
       void remove_gate(double t);
 
+      /**
+       * \brief Removes several gates and merges the related slices, in one pass over the slices
+       *
+       * \note Equivalent to successive calls to `remove_gate()`, with a linear complexity
+       *
+       * \param v_t the sorted time inputs where the gates to remove are
+       */
+      void remove_gates(const std::vector<double>& v_t);
+
       /**
        * \brief Merges all adjacent slices whose Hausdorff distance is less than the given threshold
        *
@@ -426,6 +500,28 @@ namespace codac
        */
       void merge_similar_slices(double distance_threshold);
 
+      /**
+       * \brief Calls a function on ranges of slices indexes, possibly in parallel
+       *
+       * \note The ranges are processed by the shared ThreadPool, see `ThreadPool::set_nb_threads()`.
+       *       The function may only modify the slices of its range, without slice consistency.
+       *
+       * \param f the function called for each range \f$[k_0,k_1)\f$ of slices indexes
+       */
+      void for_each_slice_range(const std::function<void(int,int)>& f);
+
+      /**
+       * \brief Returns the hull of the tdomains over which the slices have been updated
+       *        since the previous call with the same tracker
+       *
+       * \note The updates are recorded by the setters of the slices (see `SlicesStorage::dirty_tdomain()`),
+       *       so that this method is in \f$\mathcal{O}(1)\f$
+       *
+       * \param tracker the tracker of the caller, created at the first call
+       * \return an Interval object, \f$[-\infty,\infty]\f$ at the first call
+       */
+      const Interval dirty_tdomain(std::shared_ptr<SlicesStorage::DirtyTDomain>& tracker) const;
+
       /// @}
       /// \name Accessing values
       /// @{
@@ -518,6 +614,9 @@ namespace codac
       /**
        * \brief Computes the set of continuous values of the inversion \f$[x]^{-1}([y])\f$
        *
+       * \note With a synthesis tree (see `enable_synthesis()`), the slices whose codomain
+       *       does not intersect \f$[y]\f$ are skipped by ranges, without being inverted
+       *
        * \param y the interval codomain
        * \param v_t the vector of the sub-tdomains \f$[t_k]\f$ for which
        *            \f$\forall t\in[t_k] \mid x(t)\in[y], x(\cdot)\in[x](\cdot)\f$
@@ -530,6 +629,7 @@ namespace codac
        *
        * \note The knowledge of the derivative tube \f$[v](\cdot)\f$ allows a finer inversion
        * \note If the inversion results in several pre-images, their union is returned
+       * \note Accelerated by the synthesis tree, if enabled (see `enable_synthesis()`)
        *
        * \param y the interval codomain
        * \param v the derivative tube such that \f$\dot{x}(\cdot)\in[v](\cdot)\f$
@@ -542,6 +642,7 @@ namespace codac
        * \brief Computes the set of continuous values of the optimal inversion \f$[x]^{-1}([y])\f$
        *
        * \note The knowledge of the derivative tube \f$[v](\cdot)\f$ allows finer inversions
+       * \note Accelerated by the synthesis tree, as for the inversion without derivative
        *
        * \param y the interval codomain
        * \param v_t the vector of the sub-tdomains \f$[t_k]\f$ for which
@@ -809,6 +910,18 @@ namespace codac
        */
       Tube& truncate_tdomain(const Interval& tdomain);
 
+      /**
+       * \brief Extends the tdomain of \f$[x](\cdot)\f$ by appending new slices
+       *
+       * \note The tdomain of the last new slice may be smaller than the timestep
+       *
+       * \param tf new upper bound of the tdomain, greater than the current one
+       * \param timestep sampling value \f$\delta\f$ of the new slices (if 0, only one slice is appended)
+       * \param codomain Interval value of the new slices (all reals \f$[-\infty,\infty]\f$ by default)
+       * \return a reference to this tube
+       */
+      Tube& extend_tdomain(double tf, double timestep, const Interval& codomain = Interval::ALL_REALS);
+
       /**
        * \brief Shifts the tdomain \f$[t_0,t_f]\f$ of \f$[x](\cdot)\f$
        *
@@ -981,6 +1094,108 @@ namespace codac
        */
       const Tube& operator&=(const Tube& x);
 
+      /**
+       * \brief Operates +=
+       *
+       * \note The expression is evaluated in place, in a single pass over the slices,
+       *       if its tube operands share the slicing of this tube
+       *
+       * \param x expression
+       * \return (*this)+=x
+       */
+      template<typename E>
+      const Tube& operator+=(const TubeExpr<E>& x)
+      {
+        if(!assign_in_place<tube_op::Add>(x))
+          *this += Tube(x);
+        return *this;
+      }
+
+      /**
+       * \brief Operates -=
+       *
+       * \note The expression is evaluated in place, in a single pass over the slices,
+       *       if its tube operands share the slicing of this tube
+       *
+       * \param x expression
+       * \return (*this)-=x
+       */
+      template<typename E>
+      const Tube& operator-=(const TubeExpr<E>& x)
+      {
+        if(!assign_in_place<tube_op::Sub>(x))
+          *this -= Tube(x);
+        return *this;
+      }
+
+      /**
+       * \brief Operates *=
+       *
+       * \note The expression is evaluated in place, in a single pass over the slices,
+       *       if its tube operands share the slicing of this tube
+       *
+       * \param x expression
+       * \return (*this)*=x
+       */
+      template<typename E>
+      const Tube& operator*=(const TubeExpr<E>& x)
+      {
+        if(!assign_in_place<tube_op::Mul>(x))
+          *this *= Tube(x);
+        return *this;
+      }
+
+      /**
+       * \brief Operates /=
+       *
+       * \note The expression is evaluated in place, in a single pass over the slices,
+       *       if its tube operands share the slicing of this tube
+       *
+       * \param x expression
+       * \return (*this)/=x
+       */
+      template<typename E>
+      const Tube& operator/=(const TubeExpr<E>& x)
+      {
+        if(!assign_in_place<tube_op::Div>(x))
+          *this /= Tube(x);
+        return *this;
+      }
+
+      /**
+       * \brief Operates |=
+       *
+       * \note The expression is evaluated in place, in a single pass over the slices,
+       *       if its tube operands share the slicing of this tube
+       *
+       * \param x expression
+       * \return (*this)|=x
+       */
+      template<typename E>
+      const Tube& operator|=(const TubeExpr<E>& x)
+      {
+        if(!assign_in_place<tube_op::Union>(x))
+          *this |= Tube(x);
+        return *this;
+      }
+
+      /**
+       * \brief Operates &=
+       *
+       * \note The expression is evaluated in place, in a single pass over the slices,
+       *       if its tube operands share the slicing of this tube
+       *
+       * \param x expression
+       * \return (*this)&=x
+       */
+      template<typename E>
+      const Tube& operator&=(const TubeExpr<E>& x)
+      {
+        if(!assign_in_place<tube_op::Inter>(x))
+          *this &= Tube(x);
+        return *this;
+      }
+
       /// @}
       /// \name String
       /// @{
@@ -1179,20 +1394,166 @@ namespace codac
        */
       void delete_synthesis_tree() const;
 
+      /**
+       * \brief Computes \f$[x](\cdot):=f([x](\cdot),[y](\cdot))\f$ in place, slice by slice
+       *
+       * \note Nothing is computed if the tube operands of \f$[y](\cdot)\f$ do not
+       *       share the slicing of this tube
+       *
+       * \param y the right operand, possibly this tube itself
+       * \return `true` if the values have been computed
+       */
+      template<typename Op, typename E>
+      bool assign_in_place(const TubeExpr<E>& y)
+      {
+        assert(y.derived().tube() == NULL || tdomain() == y.tdomain());
+        if(!y.derived().same_slicing(*this))
+          return false;
+        eval_tube_expr(*this, TubeExprBinary<Op,TubeRef,E>(TubeRef(*this), y.derived()));
+        return true;
+      }
+
       // Class variables:
 
-        Slice *m_first_slice = NULL; //!< pointer to the first Slice object of this tube
+        SlicesStorage *m_slices = NULL; //!< contiguous storage of the slices of this tube
         mutable TubeTreeSynthesis *m_synthesis_tree = NULL; //!< pointer to the optional synthesis tree
         mutable bool m_enable_synthesis = Tube::s_enable_syntheses; //!< enables of the use of a synthesis tree
         Interval m_tdomain; //!< redundant information for fast evaluations
 
+      friend void serialize_Tube(std::ofstream& bin_file, const Tube& tube, int version_number);
       friend void deserialize_Tube(std::ifstream& bin_file, Tube *&tube);
       friend void deserialize_TubeVector(std::ifstream& bin_file, TubeVector *&tube);
       friend class TubeVector;
       friend class CtcEval;
+      friend class MappedTube;
 
       static bool s_enable_syntheses;
   };
+
+  // Methods of expressions that require the definition of the Tube class
+
+  template<typename E>
+  const Interval TubeExpr<E>::tdomain() const
+  {
+    return derived().tube()->tdomain();
+  }
+
+  template<typename E>
+  const Interval TubeExpr<E>::codomain() const
+  {
+    const E& e = derived();
+    if(!e.same_slicing(*e.tube()))
+      return Tube(*this).codomain();
+
+    Interval codomain = Interval::EMPTY_SET;
+    for(int k = 0 ; k < e.tube()->nb_slices() ; k++)
+      codomain |= e.slice_codomain(k);
+    return codomain;
+  }
+
+  template<typename E>
+  int TubeExpr<E>::nb_slices() const
+  {
+    const E& e = derived();
+    if(!e.same_slicing(*e.tube()))
+      return Tube(*this).nb_slices();
+    return e.tube()->nb_slices();
+  }
+
+  template<typename E>
+  double TubeExpr<E>::volume() const
+  {
+    const E& e = derived();
+    if(!e.same_slicing(*e.tube()))
+      return Tube(*this).volume();
+
+    double volume = 0.;
+    for(int k = 0 ; k < e.tube()->nb_slices() ; k++)
+    {
+      double slice_volume = e.tube()->slice(k)->tdomain().diam() * diam(e.slice_codomain(k));
+      if(slice_volume == POS_INFINITY)
+        return POS_INFINITY;
+      volume += slice_volume;
+    }
+    return volume;
+  }
+
+  template<typename E>
+  const Interval TubeExpr<E>::operator()(double t) const
+  {
+    assert(!std::isnan(t));
+    if(!tdomain().contains(t))
+      return Interval::all_reals();
+    // Each operand is evaluated at t: gate or envelope of its slice, as for the resulting tube
+    return derived().gate_at(t);
+  }
+
+  template<typename E>
+  const Interval TubeExpr<E>::operator()(const Interval& t) const
+  {
+    const E& e = derived();
+
+    if(t.is_empty())
+      return Interval::empty_set();
+
+    else if(t.lb() < tdomain().lb() || t.ub() > tdomain().ub())
+      return Interval::all_reals();
+
+    else if(t.is_degenerated())
+      return (*this)(t.lb());
+
+    else if(!e.same_slicing(*e.tube()))
+      return Tube(*this)(t);
+
+    else
+    {
+      const Tube *x = e.tube();
+      int k_last = x->time_to_index(t.ub());
+      if(x->slice(k_last)->tdomain().lb() == t.ub())
+        k_last--;
+
+      Interval codomain = Interval::EMPTY_SET;
+      for(int k = x->time_to_index(t.lb()) ; k <= k_last ; k++)
+        codomain |= e.slice_codomain(k);
+      return codomain;
+    }
+  }
+
+  template<typename E>
+  bool operator==(const TubeExpr<E>& x, const Tube& y)
+  {
+    return Tube(x) == y;
+  }
+
+  template<typename E>
+  bool operator==(const Tube& x, const TubeExpr<E>& y)
+  {
+    return x == Tube(y);
+  }
+
+  template<typename E1, typename E2>
+  bool operator==(const TubeExpr<E1>& x, const TubeExpr<E2>& y)
+  {
+    return Tube(x) == Tube(y);
+  }
+
+  template<typename E>
+  bool operator!=(const TubeExpr<E>& x, const Tube& y)
+  {
+    return Tube(x) != y;
+  }
+
+  template<typename E>
+  bool operator!=(const Tube& x, const TubeExpr<E>& y)
+  {
+    return x != Tube(y);
+  }
+
+  template<typename E1, typename E2>
+  bool operator!=(const TubeExpr<E1>& x, const TubeExpr<E2>& y)
+  {
+    return Tube(x) != Tube(y);
+  }
 }
 
 #endif
\ No newline at end of file
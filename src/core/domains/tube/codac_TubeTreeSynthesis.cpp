@@ -136,6 +136,24 @@ namespace codac
     }
   }
   
+  void TubeTreeSynthesis::intersecting_slices(const Interval& y, int k0, int kf, vector<int>& v_k, int k_offset)
+  {
+    // The slices of this subtree have the indexes [k_offset,k_offset+nb_slices()-1]
+    // in the tube, the subtrees not intersecting y are skipped
+
+    if(kf < k_offset || k0 >= k_offset + nb_slices() || !codomain().intersects(y))
+      return;
+
+    else if(is_leaf())
+      v_k.push_back(k_offset);
+
+    else
+    {
+      m_first_subtree->intersecting_slices(y, k0, kf, v_k, k_offset);
+      m_second_subtree->intersecting_slices(y, k0, kf, v_k, k_offset + m_first_subtree->nb_slices());
+    }
+  }
+  
   const Interval TubeTreeSynthesis::codomain()
   {
     if(m_values_update_needed)
@@ -232,7 +250,7 @@ namespace codac
 
     else
     {
-      int mid_id = ceil(nb_slices() / 2.);
+      int mid_id = m_first_subtree->nb_slices(); // the tree may be unbalanced after local updates
 
       if(slice_id < mid_id)
         return m_first_subtree->slice(slice_id);
@@ -351,7 +369,7 @@ namespace codac
 
   void TubeTreeSynthesis::update_integrals()
   {
-    if(m_values_update_needed)
+    if(m_integrals_update_needed)
     {
       // 1. Updating leafs values (leaf nodes)
 
@@ -550,4 +568,92 @@ namespace codac
       }
     }
   }
-}
\ No newline at end of file
+
+  // Local updates of the structure
+
+  int TubeTreeSynthesis::depth() const
+  {
+    int depth = 0;
+    for(const TubeTreeSynthesis *node = m_parent ; node != NULL ; node = node->m_parent)
+      depth++;
+    return depth;
+  }
+
+  void TubeTreeSynthesis::split(const Slice *new_slice)
+  {
+    assert(is_leaf());
+    assert(new_slice != NULL && m_slice_ref->next_slice() == new_slice);
+
+    // The leaf becomes a node with two leaves:
+    // the first one for its slice, the second one for the new slice
+
+    vector<const Slice*> v_slices({ m_slice_ref, new_slice });
+
+    m_first_subtree = new TubeTreeSynthesis(m_tube_ref, 0, 0, v_slices);
+    m_first_subtree->m_parent = this;
+    m_second_subtree = new TubeTreeSynthesis(m_tube_ref, 1, 1, v_slices);
+    m_second_subtree->m_parent = this;
+    m_slice_ref = NULL;
+
+    update_structure();
+  }
+
+  void TubeTreeSynthesis::remove_leaf(TubeTreeSynthesis *leaf)
+  {
+    // Note: the slice of this leaf may be already deleted, it is not accessed
+    assert(leaf != NULL && leaf->m_first_subtree == NULL && leaf->m_second_subtree == NULL);
+    assert(leaf->m_parent != NULL && "cannot remove the last leaf of the tree");
+
+    TubeTreeSynthesis *parent = leaf->m_parent;
+    TubeTreeSynthesis *sibling = parent->m_first_subtree == leaf
+                               ? parent->m_second_subtree : parent->m_first_subtree;
+
+    // The parent node takes the place of the sibling subtree
+
+    parent->m_first_subtree = sibling->m_first_subtree;
+    parent->m_second_subtree = sibling->m_second_subtree;
+    parent->m_slice_ref = sibling->m_slice_ref;
+
+    if(parent->m_first_subtree != NULL)
+      parent->m_first_subtree->m_parent = parent;
+
+    if(parent->m_second_subtree != NULL)
+      parent->m_second_subtree->m_parent = parent;
+
+    if(parent->m_slice_ref != NULL)
+      parent->m_slice_ref->m_synthesis_reference = parent;
+
+    sibling->m_first_subtree = NULL;
+    sibling->m_second_subtree = NULL;
+    sibling->m_slice_ref = NULL;
+    delete sibling;
+
+    leaf->m_slice_ref = NULL;
+    delete leaf;
+
+    parent->update_structure();
+  }
+
+  void TubeTreeSynthesis::update_structure()
+  {
+    // Only the branch from this node to the root is updated
+
+    for(TubeTreeSynthesis *node = this ; node != NULL ; node = node->m_parent)
+    {
+      if(node->is_leaf())
+      {
+        node->m_nb_slices = 1;
+        node->m_tdomain = node->m_slice_ref->tdomain();
+      }
+
+      else
+      {
+        node->m_nb_slices = node->m_first_subtree->m_nb_slices + node->m_second_subtree->m_nb_slices;
+        node->m_tdomain = node->m_first_subtree->m_tdomain | node->m_second_subtree->m_tdomain;
+      }
+
+      node->m_values_update_needed = true;
+      node->m_integrals_update_needed = true;
+    }
+  }
+}
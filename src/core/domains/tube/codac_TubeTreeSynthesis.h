@@ -26,6 +26,7 @@ namespace codac
       int nb_slices() const;
       const Interval operator()(const Interval& t);
       const Interval invert(const Interval& y, const Interval& search_tdomain);
+      void intersecting_slices(const Interval& y, int k0, int kf, std::vector<int>& v_k, int k_offset = 0);
       const Interval codomain();
       const std::pair<Interval,Interval> codomain_bounds();
       const std::pair<Interval,Interval> eval(const Interval& t = Interval::ALL_REALS);
@@ -49,6 +50,12 @@ namespace codac
 
     protected:
 
+      // Local updates of the structure
+      int depth() const;
+      void split(const Slice *new_slice);
+      static void remove_leaf(TubeTreeSynthesis *leaf);
+      void update_structure();
+
       // Slices connections
       const Slice *m_slice_ref = NULL;
       const Tube *m_tube_ref = NULL;
@@ -64,6 +71,8 @@ namespace codac
 
       bool m_integrals_update_needed = true;
       bool m_values_update_needed = true;
+
+      friend class Tube;
   };
 }
 
@@ -12,6 +12,7 @@
 #include "codac_Exception.h"
 #include "codac_CtcDeriv.h"
 #include "codac_CtcEval.h"
+#include "codac_ThreadPool.h"
 #include "ibex_LargestFirst.h"
 #include "codac_serialize_trajectories.h"
 #include "ibex_NoBisectableVariableException.h"
@@ -117,6 +118,11 @@ namespace codac
       *this = x;
     }
 
+    TubeVector::TubeVector(TubeVector&& x)
+    {
+      *this = std::move(x);
+    }
+
     TubeVector::TubeVector(const TubeVector& x, const IntervalVector& codomain)
       : TubeVector(x)
     {
@@ -186,17 +192,32 @@ namespace codac
 
     const TubeVector& TubeVector::operator=(const TubeVector& x)
     {
+      if(this == &x)
+        return *this;
+
+      if(m_v_tubes == NULL || m_n != x.size())
       { // Destroying already existing components
         if(m_v_tubes != NULL)
           delete[] m_v_tubes;
-      }
 
-      m_n = x.size();
-      m_v_tubes = new Tube[m_n];
+        m_n = x.size();
+        m_v_tubes = new Tube[m_n];
+      }
 
       for(int i = 0 ; i < size() ; i++)
-        (*this)[i] = x[i]; // copy of each component
+        (*this)[i] = x[i]; // copy of each component, in place if same slicing
+
+      return *this;
+    }
+
+    const TubeVector& TubeVector::operator=(TubeVector&& x)
+    {
+      if(this == &x)
+        return *this;
 
+      // The components are exchanged: the previous ones are destroyed with x
+      std::swap(m_n, x.m_n);
+      std::swap(m_v_tubes, x.m_v_tubes);
       return *this;
     }
 
@@ -323,6 +344,63 @@ namespace codac
         (*this)[i].sample(x[i]);
     }
 
+    void TubeVector::for_each_slice_range(const function<void(int,int)>& f)
+    {
+      // The updates of the slices are recorded once per range, not value by value
+      auto f_range = [&f,this](int k0, int k1)
+      {
+        vector<vector<Interval> > v_prev(size());
+        for(int i = 0 ; i < size() ; i++)
+          v_prev[i] = (*this)[i].m_slices->begin_range_update(k0, k1);
+        f(k0, k1);
+        for(int i = 0 ; i < size() ; i++)
+          (*this)[i].m_slices->end_range_update(k0, k1, v_prev[i]);
+      };
+
+      ThreadPool& pool = ThreadPool::shared();
+      const bool parallel = pool.nb_ranges(nb_slices(), ThreadPool::grain_size()) > 1;
+
+      // The synthesis trees cannot be updated concurrently: they are built again afterwards
+      vector<bool> v_synthesis(size(), false);
+      for(int i = 0 ; i < size() ; i++)
+      {
+        assert(Tube::same_slicing((*this)[0], (*this)[i]));
+        if(parallel)
+        {
+          v_synthesis[i] = (*this)[i].m_synthesis_tree != NULL;
+          (*this)[i].delete_synthesis_tree();
+        }
+        (*this)[i].m_slices->m_bulk_update = true;
+      }
+
+      exception_ptr e;
+
+      try
+      {
+        if(parallel)
+          pool.for_each_range(nb_slices(), ThreadPool::grain_size(), f_range);
+        else
+          f_range(0, nb_slices()); // sequential computation
+      }
+
+      catch(...)
+      {
+        e = current_exception();
+        for(int i = 0 ; i < size() ; i++) // the updated ranges are unknown
+          (*this)[i].m_slices->add_dirty_tdomain((*this)[i].tdomain());
+      }
+
+      for(int i = 0 ; i < size() ; i++)
+      {
+        (*this)[i].m_slices->m_bulk_update = false;
+        if(v_synthesis[i])
+          (*this)[i].create_synthesis_tree();
+      }
+
+      if(e)
+        rethrow_exception(e);
+    }
+
     // Accessing values
 
     const IntervalVector TubeVector::codomain() const
@@ -622,12 +700,13 @@ namespace codac
       Trajectory diag_traj;
       TrajectoryVector diams = diam(gates_thicknesses);
 
-      for(map<double,double>::const_iterator it = diams[0].sampled_map().begin() ; it != diams[0].sampled_map().end() ; it++)
+      const TrajectorySamples& samples = diams[0].samples();
+      for(int k = 0 ; k < samples.size() ; k++)
       {
         double diag = 0.;
         for(int i = start_index ; i <= end_index ; i++)
-          diag += std::pow(it->second, 2);
-        diag_traj.set(std::sqrt(diag), it->first);
+          diag += std::pow(samples.values()[k], 2);
+        diag_traj.set(std::sqrt(diag), samples.times()[k]);
       }
 
       return diag_traj;
@@ -811,6 +890,19 @@ namespace codac
       return *this;
     }
 
+    TubeVector& TubeVector::extend_tdomain(double tf, double timestep, const IntervalVector& codomain)
+    {
+      assert(size() == codomain.size());
+      for(int i = 0 ; i < size() ; i++)
+        (*this)[i].extend_tdomain(tf, timestep, codomain[i]);
+      return *this;
+    }
+
+    TubeVector& TubeVector::extend_tdomain(double tf, double timestep)
+    {
+      return extend_tdomain(tf, timestep, IntervalVector(size()));
+    }
+
     void TubeVector::shift_tdomain(double shift_ref)
     {
       for(int i = 0 ; i < size() ; i++)
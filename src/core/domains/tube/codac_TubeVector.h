@@ -16,6 +16,7 @@
 #include <list>
 #include <vector>
 #include <initializer_list>
+#include <functional>
 #include "codac_TFnc.h"
 #include "codac_TrajectoryVector.h"
 #include "codac_tube_arithmetic.h"
@@ -117,6 +118,13 @@ namespace codac
        */
       TubeVector(const TubeVector& x);
 
+      /**
+       * \brief Creates a n-dimensional tube from a temporary one, without copying its components
+       *
+       * \param x TubeVector to be moved, left in a valid but unspecified state
+       */
+      TubeVector(TubeVector&& x);
+
       /**
        * \brief Creates a copy of a n-dimensional tube \f$[\mathbf{x}](\cdot)\f$, with the same time
        *        discretization but a specific constant codomain
@@ -238,11 +246,22 @@ namespace codac
       /**
        * \brief Returns a copy of a TubeVector
        *
+       * \note If both tubes have the same dimension, the components are copied
+       *       in place (see Tube::operator=)
+       *
        * \param x the TubeVector object to be copied
        * \return a new TubeVector object with same slicing and values
        */
       const TubeVector& operator=(const TubeVector& x);
 
+      /**
+       * \brief Moves a temporary TubeVector into this one, without copying its components
+       *
+       * \param x the TubeVector object to be moved, left in a valid but unspecified state
+       * \return a reference to this tube
+       */
+      const TubeVector& operator=(TubeVector&& x);
+
       /**
        * \brief Returns the temporal definition domain of this tube
        *
@@ -330,6 +349,16 @@ namespace codac
        */
       void sample(const TubeVector& x);
 
+      /**
+       * \brief Calls a function on ranges of slices indexes, possibly in parallel
+       *
+       * \note The components are assumed to share the same slicing.
+       *       See `Tube::for_each_slice_range()`.
+       *
+       * \param f the function called for each range \f$[k_0,k_1)\f$ of slices indexes
+       */
+      void for_each_slice_range(const std::function<void(int,int)>& f);
+
       /// @}
       /// \name Accessing values
       /// @{
@@ -757,6 +786,27 @@ namespace codac
        */
       TubeVector& truncate_tdomain(const Interval& tdomain);
 
+      /**
+       * \brief Extends the tdomain of \f$[\mathbf{x}](\cdot)\f$ by appending new slices
+       *
+       * \note The tdomain of the last new slice may be smaller than the timestep
+       *
+       * \param tf new upper bound of the tdomain, greater than the current one
+       * \param timestep sampling value \f$\delta\f$ of the new slices (if 0, only one slice is appended)
+       * \param codomain IntervalVector value of the new slices (all reals \f$[-\infty,\infty]^n\f$ by default)
+       * \return a reference to this tube
+       */
+      TubeVector& extend_tdomain(double tf, double timestep, const IntervalVector& codomain);
+
+      /**
+       * \brief Extends the tdomain of \f$[\mathbf{x}](\cdot)\f$ by appending new unbounded slices
+       *
+       * \param tf new upper bound of the tdomain, greater than the current one
+       * \param timestep sampling value \f$\delta\f$ of the new slices (if 0, only one slice is appended)
+       * \return a reference to this tube
+       */
+      TubeVector& extend_tdomain(double tf, double timestep);
+
       /**
        * \brief Shifts the tdomain \f$[t_0,t_f]\f$ of \f$[\mathbf{x}](\cdot)\f$
        *
@@ -16,24 +16,14 @@ using namespace ibex;
 
 namespace codac
 {
-  #define macro_assign_scal(f) \
+  // Tube and Interval operands are processed in place slice by slice (see assign_in_place),
+  // so that no temporary tube is allocated
+
+  #define macro_assign_scal(f, Op) \
     \
     const Tube& Tube::f(const Interval& x) \
     { \
-      Slice *s = NULL; \
-      do \
-      { \
-        if(s == NULL) /* first iteration */ \
-          s = first_slice(); \
-        else \
-          s = s->next_slice(); \
-        \
-        s->set_envelope(Interval(s->codomain()).f(x), false); \
-        s->set_input_gate(Interval(s->input_gate()).f(x), false); \
-        \
-      } while(s->next_slice() != NULL); \
-      \
-      s->set_output_gate(Interval(s->output_gate()).f(x), false); \
+      assign_in_place<tube_op::Op>(TubeExprCst(x)); \
       return *this; \
     } \
     \
@@ -62,57 +52,31 @@ namespace codac
     { \
       assert(tdomain() == x.tdomain()); \
       \
-      if(Tube::same_slicing(*this, x)) /* faster */ \
-      { \
-        Slice *s = NULL; \
-        const Slice *s_x = NULL; \
-        do \
-        { \
-          if(s == NULL) /* first iteration */ \
-          { \
-            s = first_slice(); \
-            s_x = x.first_slice(); \
-          } \
-          \
-          else \
-          {  \
-            s = s->next_slice(); \
-            s_x = s_x->next_slice(); \
-          } \
-          \
-          s->set_envelope(Interval(s->codomain()).f(s_x->codomain()), false); \
-          s->set_input_gate(Interval(s->input_gate()).f(s_x->input_gate()), false); \
-        } while(s->next_slice() != NULL); \
-        \
-        s->set_output_gate(Interval(s->output_gate()).f((s_x->output_gate())), false); \
-      } \
+      if(assign_in_place<tube_op::Op>(TubeRef(x))) /* faster */ \
+        return *this; \
       \
-      else \
+      Slice *s = NULL; \
+      do \
       { \
-        Slice *s = NULL; \
-        do \
-        { \
-          if(s == NULL) /* first iteration */ \
-            s = first_slice(); \
-          else \
-            s = s->next_slice(); \
-          \
-          s->set_envelope(Interval(s->codomain()).f(x(s->tdomain())), false); \
-          s->set_input_gate(Interval(s->input_gate()).f(x(s->tdomain().lb())), false); \
-          \
-        } while(s->next_slice() != NULL); \
+        if(s == NULL) /* first iteration */ \
+          s = first_slice(); \
+        else \
+          s = s->next_slice(); \
         \
-        s->set_output_gate(Interval(s->output_gate()).f(x(s->tdomain().ub())), false); \
-      } \
+        s->set_envelope(Interval(s->codomain()).f(x(s->tdomain())), false); \
+        s->set_input_gate(Interval(s->input_gate()).f(x(s->tdomain().lb())), false); \
+        \
+      } while(s->next_slice() != NULL); \
       \
+      s->set_output_gate(Interval(s->output_gate()).f(x(s->tdomain().ub())), false); \
       return *this; \
     } \
     \
 
-  macro_assign_scal(operator+=);
-  macro_assign_scal(operator-=);
-  macro_assign_scal(operator*=);
-  macro_assign_scal(operator/=);
-  macro_assign_scal(operator&=);
-  macro_assign_scal(operator|=);
+  macro_assign_scal(operator+=, Add);
+  macro_assign_scal(operator-=, Sub);
+  macro_assign_scal(operator*=, Mul);
+  macro_assign_scal(operator/=, Div);
+  macro_assign_scal(operator&=, Inter);
+  macro_assign_scal(operator|=, Union);
 }
\ No newline at end of file
@@ -0,0 +1,270 @@
+/** 
+ *  FunctionTape class
+ * ----------------------------------------------------------------------------
+ *  \date       2021
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <algorithm>
+#include <unordered_map>
+#include "codac_FunctionTape.h"
+#include "codac_Exception.h"
+#include "ibex_Expr.h"
+#include "ibex_ExprVisitor.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace codac
+{
+  /**
+   * \class FunctionTapeBuilder
+   * \brief Visitor of the expression of an IBEX Function, producing the instructions of a tape
+   *
+   * \note Each node of the IBEX DAG is compiled once, into the same interval operation
+   *       as the one of the IBEX evaluation
+   */
+  class FunctionTapeBuilder : public ExprVisitor<int>
+  {
+    public:
+
+      FunctionTapeBuilder(FunctionTape& tape, const Function& f)
+        : m_tape(tape), m_f(f)
+      {
+
+      }
+
+      void build()
+      {
+        for(int i = 0 ; i < m_f.nb_arg() ; i++)
+          m_map_args[&m_f.arg(i)] = i;
+
+        // Vector-valued function: one output per component
+        const ExprVector *v = dynamic_cast<const ExprVector*>(&m_f.expr());
+        if(v != NULL)
+          for(int i = 0 ; i < v->nb_args ; i++)
+            m_tape.m_v_outputs.push_back(visit(v->arg(i)));
+
+        else
+          m_tape.m_v_outputs.push_back(visit(m_f.expr()));
+      }
+
+      int visit(const ExprNode& e)
+      {
+        auto it = m_map_nodes.find(&e);
+        if(it != m_map_nodes.end()) // shared node of the DAG
+          return it->second;
+
+        if(!e.dim.is_scalar())
+          error("only scalar operations are supported");
+
+        // A node without dedicated method is redirected here by the default
+        // methods of ExprVisitor, while being visited: it is not supported
+        if(&e == m_current_node)
+          error("unsupported operation");
+
+        const ExprNode *parent_node = m_current_node;
+        m_current_node = &e;
+        int k = e.accept_visitor(*this);
+        m_current_node = parent_node;
+
+        m_map_nodes[&e] = k;
+        return k;
+      }
+
+    protected:
+
+      typedef FunctionTape::Op Op;
+
+      int push(Op op, int a = -1, int b = -1, int p = 0, const Interval& cst = Interval(0.))
+      {
+        return m_tape.push({ op, a, b, p, cst });
+      }
+
+      void error(const string& msg) const
+      {
+        throw Exception("FunctionTape", "unable to compile the function (" + msg + ")");
+      }
+
+      int visit(const ExprSymbol& e)
+      {
+        auto it = m_map_args.find(&e);
+        if(it == m_map_args.end() || !e.dim.is_scalar())
+          error("only scalar arguments are supported");
+        return push(Op::ARG, it->second);
+      }
+
+      int visit(const ExprConstant& e) { return push(Op::CST, -1, -1, 0, e.get_value()); }
+
+      int visit(const ExprAdd& e)   { return push(Op::ADD, visit(e.left), visit(e.right)); }
+      int visit(const ExprSub& e)   { return push(Op::SUB, visit(e.left), visit(e.right)); }
+      int visit(const ExprMul& e)   { return push(Op::MUL, visit(e.left), visit(e.right)); }
+      int visit(const ExprDiv& e)   { return push(Op::DIV, visit(e.left), visit(e.right)); }
+      int visit(const ExprAtan2& e) { return push(Op::ATAN2, visit(e.left), visit(e.right)); }
+      int visit(const ExprMin& e)   { return push(Op::MIN, visit(e.left), visit(e.right)); }
+      int visit(const ExprMax& e)   { return push(Op::MAX, visit(e.left), visit(e.right)); }
+
+      int visit(const ExprPower& e) { return push(Op::POW_INT, visit(e.expr), -1, e.expon); }
+      int visit(const ExprMinus& e) { return push(Op::NEG, visit(e.expr)); }
+      int visit(const ExprSqr& e)   { return push(Op::SQR, visit(e.expr)); }
+      int visit(const ExprSqrt& e)  { return push(Op::SQRT, visit(e.expr)); }
+      int visit(const ExprExp& e)   { return push(Op::EXP, visit(e.expr)); }
+      int visit(const ExprLog& e)   { return push(Op::LOG, visit(e.expr)); }
+      int visit(const ExprCos& e)   { return push(Op::COS, visit(e.expr)); }
+      int visit(const ExprSin& e)   { return push(Op::SIN, visit(e.expr)); }
+      int visit(const ExprTan& e)   { return push(Op::TAN, visit(e.expr)); }
+      int visit(const ExprAcos& e)  { return push(Op::ACOS, visit(e.expr)); }
+      int visit(const ExprAsin& e)  { return push(Op::ASIN, visit(e.expr)); }
+      int visit(const ExprAtan& e)  { return push(Op::ATAN, visit(e.expr)); }
+      int visit(const ExprCosh& e)  { return push(Op::COSH, visit(e.expr)); }
+      int visit(const ExprSinh& e)  { return push(Op::SINH, visit(e.expr)); }
+      int visit(const ExprTanh& e)  { return push(Op::TANH, visit(e.expr)); }
+      int visit(const ExprAcosh& e) { return push(Op::ACOSH, visit(e.expr)); }
+      int visit(const ExprAsinh& e) { return push(Op::ASINH, visit(e.expr)); }
+      int visit(const ExprAtanh& e) { return push(Op::ATANH, visit(e.expr)); }
+      int visit(const ExprAbs& e)   { return push(Op::ABS, visit(e.expr)); }
+      int visit(const ExprSign& e)  { return push(Op::SIGN, visit(e.expr)); }
+
+      FunctionTape& m_tape;
+      const Function& m_f;
+      unordered_map<const ExprSymbol*,int> m_map_args; //!< indexes of the arguments
+      unordered_map<const ExprNode*,int> m_map_nodes; //!< instructions of the visited nodes
+      const ExprNode *m_current_node = NULL; //!< node being visited
+  };
+
+  // Public methods
+
+    // Definition
+
+    FunctionTape::FunctionTape(const Function& f)
+      : m_nb_args(f.nb_arg())
+    {
+      FunctionTapeBuilder(*this, f).build();
+    }
+
+    int FunctionTape::nb_args() const
+    {
+      return m_nb_args;
+    }
+
+    int FunctionTape::image_dim() const
+    {
+      return m_v_outputs.size();
+    }
+
+    int FunctionTape::size() const
+    {
+      return m_v_instr.size();
+    }
+
+    const FunctionTape FunctionTape::component(int i) const
+    {
+      assert(i >= 0 && i < image_dim());
+      FunctionTape tape(*this);
+      tape.m_v_outputs = vector<int>(1, m_v_outputs[i]);
+      return tape;
+    }
+
+    // Evaluation
+
+    void FunctionTape::eval(int n, const Interval* const* v_x, Interval* const* v_y, vector<Interval>& workspace) const
+    {
+      assert(n >= 0);
+
+      if(workspace.size() < m_v_instr.size() * n)
+        workspace.resize(m_v_instr.size() * n);
+
+      // Results of the kth instruction stored in workspace[k*n..(k+1)*n-1]
+      for(size_t k = 0 ; k < m_v_instr.size() ; k++)
+      {
+        const Instruction& instr = m_v_instr[k];
+        Interval *r = &workspace[k * n];
+
+        switch(instr.op)
+        {
+          case Op::CST:
+            std::fill(r, r + n, instr.cst);
+            break;
+
+          case Op::ARG:
+            std::copy(v_x[instr.a], v_x[instr.a] + n, r);
+            break;
+
+          default:
+            apply(instr, n, &workspace[instr.a * n], instr.b == -1 ? NULL : &workspace[instr.b * n], r);
+        }
+      }
+
+      for(int i = 0 ; i < image_dim() ; i++)
+        std::copy(&workspace[m_v_outputs[i] * n], &workspace[m_v_outputs[i] * n] + n, v_y[i]);
+    }
+
+  // Protected methods
+
+    int FunctionTape::push(const Instruction& instr)
+    {
+      // Constant folding
+      if(instr.op != Op::CST && instr.op != Op::ARG
+        && m_v_instr[instr.a].op == Op::CST && (instr.b == -1 || m_v_instr[instr.b].op == Op::CST))
+      {
+        Instruction cst = { Op::CST, -1, -1, 0, Interval(0.) };
+        apply(instr, 1, &m_v_instr[instr.a].cst, instr.b == -1 ? NULL : &m_v_instr[instr.b].cst, &cst.cst);
+        return push(cst);
+      }
+
+      // Common subexpressions
+      for(size_t k = 0 ; k < m_v_instr.size() ; k++)
+      {
+        const Instruction& i = m_v_instr[k];
+        if(i.op == instr.op && i.a == instr.a && i.b == instr.b && i.p == instr.p && i.cst == instr.cst)
+          return k;
+      }
+
+      m_v_instr.push_back(instr);
+      return m_v_instr.size() - 1;
+    }
+
+    void FunctionTape::apply(const Instruction& instr, int n, const Interval *x, const Interval *y, Interval *r)
+    {
+      #define batch_loop(expr) for(int k = 0 ; k < n ; k++) r[k] = expr; break;
+
+      switch(instr.op)
+      {
+        case Op::NEG:      batch_loop(-x[k]);
+        case Op::ADD:      batch_loop(x[k] + y[k]);
+        case Op::SUB:      batch_loop(x[k] - y[k]);
+        case Op::MUL:      batch_loop(x[k] * y[k]);
+        case Op::DIV:      batch_loop(x[k] / y[k]);
+        case Op::SQR:      batch_loop(sqr(x[k]));
+        case Op::POW_INT:  batch_loop(pow(x[k], instr.p));
+        case Op::SQRT:     batch_loop(sqrt(x[k]));
+        case Op::EXP:      batch_loop(exp(x[k]));
+        case Op::LOG:      batch_loop(log(x[k]));
+        case Op::COS:      batch_loop(cos(x[k]));
+        case Op::SIN:      batch_loop(sin(x[k]));
+        case Op::TAN:      batch_loop(tan(x[k]));
+        case Op::ACOS:     batch_loop(acos(x[k]));
+        case Op::ASIN:     batch_loop(asin(x[k]));
+        case Op::ATAN:     batch_loop(atan(x[k]));
+        case Op::COSH:     batch_loop(cosh(x[k]));
+        case Op::SINH:     batch_loop(sinh(x[k]));
+        case Op::TANH:     batch_loop(tanh(x[k]));
+        case Op::ACOSH:    batch_loop(acosh(x[k]));
+        case Op::ASINH:    batch_loop(asinh(x[k]));
+        case Op::ATANH:    batch_loop(atanh(x[k]));
+        case Op::ABS:      batch_loop(abs(x[k]));
+        case Op::SIGN:     batch_loop(sign(x[k]));
+        case Op::ATAN2:    batch_loop(atan2(x[k], y[k]));
+        case Op::MIN:      batch_loop(min(x[k], y[k]));
+        case Op::MAX:      batch_loop(max(x[k], y[k]));
+
+        default:
+          assert(false && "unhandled case");
+      }
+
+      #undef batch_loop
+    }
+}
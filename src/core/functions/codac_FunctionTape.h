@@ -0,0 +1,151 @@
+/** 
+ *  \file
+ *  FunctionTape class
+ * ----------------------------------------------------------------------------
+ *  \date       2021
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_FUNCTIONTAPE_H__
+#define __CODAC_FUNCTIONTAPE_H__
+
+#include <vector>
+#include "codac_Interval.h"
+#include "codac_Function.h"
+
+namespace codac
+{
+  /**
+   * \class FunctionTape
+   * \brief Flat list of interval operations compiled from an analytic expression,
+   *        for the evaluation of a function over arrays of boxes (batch evaluation)
+   *
+   * \note The expression of an IBEX Function is compiled once, by visiting its directed acyclic
+   *       graph (see `ibex::ExprVisitor`): each node becomes the same interval operation as in
+   *       the IBEX evaluation. Common subexpressions are shared and constants are folded.
+   *       The result is stored as a tape: each instruction only refers to the previous ones.
+   * \note The evaluation runs instruction by instruction over arrays of inputs,
+   *       without any allocation apart from the workspace, reusable between calls.
+   * \note Only scalar arguments and scalar operations are supported: `+ - * /`, integer
+   *       powers, and the usual elementary functions. An Exception is thrown otherwise,
+   *       so that the IBEX evaluation can be used instead.
+   */
+  class FunctionTape
+  {
+    public:
+
+      /// \name Definition
+      /// @{
+
+      /**
+       * \brief Compiles the expression of a function
+       *
+       * \param f the IBEX function, possibly vector-valued
+       */
+      explicit FunctionTape(const Function& f);
+
+      /**
+       * \brief Returns the number of scalar arguments
+       *
+       * \return an integer
+       */
+      int nb_args() const;
+
+      /**
+       * \brief Returns the dimension of the output
+       *
+       * \return an integer
+       */
+      int image_dim() const;
+
+      /**
+       * \brief Returns the number of instructions of the tape
+       *
+       * \return an integer
+       */
+      int size() const;
+
+      /**
+       * \brief Returns the tape restricted to the ith output component
+       *
+       * \param i the index of the component
+       * \return a FunctionTape object of dimension 1
+       */
+      const FunctionTape component(int i) const;
+
+      /// @}
+      /// \name Evaluation
+      /// @{
+
+      /**
+       * \brief Evaluates the function over \f$n\f$ boxes
+       *
+       * \param n the number of boxes
+       * \param v_x array of `nb_args()` pointers on the \f$n\f$ values of each argument
+       * \param v_y array of `image_dim()` pointers on the \f$n\f$ results of each output component
+       * \param workspace buffer of intermediate results, resized if necessary
+       */
+      void eval(int n, const Interval* const* v_x, Interval* const* v_y, std::vector<Interval>& workspace) const;
+
+      /// @}
+
+    protected:
+
+      /**
+       * \enum Op
+       * \brief Interval operation of an instruction
+       */
+      enum class Op
+      {
+        CST, ARG, NEG, ADD, SUB, MUL, DIV, SQR, POW_INT, SQRT, EXP, LOG,
+        COS, SIN, TAN, ACOS, ASIN, ATAN, COSH, SINH, TANH, ACOSH, ASINH, ATANH,
+        ABS, SIGN, ATAN2, MIN, MAX
+      };
+
+      /**
+       * \struct Instruction
+       * \brief Operation applied on the results of previous instructions
+       */
+      struct Instruction
+      {
+        Op op; //!< interval operation
+        int a, b; //!< indexes of the operands (previous instructions), or of the argument
+        int p; //!< integer parameter (exponent)
+        Interval cst; //!< constant value
+      };
+
+      /**
+       * \brief Appends an instruction to the tape, or returns an identical previous one
+       *
+       * \note Instructions involving only constants are directly evaluated (constant folding)
+       *
+       * \param instr the instruction
+       * \return the index of the instruction in the tape
+       */
+      int push(const Instruction& instr);
+
+      /**
+       * \brief Evaluates an instruction over \f$n\f$ values of its operands
+       *
+       * \param instr the instruction
+       * \param n the number of values
+       * \param x the values of the first operand
+       * \param y the values of the second operand (possibly NULL for unary operations)
+       * \param r the \f$n\f$ results
+       */
+      static void apply(const Instruction& instr, int n, const Interval *x, const Interval *y, Interval *r);
+
+      // Class variables:
+
+        int m_nb_args = 0; //!< number of scalar arguments
+        std::vector<Instruction> m_v_instr; //!< the tape
+        std::vector<int> m_v_outputs; //!< indexes of the instructions computing the output components
+
+      friend class FunctionTapeBuilder;
+  };
+}
+
+#endif
@@ -9,9 +9,11 @@
  */
 
 #include <sstream>
+#include <algorithm>
 #include "codac_TFunction.h"
 #include "codac_Tube.h"
 #include "codac_TubeVector.h"
+#include "codac_Exception.h"
 #include "ibex_Expr2Minibex.h"
 
 using namespace std;
@@ -148,6 +150,7 @@ namespace codac
       delete m_ibex_f;
     m_ibex_f = new Function(*f.m_ibex_f);
     m_expr = f.m_expr;
+    m_tape = f.m_tape;
     TFnc::operator=(f);
     return *this;
   }
@@ -161,6 +164,8 @@ namespace codac
     delete fi.m_ibex_f;
     fi.m_ibex_f = new Function(ibex_fi);
     fi.m_img_dim = 1;
+    if(m_tape != NULL)
+      fi.m_tape = make_shared<const FunctionTape>(m_tape->component(i));
     return fi;
   }
   
@@ -205,6 +210,18 @@ namespace codac
     m_img_dim = m_ibex_f->image_dim();
     m_intertemporal = false; // not supported yet
     m_expr = y;
+
+    try
+    {
+      m_tape = make_shared<const FunctionTape>(*m_ibex_f);
+      if(m_tape->image_dim() != m_img_dim)
+        m_tape.reset();
+    }
+
+    catch(Exception&)
+    {
+      m_tape.reset(); // expression not supported: IBEX evaluations only
+    }
     
     #ifdef _MSC_VER
     delete[] xdyn;
@@ -332,6 +349,12 @@ namespace codac
       return y;
     }
 
+    if(m_tape != NULL)
+    {
+      tape_eval_vector(x, y);
+      return y;
+    }
+
     IntervalVector box(x.size() + 1), result(y.size());
 
     const Slice **v_sx = new const Slice*[x.size()];
@@ -404,14 +427,16 @@ namespace codac
       && "eval TFunction not supported for analytic trajectories");
     
     TrajectoryVector y(image_dim());
-    for(map<double,double>::const_iterator it = x[0].sampled_map().begin() ;
-        it != x[0].sampled_map().end() ; it++)
+    bool shared_tbase = x.shared_tbase(); // values directly read, without temporal search
+    const vector<double>& v_t = x[0].samples().times();
+
+    for(size_t k = 0 ; k < v_t.size() ; k++)
     {
       Vector v(nb_var() + 1);
-      v[0] = it->first;
-      v.put(1, x(it->first));
+      v[0] = v_t[k];
+      v.put(1, shared_tbase ? x.sampled_value(k) : x(v_t[k]));
 
-      y.set(m_ibex_f->eval_vector(v).mid(), it->first);
+      y.set(m_ibex_f->eval_vector(v).mid(), v_t[k]);
     }
 
     return y;
@@ -422,6 +447,87 @@ namespace codac
     TFunction diff_f = *this;
     delete diff_f.m_ibex_f;
     diff_f.m_ibex_f = new Function(m_ibex_f->diff());
+    diff_f.m_tape.reset();
     return diff_f;
   }
-}
\ No newline at end of file
+
+  void TFunction::tape_eval_vector(const TubeVector& x, TubeVector& y) const
+  {
+    assert(m_tape != NULL);
+    assert(y.size() == image_dim());
+
+    // Batch evaluations of the compiled expression over chunks of slices,
+    // with buffers allocated once for all the chunks of a range of slices.
+    // The ranges are possibly evaluated in parallel (see ThreadPool).
+
+    const int chunk_size = 256;
+    const int nx = m_tape->nb_args() - 1, ny = image_dim();
+    const int n = x.nb_slices();
+
+    y.for_each_slice_range([&](int k_first, int k_last)
+    {
+      vector<Interval> v_in((nx + 1) * chunk_size), v_out(ny * chunk_size), workspace;
+      vector<const Interval*> v_in_ptr(nx + 1);
+      vector<Interval*> v_out_ptr(ny);
+      for(int j = 0 ; j <= nx ; j++)
+        v_in_ptr[j] = &v_in[j * chunk_size];
+      for(int i = 0 ; i < ny ; i++)
+        v_out_ptr[i] = &v_out[i * chunk_size];
+
+      // Envelopes of the slices (gates = false) and then gates (gates = true)
+      for(int gates = 0 ; gates < 2 ; gates++)
+      {
+        // The last range also evaluates the output gate of the last slice
+        int k_end = gates && k_last == n ? n + 1 : k_last;
+
+        for(int k0 = k_first ; k0 < k_end ; k0 += chunk_size)
+        {
+          int nk = std::min(chunk_size, k_end - k0);
+
+          for(int k = 0 ; k < nk ; k++)
+          {
+            int slice_id = std::min(k0 + k, n - 1); // the last gate is the output gate of the last slice
+            const Interval t = x[0].slice(slice_id)->tdomain();
+
+            if(!gates)
+            {
+              v_in[k] = t;
+              for(int j = 0 ; j < nx ; j++)
+                v_in[(j + 1) * chunk_size + k] = x[j].slice(slice_id)->codomain();
+            }
+
+            else if(k0 + k < n)
+            {
+              v_in[k] = Interval(t.lb());
+              for(int j = 0 ; j < nx ; j++)
+                v_in[(j + 1) * chunk_size + k] = x[j].slice(slice_id)->input_gate();
+            }
+
+            else
+            {
+              v_in[k] = Interval(t.ub());
+              for(int j = 0 ; j < nx ; j++)
+                v_in[(j + 1) * chunk_size + k] = x[j].slice(slice_id)->output_gate();
+            }
+          }
+
+          m_tape->eval(nk, v_in_ptr.data(), v_out_ptr.data(), workspace);
+
+          for(int i = 0 ; i < ny ; i++)
+            for(int k = 0 ; k < nk ; k++)
+            {
+              Slice *s = y[i].slice(std::min(k0 + k, n - 1));
+              const Interval& r = v_out[i * chunk_size + k];
+
+              if(!gates)
+                s->set_envelope(r, false);
+              else if(k0 + k < n)
+                s->set_input_gate(r, false);
+              else
+                s->set_output_gate(r, false);
+            }
+        }
+      }
+    });
+  }
+}
@@ -12,7 +12,9 @@
 #define __CODAC_TFUNCTION_H__
 
 #include <string>
+#include <memory>
 #include "codac_Function.h"
+#include "codac_FunctionTape.h"
 #include "codac_TFnc.h"
 #include "codac_Trajectory.h"
 #include "codac_TrajectoryVector.h"
@@ -73,9 +75,11 @@ namespace codac
     protected:
 
       void construct_from_array(int n, const char** x, const char* y);
+      void tape_eval_vector(const TubeVector& x, TubeVector& y) const;
 
       Function *m_ibex_f = NULL;
       std::string m_expr; // stored here because impossible to get this value from Function
+      std::shared_ptr<const FunctionTape> m_tape; // compiled expression for batch evaluations (NULL if not supported)
   };
 }
 
@@ -469,20 +469,22 @@ namespace codac
 
     if(traj->definition_type() == TrajDefnType::MAP_OF_VALUES)
     {
-      typename map<double,double>::const_iterator it_scalar_values;
-      for(it_scalar_values = traj->sampled_map().begin(); it_scalar_values != traj->sampled_map().end(); it_scalar_values++)
+      const TrajectorySamples& samples = traj->samples();
+      for(int k = 0 ; k < samples.size() ; k++)
       {
+        double t = samples.times()[k], y = samples.values()[k];
+
         if(m_map_trajs[traj].points_size != 0.)
-          draw_point(Point(it_scalar_values->first, it_scalar_values->second), m_map_trajs[traj].points_size, vibesParams("figure", name(), "group", group_name));
+          draw_point(Point(t, y), m_map_trajs[traj].points_size, vibesParams("figure", name(), "group", group_name));
 
         else
         {
-          v_x.push_back(it_scalar_values->first);
-          v_y.push_back(it_scalar_values->second);
+          v_x.push_back(t);
+          v_y.push_back(y);
         }
 
-        viewbox[0] |= it_scalar_values->first;
-        viewbox[1] |= it_scalar_values->second;
+        viewbox[0] |= t;
+        viewbox[1] |= y;
       }
     }
 
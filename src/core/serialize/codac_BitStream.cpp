@@ -0,0 +1,330 @@
+/**
+ *  BitWriter and BitReader classes (compressed serialization)
+ * ----------------------------------------------------------------------------
+ *  \date       2021
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <cassert>
+#include <cstring>
+#include "codac_BitStream.h"
+#include "codac_Exception.h"
+
+using namespace std;
+
+namespace codac
+{
+  #define CHUNK_SIZE 65536 // bytes
+
+  static uint64_t to_bits(double x)
+  {
+    uint64_t bits;
+    memcpy(&bits, &x, sizeof(double));
+    return bits;
+  }
+
+  static double from_bits(uint64_t bits)
+  {
+    double x;
+    memcpy(&x, &bits, sizeof(double));
+    return x;
+  }
+
+  static int leading_zeros(uint64_t x) // x != 0
+  {
+    #ifdef __GNUC__
+      return __builtin_clzll(x);
+    #else
+      int n = 0;
+      for(uint64_t mask = (uint64_t)1 << 63 ; !(x & mask) ; mask >>= 1)
+        n++;
+      return n;
+    #endif
+  }
+
+  static int trailing_zeros(uint64_t x) // x != 0
+  {
+    #ifdef __GNUC__
+      return __builtin_ctzll(x);
+    #else
+      int n = 0;
+      for(uint64_t mask = 1 ; !(x & mask) ; mask <<= 1)
+        n++;
+      return n;
+    #endif
+  }
+
+  // BitWriter
+
+    BitWriter::BitWriter(ofstream& bin_file)
+      : m_bin_file(bin_file)
+    {
+      if(!bin_file.is_open())
+        throw Exception(__func__, "ofstream& bin_file not open");
+
+      m_chunk.reserve(CHUNK_SIZE);
+    }
+
+    void BitWriter::write_bits(uint64_t bits, int n)
+    {
+      assert(n >= 0 && n <= 64);
+
+      if(n > 32)
+      {
+        write_bits(bits >> 32, n - 32);
+        n = 32;
+      }
+
+      // At most 7 + 32 bits in the accumulator
+      m_acc = (m_acc << n) | (bits & (((uint64_t)1 << n) - 1));
+      m_nb_bits += n;
+
+      while(m_nb_bits >= 8)
+      {
+        m_nb_bits -= 8;
+        m_chunk.push_back((char)(m_acc >> m_nb_bits));
+        if(m_chunk.size() == CHUNK_SIZE)
+          flush_chunk();
+      }
+    }
+
+    void BitWriter::write_times(const vector<double>& v_t)
+    {
+      if(v_t.empty())
+        return;
+
+      write_bits(to_bits(v_t[0]), 64);
+      if(v_t.size() == 1)
+        return;
+
+      uint64_t delta = to_bits(v_t[1]) - to_bits(v_t[0]);
+      write_bits(delta, 64);
+
+      for(size_t k = 2 ; k < v_t.size() ; k++)
+      {
+        uint64_t d = to_bits(v_t[k]) - to_bits(v_t[k-1]);
+        int64_t dod = (int64_t)(d - delta);
+        delta = d;
+
+        uint64_t zz = ((uint64_t)dod << 1) ^ (uint64_t)(dod >> 63); // zigzag encoding
+
+        if(zz == 0) // uniform sampling
+          write_bits(0, 1);
+
+        else if(zz < ((uint64_t)1 << 7))
+        {
+          write_bits(0x2, 2);
+          write_bits(zz, 7);
+        }
+
+        else if(zz < ((uint64_t)1 << 9))
+        {
+          write_bits(0x6, 3);
+          write_bits(zz, 9);
+        }
+
+        else if(zz < ((uint64_t)1 << 12))
+        {
+          write_bits(0xE, 4);
+          write_bits(zz, 12);
+        }
+
+        else
+        {
+          write_bits(0xF, 4);
+          write_bits(zz, 64);
+        }
+      }
+    }
+
+    void BitWriter::write_values(const vector<double>& v_x)
+    {
+      if(v_x.empty())
+        return;
+
+      uint64_t prev = to_bits(v_x[0]);
+      write_bits(prev, 64);
+      int lead = -1, trail = 0; // meaningful bits of the previous XOR (none yet)
+
+      for(size_t k = 1 ; k < v_x.size() ; k++)
+      {
+        uint64_t bits = to_bits(v_x[k]);
+        uint64_t x = bits ^ prev;
+        prev = bits;
+
+        if(x == 0) // same value
+        {
+          write_bits(0, 1);
+          continue;
+        }
+
+        int l = min(leading_zeros(x), 31), t = trailing_zeros(x);
+
+        if(lead >= 0 && l >= lead && t >= trail) // fits in the previous meaningful bits
+        {
+          write_bits(0x2, 2);
+          write_bits(x >> trail, 64 - lead - trail);
+        }
+
+        else
+        {
+          int n = 64 - l - t;
+          write_bits(0x3, 2);
+          write_bits(l, 5);
+          write_bits(n - 1, 6);
+          write_bits(x >> t, n);
+          lead = l; trail = t;
+        }
+      }
+    }
+
+    void BitWriter::flush()
+    {
+      if(m_nb_bits > 0)
+        write_bits(0, 8 - m_nb_bits); // padding of the last byte
+
+      if(!m_chunk.empty())
+        flush_chunk();
+      flush_chunk(); // empty chunk: end of stream
+    }
+
+    void BitWriter::flush_chunk()
+    {
+      uint32_t nb_bytes = m_chunk.size();
+      m_bin_file.write((const char*)&nb_bytes, sizeof(uint32_t));
+      m_bin_file.write(m_chunk.data(), nb_bytes);
+      m_chunk.clear();
+    }
+
+  // BitReader
+
+    BitReader::BitReader(ifstream& bin_file)
+      : m_bin_file(bin_file)
+    {
+      if(!bin_file.is_open())
+        throw Exception(__func__, "ifstream& bin_file not open");
+    }
+
+    uint64_t BitReader::read_bits(int n)
+    {
+      assert(n >= 0 && n <= 64);
+
+      if(n > 32)
+      {
+        uint64_t high = read_bits(n - 32);
+        return (high << 32) | read_bits(32);
+      }
+
+      while(m_nb_bits < n)
+      {
+        while(m_pos == m_chunk.size())
+          read_chunk();
+
+        m_acc = (m_acc << 8) | (unsigned char)m_chunk[m_pos++];
+        m_nb_bits += 8;
+      }
+
+      m_nb_bits -= n;
+      return (m_acc >> m_nb_bits) & (((uint64_t)1 << n) - 1);
+    }
+
+    void BitReader::read_times(vector<double>& v_t)
+    {
+      if(v_t.empty())
+        return;
+
+      uint64_t bits = read_bits(64);
+      v_t[0] = from_bits(bits);
+      if(v_t.size() == 1)
+        return;
+
+      uint64_t delta = read_bits(64);
+
+      for(size_t k = 1 ; k < v_t.size() ; k++)
+      {
+        if(k > 1)
+        {
+          uint64_t zz;
+
+          if(read_bits(1) == 0)
+            zz = 0;
+          else if(read_bits(1) == 0)
+            zz = read_bits(7);
+          else if(read_bits(1) == 0)
+            zz = read_bits(9);
+          else if(read_bits(1) == 0)
+            zz = read_bits(12);
+          else
+            zz = read_bits(64);
+
+          int64_t dod = (int64_t)(zz >> 1) ^ -(int64_t)(zz & 1);
+          delta += (uint64_t)dod;
+        }
+
+        bits += delta;
+        v_t[k] = from_bits(bits);
+      }
+    }
+
+    void BitReader::read_values(vector<double>& v_x)
+    {
+      if(v_x.empty())
+        return;
+
+      uint64_t prev = read_bits(64);
+      v_x[0] = from_bits(prev);
+      int lead = 0, trail = 0;
+
+      for(size_t k = 1 ; k < v_x.size() ; k++)
+      {
+        if(read_bits(1) == 1) // otherwise, same value
+        {
+          if(read_bits(1) == 1) // new meaningful bits
+          {
+            lead = read_bits(5);
+            int n = read_bits(6) + 1;
+            trail = 64 - lead - n;
+          }
+
+          prev ^= read_bits(64 - lead - trail) << trail;
+        }
+
+        v_x[k] = from_bits(prev);
+      }
+    }
+
+    void BitReader::finish()
+    {
+      // The remaining bits of the current byte are padding
+      m_nb_bits = 0;
+
+      if(m_pos != m_chunk.size())
+        throw Exception(__func__, "unexpected data in compressed stream");
+
+      if(!m_ended)
+        read_chunk(); // empty chunk: end of stream
+
+      if(!m_ended)
+        throw Exception(__func__, "unexpected data in compressed stream");
+    }
+
+    void BitReader::read_chunk()
+    {
+      if(m_ended)
+        throw Exception(__func__, "unexpected end of compressed stream");
+
+      uint32_t nb_bytes;
+      m_bin_file.read((char*)&nb_bytes, sizeof(uint32_t));
+      m_chunk.resize(nb_bytes);
+      m_bin_file.read(m_chunk.data(), nb_bytes);
+      m_pos = 0;
+
+      if(!m_bin_file)
+        throw Exception(__func__, "unexpected end of file");
+
+      m_ended = (nb_bytes == 0);
+    }
+}
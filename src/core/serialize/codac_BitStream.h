@@ -0,0 +1,152 @@
+/**
+ *  \file
+ *  BitWriter and BitReader classes (compressed serialization)
+ * ----------------------------------------------------------------------------
+ *  \date       2021
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_BITSTREAM_H__
+#define __CODAC_BITSTREAM_H__
+
+#include <fstream>
+#include <vector>
+#include <cstdint>
+
+namespace codac
+{
+  /**
+   * \class BitWriter
+   * \brief Compressed stream of bits written into a binary file
+   *
+   * \note The bits are written by chunks: [uint32_nb_bytes][bytes]..., the stream
+   *       being ended by an empty chunk. The file is never held entirely in memory.
+   * \note Time keys are encoded by delta-of-delta of their binary representation,
+   *       which is lossless and takes one bit per key for uniform samplings.
+   *       Values are encoded by XOR with the previous value (Gorilla compression),
+   *       so that slowly varying values take only a few bits.
+   */
+  class BitWriter
+  {
+    public:
+
+      /**
+       * \brief Creates a stream of bits written into a binary file
+       *
+       * \param bin_file binary file (ofstream object)
+       */
+      explicit BitWriter(std::ofstream& bin_file);
+
+      /**
+       * \brief Writes the \f$n\f$ lowest bits of an integer
+       *
+       * \param bits the value to be written
+       * \param n number of bits, \f$0\leqslant n\leqslant 64\f$
+       */
+      void write_bits(uint64_t bits, int n);
+
+      /**
+       * \brief Writes increasing time keys, with delta-of-delta compression
+       *
+       * \param v_t the time keys
+       */
+      void write_times(const std::vector<double>& v_t);
+
+      /**
+       * \brief Writes values, with XOR compression
+       *
+       * \param v_x the values (possibly infinite)
+       */
+      void write_values(const std::vector<double>& v_x);
+
+      /**
+       * \brief Writes the pending bits and ends the stream
+       *
+       * \note Must be called once, after the last write operation
+       */
+      void flush();
+
+    protected:
+
+      /**
+       * \brief Writes the current chunk of bytes into the file
+       */
+      void flush_chunk();
+
+      // Class variables:
+
+        std::ofstream& m_bin_file; //!< binary file
+        std::vector<char> m_chunk; //!< bytes not yet written
+        uint64_t m_acc = 0; //!< bits not yet gathered in a byte
+        int m_nb_bits = 0; //!< number of bits in the accumulator
+  };
+
+  /**
+   * \class BitReader
+   * \brief Compressed stream of bits read from a binary file
+   *
+   * \note The stream must have been written by a BitWriter object. The chunks
+   *       are read one after the other, when needed (streaming decode).
+   */
+  class BitReader
+  {
+    public:
+
+      /**
+       * \brief Creates a stream of bits read from a binary file
+       *
+       * \param bin_file binary file (ifstream object)
+       */
+      explicit BitReader(std::ifstream& bin_file);
+
+      /**
+       * \brief Reads an integer made of \f$n\f$ bits
+       *
+       * \param n number of bits, \f$0\leqslant n\leqslant 64\f$
+       * \return the value
+       */
+      uint64_t read_bits(int n);
+
+      /**
+       * \brief Reads time keys written by BitWriter::write_times()
+       *
+       * \param v_t the time keys, already sized to the number of keys
+       */
+      void read_times(std::vector<double>& v_t);
+
+      /**
+       * \brief Reads values written by BitWriter::write_values()
+       *
+       * \param v_x the values, already sized to the number of values
+       */
+      void read_values(std::vector<double>& v_x);
+
+      /**
+       * \brief Reaches the end of the stream in the file
+       *
+       * \note Must be called once, after the last read operation
+       */
+      void finish();
+
+    protected:
+
+      /**
+       * \brief Reads the next chunk of bytes from the file
+       */
+      void read_chunk();
+
+      // Class variables:
+
+        std::ifstream& m_bin_file; //!< binary file
+        std::vector<char> m_chunk; //!< current chunk of bytes
+        size_t m_pos = 0; //!< position of the next byte in the current chunk
+        bool m_ended = false; //!< true if the empty chunk has been read
+        uint64_t m_acc = 0; //!< bits read and not yet returned
+        int m_nb_bits = 0; //!< number of bits in the accumulator
+  };
+}
+
+#endif
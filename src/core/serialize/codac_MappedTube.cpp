@@ -0,0 +1,251 @@
+/**
+ *  MappedTube class
+ * ----------------------------------------------------------------------------
+ *  \date       2021
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#ifndef _MSC_VER
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#endif // _MSC_VER
+#include "codac_MappedTube.h"
+#include "codac_Exception.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace codac
+{
+  // Public methods
+
+    // Definition
+
+    MappedTube::MappedTube(const string& binary_file_name, int i)
+    {
+      #ifndef _MSC_VER
+
+        int fd = open(binary_file_name.c_str(), O_RDONLY);
+        if(fd < 0)
+          throw Exception(__func__, "unable to open file");
+
+        struct stat file_stat;
+        if(fstat(fd, &file_stat) != 0 || file_stat.st_size == 0)
+        {
+          close(fd);
+          throw Exception(__func__, "unable to read file");
+        }
+
+        m_size = file_stat.st_size;
+        void *data = mmap(NULL, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd); // the mapping remains valid
+
+        if(data == MAP_FAILED)
+          throw Exception(__func__, "unable to map file");
+        m_data = (const char*)data;
+
+      #else // no memory-mapping: the file is read at once
+
+        ifstream bin_file(binary_file_name.c_str(), ios::in | ios::binary | ios::ate);
+        if(!bin_file.is_open())
+          throw Exception(__func__, "unable to open file");
+
+        m_size = bin_file.tellg();
+        m_buffer.resize(m_size);
+        bin_file.seekg(0);
+        bin_file.read(m_buffer.data(), m_size);
+        m_data = m_buffer.data();
+
+      #endif // _MSC_VER
+
+      try
+      {
+        size_t offset = 0;
+        int nb_tubes = 1;
+
+        if(i >= 0) // TubeVector file
+        {
+          short int size;
+          if(m_size < sizeof(short int))
+            throw Exception(__func__, "unexpected end of file");
+          memcpy(&size, m_data, sizeof(short int));
+          offset = sizeof(short int);
+          nb_tubes = i + 1;
+
+          // The dimension is meaningless if the file has been written with another byte order
+          short int version_number = 0;
+          if(m_size >= 2 * sizeof(short int))
+            memcpy(&version_number, m_data + offset, sizeof(short int));
+          if(version_number == 0x0300)
+            throw Exception(__func__, "byte order of the file not supported, use deserialize_TubeVector()");
+
+          if(i >= size)
+            throw Exception(__func__, "wrong component index");
+        }
+
+        for(int j = 0 ; j < nb_tubes ; j++)
+        {
+          short int version_number;
+          if(offset + sizeof(short int) > m_size)
+            throw Exception(__func__, "unexpected end of file");
+          memcpy(&version_number, m_data + offset, sizeof(short int));
+          offset += sizeof(short int);
+
+          if(version_number != 3)
+            throw Exception(__func__, "only the serialization version 3 can be mapped");
+
+          offset += (8 - offset % 8) % 8; // padding
+
+          uint32_t endianness_tag;
+          if(offset + sizeof(uint32_t) + sizeof(int32_t) > m_size)
+            throw Exception(__func__, "unexpected end of file");
+          memcpy(&endianness_tag, m_data + offset, sizeof(uint32_t));
+          memcpy(&m_n, m_data + offset + sizeof(uint32_t), sizeof(int32_t));
+          offset += sizeof(uint32_t) + sizeof(int32_t);
+
+          if(endianness_tag != 0x01020304)
+            throw Exception(__func__, "byte order of the file not supported, use deserialize_Tube()");
+
+          if(m_n < 1)
+            throw Exception(__func__, "wrong slices number");
+
+          // Columns: n+1 time bounds, 2n bounds of slices, 2(n+1) bounds of gates
+          const double *columns = (const double*)(m_data + offset);
+          offset += (5 * m_n + 3) * sizeof(double);
+          if(offset > m_size)
+            throw Exception(__func__, "unexpected end of file");
+
+          m_t = columns;
+          m_lb = m_t + m_n + 1;
+          m_ub = m_lb + m_n;
+          m_gates_lb = m_ub + m_n;
+          m_gates_ub = m_gates_lb + m_n + 1;
+        }
+      }
+
+      catch(...)
+      {
+        #ifndef _MSC_VER
+          munmap((void*)m_data, m_size);
+        #endif // _MSC_VER
+        throw;
+      }
+    }
+
+    MappedTube::~MappedTube()
+    {
+      #ifndef _MSC_VER
+        munmap((void*)m_data, m_size);
+      #endif // _MSC_VER
+    }
+
+    int MappedTube::nb_slices() const
+    {
+      return m_n;
+    }
+
+    const Interval MappedTube::tdomain() const
+    {
+      return Interval(m_t[0], m_t[m_n]);
+    }
+
+    const Interval MappedTube::slice_tdomain(int k) const
+    {
+      assert(k >= 0 && k < m_n);
+      return Interval(m_t[k], m_t[k+1]);
+    }
+
+    int MappedTube::time_to_index(double t) const
+    {
+      assert(tdomain().contains(t));
+      int k = upper_bound(m_t, m_t + m_n + 1, t) - m_t - 1;
+      return min(k, m_n - 1); // last slice at t_f
+    }
+
+    // Accessing values
+
+    const Interval MappedTube::operator()(int k) const
+    {
+      assert(k >= 0 && k < m_n);
+      return interval(m_lb, m_ub, k);
+    }
+
+    const Interval MappedTube::gate(int k) const
+    {
+      assert(k >= 0 && k <= m_n);
+      return interval(m_gates_lb, m_gates_ub, k);
+    }
+
+    const Interval MappedTube::operator()(double t) const
+    {
+      int k = time_to_index(t);
+
+      if(t == m_t[k])
+        return gate(k);
+
+      else if(t == m_t[k+1])
+        return gate(k+1);
+
+      return (*this)(k);
+    }
+
+    const Interval MappedTube::operator()(const Interval& t) const
+    {
+      assert(tdomain().is_superset(t));
+
+      if(t.is_degenerated())
+        return (*this)(t.lb());
+
+      Interval y = Interval::EMPTY_SET;
+      for(int k = time_to_index(t.lb()) ; k < m_n && m_t[k] < t.ub() ; k++)
+        y |= (*this)(k);
+      return y;
+    }
+
+    const Tube MappedTube::tube(const Interval& t) const
+    {
+      assert(tdomain().is_superset(t));
+
+      int k0 = time_to_index(t.lb()), kf = time_to_index(t.ub());
+      if(kf > k0 && m_t[kf] == t.ub())
+        kf--; // the last slice is not in the interior of t
+
+      Tube x;
+      x.m_slices = new SlicesStorage(vector<double>(m_t + k0, m_t + kf + 2));
+      x.m_tdomain = x.m_slices->tdomain();
+
+      for(int k = k0 ; k <= kf ; k++)
+      {
+        x.m_slices->m_v_codomains[k-k0] = (*this)(k);
+        x.m_slices->m_v_gates[k-k0] = gate(k);
+      }
+
+      x.m_slices->m_v_gates[kf-k0+1] = gate(kf+1);
+
+      if(x.m_enable_synthesis)
+        x.create_synthesis_tree();
+      return x;
+    }
+
+    const Tube MappedTube::tube() const
+    {
+      return tube(tdomain());
+    }
+
+  // Protected methods
+
+    const Interval MappedTube::interval(const double *lb, const double *ub, int k)
+    {
+      // Empty sets are stored as [+oo,-oo]
+      return lb[k] > ub[k] ? Interval::EMPTY_SET : Interval(lb[k], ub[k]);
+    }
+}
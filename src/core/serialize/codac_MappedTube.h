@@ -0,0 +1,167 @@
+/**
+ *  \file
+ *  MappedTube class
+ * ----------------------------------------------------------------------------
+ *  \date       2021
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_MAPPEDTUBE_H__
+#define __CODAC_MAPPEDTUBE_H__
+
+#include <string>
+#include <vector>
+#include "codac_Interval.h"
+#include "codac_Tube.h"
+
+namespace codac
+{
+  /**
+   * \class MappedTube
+   * \brief Read-only access to a tube serialized in a binary file (version 3),
+   *        without loading it into memory
+   *
+   * \note The file is memory-mapped: the values of a slice are read from the file
+   *       only when accessed, and Tube objects can be materialized on a part of the tdomain.
+   * \note The file must have been written by serialize_Tube() with the version
+   *       number `SERIALIZATION_VERSION_COLUMNAR`, on a machine of same byte order.
+   */
+  class MappedTube
+  {
+    public:
+
+      /// \name Definition
+      /// @{
+
+      /**
+       * \brief Maps a scalar tube serialized in a binary file
+       *
+       * \param binary_file_name path to the binary file
+       * \param i index of the component, if the file contains a TubeVector (-1 by default: Tube file)
+       */
+      explicit MappedTube(const std::string& binary_file_name, int i = -1);
+
+      /**
+       * \brief MappedTube destructor, unmapping the file
+       */
+      ~MappedTube();
+
+      /**
+       * \brief Returns the number of slices of the serialized tube
+       *
+       * \return an integer
+       */
+      int nb_slices() const;
+
+      /**
+       * \brief Returns the temporal definition domain of the serialized tube
+       *
+       * \return an Interval object \f$[t_0,t_f]\f$
+       */
+      const Interval tdomain() const;
+
+      /**
+       * \brief Returns the temporal definition domain of the kth slice
+       *
+       * \param k the index of the slice
+       * \return an Interval object \f$[t_k,t_{k+1}]\f$
+       */
+      const Interval slice_tdomain(int k) const;
+
+      /**
+       * \brief Returns the index of the slice defined at \f$t\f$
+       *
+       * \note Binary search over the mapped time bounds (same convention as Tube::time_to_index())
+       *
+       * \param t the temporal key (double, must belong to the tdomain)
+       * \return the index of the slice
+       */
+      int time_to_index(double t) const;
+
+      /// @}
+      /// \name Accessing values
+      /// @{
+
+      /**
+       * \brief Returns the value of the kth slice
+       *
+       * \param k the index of the slice
+       * \return Interval value of \f$[x](k)\f$
+       */
+      const Interval operator()(int k) const;
+
+      /**
+       * \brief Returns the kth gate
+       *
+       * \param k the index of the gate, from 0 (\f$[x](t_0)\f$) to \f$n\f$ (\f$[x](t_f)\f$)
+       * \return Interval value of \f$[x](t_k)\f$
+       */
+      const Interval gate(int k) const;
+
+      /**
+       * \brief Returns the evaluation of the serialized tube at \f$t\f$
+       *
+       * \param t the temporal key (double, must belong to the tdomain)
+       * \return Interval value of \f$[x](t)\f$
+       */
+      const Interval operator()(double t) const;
+
+      /**
+       * \brief Returns the interval evaluation of the serialized tube over \f$[t]\f$
+       *
+       * \param t the subtdomain (Interval, must be a subset of the tdomain)
+       * \return Interval envelope \f$[x]([t])\f$
+       */
+      const Interval operator()(const Interval& t) const;
+
+      /**
+       * \brief Materializes the slices defined over \f$[t]\f$ into a Tube object
+       *
+       * \param t the subtdomain (Interval, must be a subset of the tdomain)
+       * \return the Tube made of the slices intersecting the interior of \f$[t]\f$
+       */
+      const Tube tube(const Interval& t) const;
+
+      /**
+       * \brief Materializes the whole serialized tube into a Tube object
+       *
+       * \return the deserialized Tube
+       */
+      const Tube tube() const;
+
+      /// @}
+
+    protected:
+
+      MappedTube(const MappedTube&) = delete;
+      MappedTube& operator=(const MappedTube&) = delete;
+
+      /**
+       * \brief Returns the Interval stored in two columns of bounds
+       *
+       * \param lb column of lower bounds
+       * \param ub column of upper bounds
+       * \param k the index of the Interval
+       * \return the Interval value, possibly empty
+       */
+      static const Interval interval(const double *lb, const double *ub, int k);
+
+      // Class variables:
+
+        const char *m_data = NULL; //!< content of the file
+        size_t m_size = 0; //!< size of the file, in bytes
+        std::vector<char> m_buffer; //!< content of the file, if memory-mapping is not available
+
+        int m_n = 0; //!< number of slices
+        const double *m_t = NULL; //!< column of the \f$n+1\f$ time bounds
+        const double *m_lb = NULL; //!< column of the lower bounds of the slices
+        const double *m_ub = NULL; //!< column of the upper bounds of the slices
+        const double *m_gates_lb = NULL; //!< column of the lower bounds of the gates
+        const double *m_gates_ub = NULL; //!< column of the upper bounds of the gates
+  };
+}
+
+#endif
@@ -0,0 +1,447 @@
+/**
+ *  TubeLogWriter and TubeLogReader classes (streaming serialization)
+ * ----------------------------------------------------------------------------
+ *  \date       2021
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#ifndef _MSC_VER
+  #include <unistd.h>
+#endif // _MSC_VER
+#include "codac_TubeLog.h"
+#include "codac_Exception.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace codac
+{
+  #define TUBELOG_VERSION 1
+  #define CHUNK_TAG 0x4B4E4843 // "CHNK"
+  #define FOOTER_TAG 0x544F4F46 // "FOOT"
+  #define HEADER_SIZE 16 // "CODACLOG", int version, int n
+  #define FOOTER_ENTRY_SIZE 32 // double t0, double tf, uint64 offset, uint64 nb_slices
+  #define FOOTER_TRAILER_SIZE 24 // uint64 nb_chunks, uint64 footer offset, uint32 checksum, uint32 tag
+
+  static uint32_t checksum(const char *data, size_t size) // FNV-1a
+  {
+    uint32_t h = 2166136261u;
+    for(size_t i = 0 ; i < size ; i++)
+      h = (h ^ (unsigned char)data[i]) * 16777619u;
+    return h;
+  }
+
+  static size_t payload_size(int m, int n) // in doubles
+  {
+    // m+1 time bounds, bounds of the m slices and of the m+1 gates
+    return (m + 1) + 2 * m * n + 2 * (m + 1) * n;
+  }
+
+  static size_t chunk_size(int m, int n) // in bytes
+  {
+    return 2 * sizeof(uint32_t) + payload_size(m, n) * sizeof(double) + sizeof(uint32_t);
+  }
+
+  static void push_bounds(vector<double>& v, const Interval& x)
+  {
+    // Empty sets are stored as [+oo,-oo]
+    v.push_back(x.is_empty() ? POS_INFINITY : x.lb());
+    v.push_back(x.is_empty() ? NEG_INFINITY : x.ub());
+  }
+
+  static const Interval interval(const double *bounds)
+  {
+    return bounds[0] > bounds[1] ? Interval::EMPTY_SET : Interval(bounds[0], bounds[1]);
+  }
+
+  static void write_header(ostream& log_file, int n)
+  {
+    int32_t version = TUBELOG_VERSION, size = n;
+    log_file.write("CODACLOG", 8);
+    log_file.write((const char*)&version, sizeof(int32_t));
+    log_file.write((const char*)&size, sizeof(int32_t));
+  }
+
+  static int read_header(istream& log_file)
+  {
+    char magic[8];
+    int32_t version, size;
+    log_file.seekg(0);
+    log_file.read(magic, 8);
+    log_file.read((char*)&version, sizeof(int32_t));
+    log_file.read((char*)&size, sizeof(int32_t));
+
+    if(!log_file || memcmp(magic, "CODACLOG", 8) != 0)
+      throw Exception(__func__, "not a tube log file");
+
+    if(version != TUBELOG_VERSION)
+      throw Exception(__func__, "unhandled tube log version");
+
+    if(size < 1)
+      throw Exception(__func__, "wrong dimension");
+
+    return size;
+  }
+
+  static bool read_chunk(istream& log_file, uint64_t offset, uint64_t file_size, int n,
+                         int& m, vector<double>& payload)
+  {
+    uint32_t tag, sum;
+    int32_t nb_slices;
+
+    log_file.clear();
+    log_file.seekg(offset);
+    log_file.read((char*)&tag, sizeof(uint32_t));
+    log_file.read((char*)&nb_slices, sizeof(int32_t));
+
+    if(!log_file || tag != CHUNK_TAG || nb_slices < 1
+      || offset + chunk_size(nb_slices, n) > file_size) // partially written chunk
+      return false;
+
+    m = nb_slices;
+    payload.resize(payload_size(m, n));
+    log_file.read((char*)payload.data(), payload.size() * sizeof(double));
+    log_file.read((char*)&sum, sizeof(uint32_t));
+
+    return log_file && sum == checksum((const char*)payload.data(), payload.size() * sizeof(double));
+  }
+
+  /**
+   * Loads the index of the chunks from the footer of the log.
+   * If the footer is not valid (interrupted write), the index is recovered
+   * by scanning the chunks, until the first corrupted one.
+   * Returns false in this case.
+   */
+  static bool read_index(istream& log_file, int n, vector<TubeLogChunk>& v_chunks, uint64_t& end)
+  {
+    v_chunks.clear();
+    log_file.clear();
+    log_file.seekg(0, ios::end);
+    uint64_t file_size = log_file.tellg();
+
+    // Footer
+
+    if(file_size >= HEADER_SIZE + FOOTER_TRAILER_SIZE)
+    {
+      uint64_t nb_chunks, footer_offset;
+      uint32_t sum, tag;
+      log_file.seekg(file_size - FOOTER_TRAILER_SIZE);
+      log_file.read((char*)&nb_chunks, sizeof(uint64_t));
+      log_file.read((char*)&footer_offset, sizeof(uint64_t));
+      log_file.read((char*)&sum, sizeof(uint32_t));
+      log_file.read((char*)&tag, sizeof(uint32_t));
+
+      if(log_file && tag == FOOTER_TAG && footer_offset >= HEADER_SIZE
+        && nb_chunks <= file_size / FOOTER_ENTRY_SIZE
+        && footer_offset + nb_chunks * FOOTER_ENTRY_SIZE + FOOTER_TRAILER_SIZE == file_size)
+      {
+        vector<char> entries(nb_chunks * FOOTER_ENTRY_SIZE + 2 * sizeof(uint64_t));
+        log_file.seekg(footer_offset);
+        log_file.read(entries.data(), entries.size());
+
+        if(log_file && sum == checksum(entries.data(), entries.size()))
+        {
+          for(size_t i = 0 ; i < nb_chunks ; i++)
+          {
+            double t0, tf;
+            uint64_t offset, nb_slices;
+            const char *entry = entries.data() + i * FOOTER_ENTRY_SIZE;
+            memcpy(&t0, entry, sizeof(double));
+            memcpy(&tf, entry + 8, sizeof(double));
+            memcpy(&offset, entry + 16, sizeof(uint64_t));
+            memcpy(&nb_slices, entry + 24, sizeof(uint64_t));
+            v_chunks.push_back({ Interval(t0, tf), offset, (int)nb_slices });
+          }
+
+          end = footer_offset;
+          return true;
+        }
+      }
+    }
+
+    // Recovery: scanning the chunks
+
+    int m;
+    vector<double> payload;
+    end = HEADER_SIZE;
+
+    while(read_chunk(log_file, end, file_size, n, m, payload))
+    {
+      v_chunks.push_back({ Interval(payload[0], payload[m]), end, m });
+      end += chunk_size(m, n);
+    }
+
+    log_file.clear();
+    return false;
+  }
+
+  // TubeLogWriter
+
+    TubeLogWriter::TubeLogWriter(const string& file_name, int n)
+      : m_n(n)
+    {
+      assert(n > 0);
+
+      m_file.open(file_name.c_str(), ios::in | ios::out | ios::binary);
+
+      if(!m_file.is_open()) // new log
+      {
+        ofstream log_file(file_name.c_str(), ios::out | ios::binary);
+        if(!log_file.is_open())
+          throw Exception(__func__, "unable to create file");
+        write_header(log_file, n);
+        log_file.close();
+
+        m_file.open(file_name.c_str(), ios::in | ios::out | ios::binary);
+        if(!m_file.is_open())
+          throw Exception(__func__, "unable to open file");
+      }
+
+      if(read_header(m_file) != n)
+        throw Exception(__func__, "dimension of the log does not match");
+
+      if(!read_index(m_file, n, m_v_chunks, m_end))
+      {
+        // The log was not properly closed: the footer is restored
+        // after the last valid chunk and the remaining data is discarded
+        write_footer();
+        #ifndef _MSC_VER
+          // Otherwise, the file is scanned again at each opening
+          if(truncate(file_name.c_str(), m_end + m_v_chunks.size() * FOOTER_ENTRY_SIZE + FOOTER_TRAILER_SIZE) != 0)
+            throw Exception(__func__, "unable to truncate file");
+        #endif // _MSC_VER
+      }
+    }
+
+    int TubeLogWriter::size() const
+    {
+      return m_n;
+    }
+
+    const Interval TubeLogWriter::tdomain() const
+    {
+      if(m_v_chunks.empty())
+        return Interval::EMPTY_SET;
+      return Interval(m_v_chunks.front().tdomain.lb(), m_v_chunks.back().tdomain.ub());
+    }
+
+    int TubeLogWriter::append(const TubeVector& x, double t)
+    {
+      assert(x.size() == m_n);
+      vector<const Tube*> v_x;
+      for(int i = 0 ; i < x.size() ; i++)
+        v_x.push_back(&x[i]);
+      return append(v_x, t);
+    }
+
+    int TubeLogWriter::append(const Tube& x, double t)
+    {
+      assert(m_n == 1);
+      return append(vector<const Tube*>(1, &x), t);
+    }
+
+    int TubeLogWriter::append(const vector<const Tube*>& v_x, double t)
+    {
+      const Tube& x = *v_x[0];
+      int k0 = 0;
+
+      if(!m_v_chunks.empty())
+      {
+        double t_end = m_v_chunks.back().tdomain.ub();
+        if(t_end >= x.tdomain().ub())
+          return 0; // already logged
+
+        if(x.tdomain().contains(t_end))
+          k0 = x.time_to_index(t_end);
+
+        if(!x.tdomain().contains(t_end) || x.slice_tdomain(k0).lb() != t_end)
+          throw Exception(__func__, "slicing of the tube does not match the logged slices");
+      }
+
+      int kf = k0;
+      while(kf < x.nb_slices() && x.slice_tdomain(kf).ub() <= t)
+        kf++;
+
+      int m = kf - k0;
+      if(m == 0)
+        return 0; // no finalised slice
+
+      vector<double> payload;
+      payload.reserve(payload_size(m, m_n));
+
+      for(int k = k0 ; k <= kf ; k++)
+        payload.push_back(k < kf ? x.slice_tdomain(k).lb() : x.slice_tdomain(k-1).ub());
+
+      for(int k = k0 ; k < kf ; k++)
+        for(int i = 0 ; i < m_n ; i++)
+          push_bounds(payload, v_x[i]->slice(k)->codomain());
+
+      for(int k = k0 ; k <= kf ; k++)
+        for(int i = 0 ; i < m_n ; i++)
+          push_bounds(payload, k < kf ? v_x[i]->slice(k)->input_gate() : v_x[i]->slice(k-1)->output_gate());
+
+      // The chunk is written in place of the footer
+
+      uint32_t tag = CHUNK_TAG, sum = checksum((const char*)payload.data(), payload.size() * sizeof(double));
+      int32_t nb_slices = m;
+      m_file.clear();
+      m_file.seekp(m_end);
+      m_file.write((const char*)&tag, sizeof(uint32_t));
+      m_file.write((const char*)&nb_slices, sizeof(int32_t));
+      m_file.write((const char*)payload.data(), payload.size() * sizeof(double));
+      m_file.write((const char*)&sum, sizeof(uint32_t));
+      m_file.flush(); // the chunk is on disk before being indexed
+
+      if(!m_file)
+        throw Exception(__func__, "unable to write chunk");
+
+      m_v_chunks.push_back({ Interval(payload[0], payload[m]), m_end, m });
+      m_end += chunk_size(m, m_n);
+      write_footer();
+      return m;
+    }
+
+    void TubeLogWriter::write_footer()
+    {
+      vector<char> footer(m_v_chunks.size() * FOOTER_ENTRY_SIZE + 2 * sizeof(uint64_t));
+
+      for(size_t i = 0 ; i < m_v_chunks.size() ; i++)
+      {
+        double t0 = m_v_chunks[i].tdomain.lb(), tf = m_v_chunks[i].tdomain.ub();
+        uint64_t nb_slices = m_v_chunks[i].nb_slices;
+        char *entry = footer.data() + i * FOOTER_ENTRY_SIZE;
+        memcpy(entry, &t0, sizeof(double));
+        memcpy(entry + 8, &tf, sizeof(double));
+        memcpy(entry + 16, &m_v_chunks[i].offset, sizeof(uint64_t));
+        memcpy(entry + 24, &nb_slices, sizeof(uint64_t));
+      }
+
+      uint64_t nb_chunks = m_v_chunks.size();
+      memcpy(footer.data() + nb_chunks * FOOTER_ENTRY_SIZE, &nb_chunks, sizeof(uint64_t));
+      memcpy(footer.data() + nb_chunks * FOOTER_ENTRY_SIZE + 8, &m_end, sizeof(uint64_t));
+      uint32_t sum = checksum(footer.data(), footer.size()), tag = FOOTER_TAG;
+
+      m_file.clear();
+      m_file.seekp(m_end);
+      m_file.write(footer.data(), footer.size());
+      m_file.write((const char*)&sum, sizeof(uint32_t));
+      m_file.write((const char*)&tag, sizeof(uint32_t));
+      m_file.flush();
+
+      if(!m_file)
+        throw Exception(__func__, "unable to write footer");
+    }
+
+  // TubeLogReader
+
+    TubeLogReader::TubeLogReader(const string& file_name)
+    {
+      m_file.open(file_name.c_str(), ios::in | ios::binary);
+      if(!m_file.is_open())
+        throw Exception(__func__, "unable to open file");
+
+      m_n = read_header(m_file);
+      uint64_t end;
+      read_index(m_file, m_n, m_v_chunks, end);
+    }
+
+    int TubeLogReader::size() const
+    {
+      return m_n;
+    }
+
+    int TubeLogReader::nb_slices() const
+    {
+      int n = 0;
+      for(const auto& chunk : m_v_chunks)
+        n += chunk.nb_slices;
+      return n;
+    }
+
+    const Interval TubeLogReader::tdomain() const
+    {
+      if(m_v_chunks.empty())
+        return Interval::EMPTY_SET;
+      return Interval(m_v_chunks.front().tdomain.lb(), m_v_chunks.back().tdomain.ub());
+    }
+
+    const TubeVector TubeLogReader::tube(const Interval& t) const
+    {
+      assert(!m_v_chunks.empty());
+      assert(tdomain().is_superset(t));
+
+      // Chunks intersecting t (binary search over the index)
+
+      size_t c0 = upper_bound(m_v_chunks.begin(), m_v_chunks.end(), t.lb(),
+        [](double t_, const TubeLogChunk& c) { return t_ < c.tdomain.ub(); }) - m_v_chunks.begin();
+      c0 = min(c0, m_v_chunks.size() - 1); // t.lb() == tf
+      size_t cf = c0;
+      while(cf + 1 < m_v_chunks.size() && m_v_chunks[cf+1].tdomain.lb() < t.ub())
+        cf++;
+
+      // Reading the slices of these chunks only
+
+      vector<double> v_t, v_codomains, v_gates;
+      uint64_t file_size = m_v_chunks[cf].offset + chunk_size(m_v_chunks[cf].nb_slices, m_n);
+
+      for(size_t c = c0 ; c <= cf ; c++)
+      {
+        int m;
+        vector<double> payload;
+        if(!read_chunk(m_file, m_v_chunks[c].offset, file_size, m_n, m, payload))
+          throw Exception(__func__, "corrupted chunk in log file");
+
+        const double *codomains = payload.data() + m + 1;
+        const double *gates = codomains + 2 * m * m_n;
+
+        if(!v_t.empty())
+        {
+          v_t.pop_back(); // same time bound and gate as the previous chunk
+          v_gates.resize(v_gates.size() - 2 * m_n);
+        }
+
+        v_t.insert(v_t.end(), payload.data(), payload.data() + m + 1);
+        v_codomains.insert(v_codomains.end(), codomains, codomains + 2 * m * m_n);
+        v_gates.insert(v_gates.end(), gates, gates + 2 * (m + 1) * m_n);
+      }
+
+      // Slices intersecting the interior of t
+
+      int n = v_t.size() - 1;
+      int k0 = upper_bound(v_t.begin(), v_t.end(), t.lb()) - v_t.begin() - 1;
+      int kf = upper_bound(v_t.begin(), v_t.end(), t.ub()) - v_t.begin() - 1;
+      k0 = min(max(k0, 0), n - 1); kf = min(max(kf, k0), n - 1);
+      if(kf > k0 && v_t[kf] == t.ub())
+        kf--; // the last slice is not in the interior of t
+
+      vector<Interval> v_tdomains;
+      for(int k = k0 ; k <= kf ; k++)
+        v_tdomains.push_back(Interval(v_t[k], v_t[k+1]));
+
+      TubeVector x(m_n, Tube(v_tdomains, vector<Interval>(v_tdomains.size())));
+
+      for(int i = 0 ; i < m_n ; i++)
+        for(int k = k0 ; k <= kf ; k++)
+        {
+          Slice *s = x[i].slice(k - k0);
+          s->set_envelope(interval(&v_codomains[2 * (k * m_n + i)]), false);
+          s->set_input_gate(interval(&v_gates[2 * (k * m_n + i)]), false);
+          if(k == kf)
+            s->set_output_gate(interval(&v_gates[2 * ((k + 1) * m_n + i)]), false);
+        }
+
+      return x;
+    }
+
+    const Tube TubeLogReader::scalar_tube(const Interval& t) const
+    {
+      assert(m_n == 1);
+      return tube(t)[0];
+    }
+}
@@ -0,0 +1,203 @@
+/**
+ *  \file
+ *  TubeLogWriter and TubeLogReader classes (streaming serialization)
+ * ----------------------------------------------------------------------------
+ *  \date       2021
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_TUBELOG_H__
+#define __CODAC_TUBELOG_H__
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include "codac_Interval.h"
+#include "codac_Tube.h"
+#include "codac_TubeVector.h"
+
+namespace codac
+{
+  /**
+   * \brief Entry of the index of a tube log: one chunk of slices
+   */
+  struct TubeLogChunk
+  {
+    Interval tdomain; //!< temporal domain covered by the slices of the chunk
+    uint64_t offset; //!< position of the chunk in the file
+    int nb_slices; //!< number of slices in the chunk
+  };
+
+  /**
+   * \class TubeLogWriter
+   * \brief Log file to which the slices of a tube are appended during a mission
+   *
+   * Log binary structure: <br>
+   *   [header] // "CODACLOG", int version, int dimension n <br>
+   *   [chunk_1] <br>
+   *   ... <br>
+   *   [chunk_p] <br>
+   *   [footer] // index of the chunks
+   *
+   * Chunk binary structure: <br>
+   *   [uint32_chunk_tag] <br>
+   *   [int_nb_slices_m] <br>
+   *   [double_t0] ... [double_tm] // time bounds <br>
+   *   [lb,ub of the m slices, n components each] <br>
+   *   [lb,ub of the m+1 gates, n components each] <br>
+   *   [uint32_checksum]
+   *
+   * \note Each append writes a new chunk in place of the footer, then the updated footer.
+   *       If the program stops during a write, the valid chunks are recovered
+   *       by scanning the file (checksums), when reading or when appending again.
+   * \note Values are stored with the byte order of the machine, and empty
+   *       sets as \f$[+\infty,-\infty]\f$.
+   */
+  class TubeLogWriter
+  {
+    public:
+
+      /**
+       * \brief Opens a log file, created if it does not exist
+       *
+       * \note The slices of an existing log are kept: new slices are appended after them
+       *
+       * \param file_name path to the log file
+       * \param n dimension of the logged tubes
+       */
+      explicit TubeLogWriter(const std::string& file_name, int n = 1);
+
+      /**
+       * \brief Returns the dimension of the logged tubes
+       *
+       * \return n
+       */
+      int size() const;
+
+      /**
+       * \brief Returns the temporal domain covered by the logged slices
+       *
+       * \return an Interval object, empty if nothing has been logged yet
+       */
+      const Interval tdomain() const;
+
+      /**
+       * \brief Appends the slices of a tube that are finalised up to time \f$t\f$
+       *
+       * \note The slices defined after the logged ones and before \f$t\f$ are written
+       *       in a new chunk. The slicing of the tube must contain the last logged time.
+       *
+       * \param x the tube being computed (its past slices are not modified anymore)
+       * \param t time until which the slices are finalised
+       * \return the number of slices appended
+       */
+      int append(const TubeVector& x, double t);
+
+      /**
+       * \brief Appends the slices of a scalar tube that are finalised up to time \f$t\f$
+       *
+       * \param x the tube being computed (its past slices are not modified anymore)
+       * \param t time until which the slices are finalised
+       * \return the number of slices appended
+       */
+      int append(const Tube& x, double t);
+
+    protected:
+
+      TubeLogWriter(const TubeLogWriter&) = delete;
+      TubeLogWriter& operator=(const TubeLogWriter&) = delete;
+
+      /**
+       * \brief Appends the finalised slices of the components of a tube
+       *
+       * \param v_x the \f$n\f$ components, sharing the same slicing
+       * \param t time until which the slices are finalised
+       * \return the number of slices appended
+       */
+      int append(const std::vector<const Tube*>& v_x, double t);
+
+      /**
+       * \brief Writes the index of the chunks at the end of the log
+       */
+      void write_footer();
+
+      // Class variables:
+
+        std::fstream m_file; //!< log file
+        int m_n = 1; //!< dimension of the logged tubes
+        std::vector<TubeLogChunk> m_v_chunks; //!< index of the chunks
+        uint64_t m_end = 0; //!< position of the end of the last chunk (and of the footer)
+  };
+
+  /**
+   * \class TubeLogReader
+   * \brief Random access by time range to a log file written by a TubeLogWriter object
+   *
+   * \note Only the index of the chunks is held in memory: slices are read on demand.
+   */
+  class TubeLogReader
+  {
+    public:
+
+      /**
+       * \brief Opens a log file
+       *
+       * \param file_name path to the log file
+       */
+      explicit TubeLogReader(const std::string& file_name);
+
+      /**
+       * \brief Returns the dimension of the logged tubes
+       *
+       * \return n
+       */
+      int size() const;
+
+      /**
+       * \brief Returns the number of logged slices
+       *
+       * \return an integer
+       */
+      int nb_slices() const;
+
+      /**
+       * \brief Returns the temporal domain covered by the logged slices
+       *
+       * \return an Interval object, empty if nothing has been logged
+       */
+      const Interval tdomain() const;
+
+      /**
+       * \brief Reads the logged slices over \f$[t]\f$
+       *
+       * \param t the subtdomain (Interval, must be a subset of the logged tdomain)
+       * \return the TubeVector made of the slices intersecting the interior of \f$[t]\f$
+       */
+      const TubeVector tube(const Interval& t) const;
+
+      /**
+       * \brief Reads the logged slices over \f$[t]\f$, for a scalar log
+       *
+       * \param t the subtdomain (Interval, must be a subset of the logged tdomain)
+       * \return the Tube made of the slices intersecting the interior of \f$[t]\f$
+       */
+      const Tube scalar_tube(const Interval& t) const;
+
+    protected:
+
+      TubeLogReader(const TubeLogReader&) = delete;
+      TubeLogReader& operator=(const TubeLogReader&) = delete;
+
+      // Class variables:
+
+        mutable std::ifstream m_file; //!< log file
+        int m_n = 1; //!< dimension of the logged tubes
+        std::vector<TubeLogChunk> m_v_chunks; //!< index of the chunks
+  };
+}
+
+#endif
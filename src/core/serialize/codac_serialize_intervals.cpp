@@ -8,6 +8,8 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <cstring>
+#include <vector>
 #include "codac_serialize_intervals.h"
 #include "codac_Exception.h"
 
@@ -90,6 +92,63 @@ namespace codac
     }
   }
 
+  void deserialize_Intervals(ifstream& bin_file, Interval *v_intv, int n)
+  {
+    if(!bin_file.is_open())
+      throw Exception(__func__, "ifstream& bin_file not open");
+
+    // The serialized size of the intervals is unknown: a buffer of maximal size
+    // is read, and the file position is then restored after the last interval
+
+    streampos pos = bin_file.tellg();
+    vector<char> buffer(n * (sizeof(IntervalType) + 2 * sizeof(double)));
+    bin_file.read(buffer.data(), buffer.size());
+    size_t size = bin_file.gcount(), i = 0;
+
+    for(int k = 0 ; k < n ; k++)
+    {
+      IntervalType intv_type;
+      if(i + sizeof(IntervalType) > size)
+        throw Exception(__func__, "unexpected end of file");
+      memcpy(&intv_type, &buffer[i], sizeof(IntervalType));
+      i += sizeof(IntervalType);
+
+      switch(intv_type)
+      {
+        case IntervalType::EMPTY_SET:
+          v_intv[k] = Interval::EMPTY_SET;
+          break;
+
+        case IntervalType::ALL_REALS:
+          v_intv[k] = Interval::ALL_REALS;
+          break;
+
+        case IntervalType::POS_REALS:
+          v_intv[k] = Interval::POS_REALS;
+          break;
+
+        case IntervalType::NEG_REALS:
+          v_intv[k] = Interval::NEG_REALS;
+          break;
+
+        case IntervalType::BOUNDED:
+          double b[2];
+          if(i + sizeof(b) > size)
+            throw Exception(__func__, "unexpected end of file");
+          memcpy(b, &buffer[i], sizeof(b));
+          i += sizeof(b);
+          v_intv[k] = Interval(b[0], b[1]);
+          break;
+
+        default:
+          throw Exception(__func__, "unhandled case");
+      }
+    }
+
+    bin_file.clear(); // the buffer may have exceeded the end of file
+    bin_file.seekg(pos + (streamoff)i);
+  }
+
   void serialize_IntervalVector(ofstream& bin_file, const IntervalVector& box)
   {
     if(!bin_file.is_open())
@@ -49,6 +49,18 @@ namespace codac
    */
   void deserialize_Interval(std::ifstream& bin_file, Interval& intv);
 
+  /**
+   * \brief Creates n Interval objects from a binary file, with a single read operation
+   *
+   * The binary file has to be written by n successive calls to serialize_Interval().
+   * The file position is set just after the last Interval.
+   *
+   * \param bin_file binary file (ifstream object)
+   * \param v_intv array of n Interval objects to be deserialized
+   * \param n number of Interval objects
+   */
+  void deserialize_Intervals(std::ifstream& bin_file, Interval *v_intv, int n);
+
   /// @}
   /// \name IntervalVector
   /// @{
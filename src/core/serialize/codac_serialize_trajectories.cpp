@@ -11,6 +11,7 @@
 #include "codac_Vector.h"
 #include "codac_Exception.h"
 #include "codac_serialize_trajectories.h"
+#include "codac_BitStream.h"
 
 using namespace std;
 using namespace ibex;
@@ -35,21 +36,37 @@ namespace codac
         break;
 
       case 2:
+      case 3: // the columnar version of tubes keeps the layout of trajectories
       {
         // Points number
-        int pts_number = traj.sampled_map().size();
+        const TrajectorySamples& samples = traj.samples();
+        int pts_number = samples.size();
         bin_file.write((const char*)&pts_number, sizeof(int));
 
-        typename map<double,double>::const_iterator it_map;
-        for(it_map = traj.sampled_map().begin() ; it_map != traj.sampled_map().end() ; it_map++)
+        for(int k = 0 ; k < pts_number ; k++)
         {
-          bin_file.write((const char*)&it_map->first, sizeof(double));
-          bin_file.write((const char*)&it_map->second, sizeof(double));
+          bin_file.write((const char*)&samples.times()[k], sizeof(double));
+          bin_file.write((const char*)&samples.values()[k], sizeof(double));
         }
 
         break;
       }
 
+      case 4:
+      {
+        // Points number
+        const TrajectorySamples& samples = traj.samples();
+        int pts_number = samples.size();
+        bin_file.write((const char*)&pts_number, sizeof(int));
+
+        // Compressed times and values
+        BitWriter bits(bin_file);
+        bits.write_times(samples.times());
+        bits.write_values(samples.values());
+        bits.flush();
+        break;
+      }
+
       default:
         throw Exception(__func__, "unhandled case");
     }
@@ -71,12 +88,14 @@ namespace codac
         break;
 
       case 2:
+      case 3: // the columnar version of tubes keeps the layout of trajectories
       {
         traj = new Trajectory();
 
         // Points number
         int pts_number;
         bin_file.read((char*)&pts_number, sizeof(int));
+        traj->m_samples.reserve(pts_number);
 
         for(int i = 0 ; i < pts_number ; i++)
         {
@@ -89,6 +108,28 @@ namespace codac
         break;
       }
 
+      case 4:
+      {
+        // Points number
+        int pts_number;
+        bin_file.read((char*)&pts_number, sizeof(int));
+
+        // Compressed times and values, decoded while being read
+        BitReader bits(bin_file);
+        vector<double> v_t(pts_number), v_x(pts_number);
+        bits.read_times(v_t);
+        bits.read_values(v_x);
+        bits.finish();
+
+        TrajectorySamples samples;
+        samples.reserve(pts_number);
+        for(int i = 0 ; i < pts_number ; i++)
+          samples.set(v_t[i], v_x[i]);
+
+        traj = pts_number == 0 ? new Trajectory() : new Trajectory(samples);
+        break;
+      }
+
       default:
         throw Exception(__func__, "deserialization version number not supported");
     }
@@ -124,5 +165,7 @@ namespace codac
       (*traj)[i] = *ptr;
       delete ptr;
     }
+
+    traj->share_tbase();
   }
 }
\ No newline at end of file
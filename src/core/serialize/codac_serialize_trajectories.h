@@ -36,6 +36,8 @@ namespace codac
    *   ...
    *
    * \note Only map valued trajectories are serializable
+   * \note Versions 2 and 3 share the same structure. In version 4, the number of points
+   *       is followed by the compressed times and values (see BitWriter).
    *
    * \param bin_file binary file (ofstream object)
    * \param traj Trajectory object to be serialized
@@ -8,8 +8,11 @@
  *              the GNU Lesser General Public License (LGPL).
  */
 
+#include <algorithm>
+#include <cstdint>
 #include "codac_serialize_tubes.h"
 #include "codac_serialize_intervals.h"
+#include "codac_BitStream.h"
 #include "codac_Exception.h"
 #include "codac_Tube.h"
 #include "codac_TubeVector.h"
@@ -20,6 +23,55 @@ using namespace ibex;
 
 namespace codac
 {
+  // Columns of interval bounds (serialization versions 3 and 4)
+
+  template<typename T>
+  static void swap_bytes(T *v, size_t n)
+  {
+    for(size_t i = 0 ; i < n ; i++)
+    {
+      char *b = (char*)&v[i];
+      reverse(b, b + sizeof(T));
+    }
+  }
+
+  static const vector<double> bounds_of_Intervals(const vector<Interval>& v_intv)
+  {
+    // Lower bounds, then upper bounds; empty sets are stored as [+oo,-oo]
+    vector<double> v_b(2 * v_intv.size());
+    for(size_t k = 0 ; k < v_intv.size() ; k++)
+    {
+      bool empty = v_intv[k].is_empty();
+      v_b[k] = empty ? POS_INFINITY : v_intv[k].lb();
+      v_b[v_intv.size() + k] = empty ? NEG_INFINITY : v_intv[k].ub();
+    }
+    return v_b;
+  }
+
+  static void set_Intervals_from_bounds(vector<Interval>& v_intv, const vector<double>& v_b)
+  {
+    for(size_t k = 0 ; k < v_intv.size() ; k++)
+    {
+      double lb = v_b[k], ub = v_b[v_intv.size() + k];
+      v_intv[k] = lb > ub ? Interval::EMPTY_SET : Interval(lb, ub);
+    }
+  }
+
+  static void serialize_Interval_bounds(ofstream& bin_file, const vector<Interval>& v_intv)
+  {
+    vector<double> v_b = bounds_of_Intervals(v_intv);
+    bin_file.write((const char*)v_b.data(), v_b.size() * sizeof(double));
+  }
+
+  static void deserialize_Interval_bounds(ifstream& bin_file, vector<Interval>& v_intv, bool swap)
+  {
+    vector<double> v_b(2 * v_intv.size());
+    bin_file.read((char*)v_b.data(), v_b.size() * sizeof(double));
+    if(swap)
+      swap_bytes(v_b.data(), v_b.size());
+    set_Intervals_from_bounds(v_intv, v_b);
+  }
+
   void serialize_Tube(ofstream& bin_file, const Tube& tube, int version_number)
   {
     if(!bin_file.is_open())
@@ -62,6 +114,48 @@ namespace codac
         break;
       }
 
+      case 3:
+      {
+        // Version number for compliance purposes
+        short int version = version_number;
+        bin_file.write((const char*)&version, sizeof(short int));
+
+        // Padding: the columns are aligned on 8 bytes in the file
+        const char padding[8] = { 0 };
+        bin_file.write(padding, (8 - bin_file.tellp() % 8) % 8);
+
+        uint32_t endianness_tag = 0x01020304;
+        bin_file.write((const char*)&endianness_tag, sizeof(uint32_t));
+
+        int32_t slices_number = tube.nb_slices();
+        bin_file.write((const char*)&slices_number, sizeof(int32_t));
+
+        // Columns, written in one operation each
+        const vector<double>& v_t = tube.m_slices->t_bounds();
+        bin_file.write((const char*)v_t.data(), v_t.size() * sizeof(double));
+        serialize_Interval_bounds(bin_file, tube.m_slices->codomains());
+        serialize_Interval_bounds(bin_file, tube.m_slices->gates());
+        break;
+      }
+
+      case 4:
+      {
+        // Version number for compliance purposes
+        short int version = version_number;
+        bin_file.write((const char*)&version, sizeof(short int));
+
+        int slices_number = tube.nb_slices();
+        bin_file.write((const char*)&slices_number, sizeof(int));
+
+        // Compressed columns
+        BitWriter bits(bin_file);
+        bits.write_times(tube.m_slices->t_bounds());
+        bits.write_values(bounds_of_Intervals(tube.m_slices->codomains()));
+        bits.write_values(bounds_of_Intervals(tube.m_slices->gates()));
+        bits.flush();
+        break;
+      }
+
       default:
         throw Exception(__func__, "unhandled case");
     }
@@ -76,6 +170,9 @@ namespace codac
     short int version_number;
     bin_file.read((char*)&version_number, sizeof(short int));
 
+    if(version_number == 0x0300) // version 3 written with another byte order,
+      version_number = 3; // the endianness tag is checked below
+
     switch(version_number)
     {
       case 1:
@@ -94,62 +191,96 @@ namespace codac
           throw Exception(__func__, "wrong slices number");
 
         // Creating slices
-        double lb;
-        bin_file.read((char*)&lb, sizeof(double));
-        Interval tube_tdomain(lb);
-
-        Slice *prev_slice = NULL, *slice = NULL;
-        for(int k = 0 ; k < slices_number ; k++)
-        {
-          double ub;
-          bin_file.read((char*)&ub, sizeof(double));
-          tube_tdomain |= Interval(lb, ub);
-
-          if(slice == NULL)
-          {
-            slice = new Slice(Interval(lb, ub));
-            tube->m_first_slice = slice;
-          }
-
-          else
-          {
-            slice->m_next_slice = new Slice(Interval(lb, ub));
-            slice = slice->next_slice();
-          }
-
-          if(prev_slice != NULL)
-          {
-            delete slice->m_input_gate;
-            slice->m_input_gate = NULL;
-            Slice::chain_slices(prev_slice, slice);
-          }
-
-          prev_slice = slice;
-          lb = ub;
-        }
-
-        // Codomains
-        for(Slice *s = tube->first_slice() ; s != NULL ; s = s->next_slice())
+        vector<double> v_t(slices_number + 1);
+        bin_file.read((char*)v_t.data(), (slices_number + 1) * sizeof(double));
+        tube->m_slices = new SlicesStorage(v_t);
+        Interval tube_tdomain = tube->m_slices->tdomain();
+
+        // Codomains and gates, read in bulk into the storage
+        vector<Interval>& v_codomains = tube->m_slices->m_v_codomains;
+        vector<Interval>& v_gates = tube->m_slices->m_v_gates;
+        deserialize_Intervals(bin_file, v_codomains.data(), slices_number);
+        deserialize_Intervals(bin_file, v_gates.data(), slices_number + 1);
+
+        // Gates are made consistent with the envelopes of their slices,
+        // as when they were set one by one (see Slice::set_input_gate())
+        for(int k = 0 ; k <= slices_number ; k++)
         {
-          Interval slice_value;
-          deserialize_Interval(bin_file, slice_value);
-          s->set(slice_value);
+          if(k > 0)
+            v_gates[k] &= v_codomains[k-1];
+          if(k < slices_number)
+            v_gates[k] &= v_codomains[k];
         }
 
         // Domain
-        tube_tdomain |= lb;
         tube->m_tdomain = tube_tdomain; // redundant information for fast access
+        break;
+      }
 
-        // Gates
-        Interval gate;
-        deserialize_Interval(bin_file, gate);
-        tube->first_slice()->set_input_gate(gate);
-        for(Slice *s = tube->first_slice() ; s != NULL ; s = s->next_slice())
-        {
-          deserialize_Interval(bin_file, gate);
-          s->set_output_gate(gate);
-        }
-        
+      case 3:
+      {
+        tube = new Tube();
+
+        // Padding
+        bin_file.seekg((8 - bin_file.tellg() % 8) % 8, ios::cur);
+
+        uint32_t endianness_tag;
+        bin_file.read((char*)&endianness_tag, sizeof(uint32_t));
+        bool swap = endianness_tag != 0x01020304;
+        if(swap && endianness_tag != 0x04030201)
+          throw Exception(__func__, "wrong endianness tag");
+
+        int32_t slices_number;
+        bin_file.read((char*)&slices_number, sizeof(int32_t));
+        if(swap)
+          swap_bytes(&slices_number, 1);
+
+        if(slices_number < 1)
+          throw Exception(__func__, "wrong slices number");
+
+        // Columns
+        vector<double> v_t(slices_number + 1);
+        bin_file.read((char*)v_t.data(), v_t.size() * sizeof(double));
+        if(swap)
+          swap_bytes(v_t.data(), v_t.size());
+
+        tube->m_slices = new SlicesStorage(v_t);
+        deserialize_Interval_bounds(bin_file, tube->m_slices->m_v_codomains, swap);
+        deserialize_Interval_bounds(bin_file, tube->m_slices->m_v_gates, swap);
+
+        if(!bin_file)
+          throw Exception(__func__, "unexpected end of file");
+
+        tube->m_tdomain = tube->m_slices->tdomain(); // redundant information for fast access
+        break;
+      }
+
+      case 4:
+      {
+        tube = new Tube();
+
+        // Slices number
+        int slices_number;
+        bin_file.read((char*)&slices_number, sizeof(int));
+
+        if(slices_number < 1)
+          throw Exception(__func__, "wrong slices number");
+
+        // Compressed columns, decoded while being read
+        BitReader bits(bin_file);
+        vector<double> v_t(slices_number + 1);
+        bits.read_times(v_t);
+        tube->m_slices = new SlicesStorage(v_t);
+
+        vector<double> v_b(2 * slices_number);
+        bits.read_values(v_b);
+        set_Intervals_from_bounds(tube->m_slices->m_v_codomains, v_b);
+        v_b.resize(2 * (slices_number + 1));
+        bits.read_values(v_b);
+        set_Intervals_from_bounds(tube->m_slices->m_v_gates, v_b);
+        bits.finish();
+
+        tube->m_tdomain = tube->m_slices->tdomain(); // redundant information for fast access
         break;
       }
 
@@ -178,7 +309,22 @@ namespace codac
 
     short int size;
     bin_file.read((char*)&size, sizeof(short int));
-    
+
+    // The byte order of the file is the one of its components: the version number
+    // of the first component is read (and then read again by deserialize_Tube())
+    if(size != 0)
+    {
+      streampos pos = bin_file.tellg();
+      short int version_number;
+      if(bin_file.read((char*)&version_number, sizeof(short int)) && version_number == 0x0300)
+        swap_bytes(&size, 1); // version 3 written with another byte order
+      bin_file.clear();
+      bin_file.seekg(pos);
+    }
+
+    if(size < 0)
+      throw Exception(__func__, "wrong dimension");
+
     tube->m_n = size;
     tube->m_v_tubes = new Tube[size];
     
@@ -186,7 +332,7 @@ namespace codac
     {
       Tube *ptr;
       deserialize_Tube(bin_file, ptr);
-      (*tube)[i] = *ptr;
+      (*tube)[i] = std::move(*ptr);
       delete ptr;
     }
   }
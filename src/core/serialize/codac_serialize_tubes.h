@@ -17,6 +17,8 @@
 namespace codac
 {
   #define SERIALIZATION_VERSION 2
+  #define SERIALIZATION_VERSION_COLUMNAR 3 // aligned layout, see serialize_Tube()
+  #define SERIALIZATION_VERSION_COMPRESSED 4 // compressed layout, see serialize_Tube()
 
   class Tube;
   class TubeVector;
@@ -25,9 +27,9 @@ namespace codac
   /// @{
 
   /**
-   * \brief Writes a Tube object into a binary file (version 2)
+   * \brief Writes a Tube object into a binary file (version 2, 3 or 4)
    * 
-   * Tube binary structure: <br>
+   * Tube binary structure (version 2): <br>
    *   [short_int_version_number] <br>
    *   [int_nb_slices] <br>
    *   [double_t0] <br>
@@ -41,6 +43,24 @@ namespace codac
    *   [gate_t1] <br>
    *   ...
    *
+   * Tube binary structure (version 3, columnar layout that can be memory-mapped, see MappedTube): <br>
+   *   [short_int_version_number] <br>
+   *   [padding] // zero bytes up to the next file offset multiple of 8 <br>
+   *   [uint32_endianness_tag] // 0x01020304 written with the byte order of the machine <br>
+   *   [int_nb_slices] <br>
+   *   [double_t0] ... [double_tn] // the n+1 time bounds <br>
+   *   [double_lb_y0] ... [double_lb_yn-1] // lower bounds of the slices <br>
+   *   [double_ub_y0] ... [double_ub_yn-1] // upper bounds of the slices <br>
+   *   [double_lb_gate_t0] ... [double_lb_gate_tn] // lower bounds of the gates <br>
+   *   [double_ub_gate_t0] ... [double_ub_gate_tn] // upper bounds of the gates
+   *
+   * Tube binary structure (version 4, compressed columns, see BitWriter): <br>
+   *   [short_int_version_number] <br>
+   *   [int_nb_slices] <br>
+   *   [compressed_stream] // time bounds, bounds of the slices, bounds of the gates
+   *
+   * In versions 3 and 4, empty sets are stored as \f$[+\infty,-\infty]\f$.
+   *
    * \param bin_file binary file (ofstream object)
    * \param tube Tube object to be serialized
    * \param version_number optional version number for tests purposes (backwards compatibility)
@@ -51,6 +71,7 @@ namespace codac
    * \brief Creates a Tube object from a binary file.
    *
    * The binary file has to be written by the serialize_Tube() function.
+   * Files of version 3 written on a machine of different byte order are supported.
    *
    * \param bin_file binary file (ifstream object)
    * \param tube Tube object to be deserialized
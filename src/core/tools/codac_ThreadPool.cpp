@@ -0,0 +1,199 @@
+/** 
+ *  ThreadPool class
+ * ----------------------------------------------------------------------------
+ *  \date       2021
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <memory>
+#include <cassert>
+#include <algorithm>
+#include "codac_ThreadPool.h"
+
+using namespace std;
+
+namespace codac
+{
+  // True for the threads currently computing a job (nested calls are then sequential)
+  static thread_local bool tl_in_job = false;
+
+  static unique_ptr<ThreadPool>& shared_pool()
+  {
+    static unique_ptr<ThreadPool> pool(new ThreadPool(1));
+    return pool;
+  }
+
+  int ThreadPool::s_grain_size = 1024;
+
+  // Public methods
+
+    // Definition
+
+    ThreadPool::ThreadPool(int nb_threads)
+    {
+      assert(nb_threads >= 0 && "invalid number of threads");
+      if(nb_threads == 0)
+        nb_threads = std::max(1, (int)std::thread::hardware_concurrency());
+
+      for(int i = 1 ; i < nb_threads ; i++) // the calling thread is the first one
+        m_v_threads.push_back(thread(&ThreadPool::worker_loop, this));
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+      {
+        lock_guard<mutex> lock(m_mutex);
+        m_stop = true;
+      }
+
+      m_cv_job.notify_all();
+      for(auto& t : m_v_threads)
+        t.join();
+    }
+
+    int ThreadPool::nb_threads() const
+    {
+      return m_v_threads.size() + 1;
+    }
+
+    int ThreadPool::nb_ranges(int n, int grain_size) const
+    {
+      assert(grain_size > 0);
+      if(m_v_threads.empty() || n <= grain_size)
+        return 1;
+      return (n + grain_size - 1) / grain_size;
+    }
+
+    // Computations
+
+    void ThreadPool::for_each_range(int n, int grain_size, const function<void(int,int)>& f)
+    {
+      assert(n >= 0 && grain_size > 0);
+
+      int nb = nb_ranges(n, grain_size);
+      if(nb <= 1 || tl_in_job || !m_run_mutex.try_lock())
+      {
+        if(n > 0)
+          f(0, n); // sequential computation
+        return;
+      }
+
+      lock_guard<mutex> run_lock(m_run_mutex, adopt_lock);
+
+      {
+        lock_guard<mutex> lock(m_mutex);
+        m_f = &f;
+        m_n = n;
+        m_grain_size = grain_size;
+        m_next_range = 0;
+        m_nb_ranges = nb;
+        m_nb_done_ranges = 0;
+        m_exception = nullptr;
+        m_job_id++;
+      }
+
+      m_cv_job.notify_all();
+
+      tl_in_job = true;
+      process_ranges();
+      tl_in_job = false;
+
+      exception_ptr e;
+
+      {
+        unique_lock<mutex> lock(m_mutex);
+        m_cv_done.wait(lock, [this] { return m_nb_done_ranges == m_nb_ranges; });
+        m_f = NULL;
+        e = m_exception;
+      }
+
+      if(e)
+        rethrow_exception(e);
+    }
+
+    // Shared pool
+
+    ThreadPool& ThreadPool::shared()
+    {
+      return *shared_pool();
+    }
+
+    void ThreadPool::set_nb_threads(int nb_threads)
+    {
+      assert(nb_threads >= 0 && "invalid number of threads");
+      shared_pool().reset(new ThreadPool(nb_threads));
+    }
+
+    void ThreadPool::set_grain_size(int grain_size)
+    {
+      assert(grain_size > 0 && "invalid grain size");
+      s_grain_size = grain_size;
+    }
+
+    int ThreadPool::grain_size()
+    {
+      return s_grain_size;
+    }
+
+  // Protected methods
+
+    void ThreadPool::worker_loop()
+    {
+      tl_in_job = true;
+      unsigned int job_id = 0;
+
+      while(true)
+      {
+        {
+          unique_lock<mutex> lock(m_mutex);
+          m_cv_job.wait(lock, [&] { return m_stop || m_job_id != job_id; });
+          if(m_stop)
+            return;
+          job_id = m_job_id;
+        }
+
+        process_ranges();
+      }
+    }
+
+    void ThreadPool::process_ranges()
+    {
+      while(true)
+      {
+        const function<void(int,int)> *f;
+        int k0, k1;
+
+        {
+          lock_guard<mutex> lock(m_mutex);
+          if(m_next_range == m_nb_ranges)
+            return;
+          f = m_f;
+          k0 = m_next_range * m_grain_size;
+          k1 = std::min(m_n, k0 + m_grain_size);
+          m_next_range++;
+        }
+
+        try
+        {
+          (*f)(k0, k1);
+        }
+
+        catch(...)
+        {
+          lock_guard<mutex> lock(m_mutex);
+          if(!m_exception)
+            m_exception = current_exception();
+        }
+
+        {
+          lock_guard<mutex> lock(m_mutex);
+          m_nb_done_ranges++;
+          if(m_nb_done_ranges == m_nb_ranges)
+            m_cv_done.notify_all();
+        }
+      }
+    }
+}
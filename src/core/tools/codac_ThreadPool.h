@@ -0,0 +1,197 @@
+/** 
+ *  \file
+ *  ThreadPool class
+ * ----------------------------------------------------------------------------
+ *  \date       2021
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_THREADPOOL_H__
+#define __CODAC_THREADPOOL_H__
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <algorithm>
+
+namespace codac
+{
+  /**
+   * \class ThreadPool
+   * \brief Set of threads waiting for ranges of indexes to be processed
+   *
+   * \note A range \f$[0,n)\f$ of indexes (for instance slices) is split into sub-ranges
+   *       of `grain_size` indexes, dynamically distributed over the threads. The calling
+   *       thread takes part in the computation.
+   * \note A shared pool is used by tube arithmetic and tube evaluations. It is sequential
+   *       by default (one thread), see `ThreadPool::set_nb_threads()`.
+   */
+  class ThreadPool
+  {
+    public:
+
+      /// \name Definition
+      /// @{
+
+      /**
+       * \brief Creates a pool of threads
+       *
+       * \param nb_threads number of threads, \f$n\geqslant 1\f$ (the calling thread included),
+       *        or \f$0\f$ for the number of concurrent threads supported by the implementation
+       */
+      explicit ThreadPool(int nb_threads);
+
+      /**
+       * \brief ThreadPool destructor, waiting for the threads to end
+       */
+      ~ThreadPool();
+
+      /**
+       * \brief Returns the number of threads of the pool, the calling thread included
+       *
+       * \return an integer
+       */
+      int nb_threads() const;
+
+      /**
+       * \brief Returns the number of sub-ranges that would be processed for \f$n\f$ indexes
+       *
+       * \param n the number of indexes
+       * \param grain_size minimal number of indexes processed at once
+       * \return an integer, 1 for a sequential computation
+       */
+      int nb_ranges(int n, int grain_size) const;
+
+      /// @}
+      /// \name Computations
+      /// @{
+
+      /**
+       * \brief Calls a function on sub-ranges covering \f$[0,n)\f$, possibly in parallel
+       *
+       * \note The computation is sequential if the pool has only one thread, if there is only one
+       *       sub-range, if the pool is already busy, or if called from one of the threads of the pool.
+       * \note An exception thrown by the function is rethrown once all the sub-ranges are processed
+       *
+       * \param n the number of indexes
+       * \param grain_size minimal number of indexes processed at once
+       * \param f the function called for each sub-range \f$[k_0,k_1)\f$
+       */
+      void for_each_range(int n, int grain_size, const std::function<void(int,int)>& f);
+
+      /**
+       * \brief Computes the inclusive prefix scan of a vector, possibly in parallel
+       *
+       * \note Each sub-range is scanned on its own, the prefixes of the sub-ranges are then
+       *       computed sequentially, and finally combined with the values of each sub-range.
+       * \note The operation must be associative, but not necessarily commutative.
+       *
+       * \param v the values, replaced by \f$(v_0, v_0\circ v_1, \dots, v_0\circ\dots\circ v_{n-1})\f$
+       * \param grain_size minimal number of values processed at once
+       * \param op the associative operation \f$(a,b)\mapsto a\circ b\f$, \f$a\f$ preceding \f$b\f$
+       */
+      template<typename T, typename Op>
+      void inclusive_scan(std::vector<T>& v, int grain_size, const Op& op)
+      {
+        const int n = v.size();
+        const int nb = nb_ranges(n, grain_size);
+        bool sequential = nb <= 1;
+
+        for_each_range(n, grain_size, [&](int k0, int k1)
+        {
+          if(k1 - k0 == n)
+            sequential = true; // the pool was busy: the whole vector is scanned at once
+          for(int k = k0 + 1 ; k < k1 ; k++)
+            v[k] = op(v[k-1], v[k]);
+        });
+
+        if(sequential)
+          return;
+
+        std::vector<T> v_prefixes(1, v[grain_size-1]);
+        for(int r = 1 ; r < nb - 1 ; r++)
+          v_prefixes.push_back(op(v_prefixes.back(), v[(r+1)*grain_size-1]));
+
+        for_each_range(n, grain_size, [&](int k0, int k1)
+        {
+          for(int k = std::max(k0, grain_size) ; k < k1 ; k++)
+            v[k] = op(v_prefixes[k/grain_size-1], v[k]);
+        });
+      }
+
+      /// @}
+      /// \name Shared pool
+      /// @{
+
+      /**
+       * \brief Returns the pool shared by tube arithmetic and tube evaluations
+       *
+       * \return a reference to the shared pool
+       */
+      static ThreadPool& shared();
+
+      /**
+       * \brief Sets the number of threads of the shared pool
+       *
+       * \note The pool must not be in use during this call
+       *
+       * \param nb_threads number of threads, \f$n\geqslant 1\f$ (1 by default, sequential computations),
+       *        or \f$0\f$ for the number of concurrent threads supported by the implementation
+       */
+      static void set_nb_threads(int nb_threads);
+
+      /**
+       * \brief Sets the minimal number of slices processed at once by a thread of the shared pool
+       *
+       * \note Tubes with less slices are processed sequentially
+       *
+       * \param grain_size number of slices, \f$n\geqslant 1\f$ (1024 by default)
+       */
+      static void set_grain_size(int grain_size);
+
+      /**
+       * \brief Returns the minimal number of slices processed at once by a thread of the shared pool
+       *
+       * \return an integer
+       */
+      static int grain_size();
+
+      /// @}
+
+    protected:
+
+      /**
+       * \brief Loop of the threads of the pool, waiting for jobs
+       */
+      void worker_loop();
+
+      /**
+       * \brief Processes the sub-ranges of the current job until none remains
+       */
+      void process_ranges();
+
+      // Class variables:
+
+        std::vector<std::thread> m_v_threads; //!< the threads of the pool, without the calling one
+        std::mutex m_run_mutex; //!< held during a parallel computation
+        std::mutex m_mutex; //!< protects the variables of the current job
+        std::condition_variable m_cv_job, m_cv_done; //!< notifications of a new job, or of its end
+
+        const std::function<void(int,int)> *m_f = NULL; //!< function of the current job
+        int m_n = 0, m_grain_size = 1; //!< indexes of the current job
+        int m_next_range = 0, m_nb_ranges = 0, m_nb_done_ranges = 0; //!< progression of the current job
+        unsigned int m_job_id = 0; //!< incremented for each new job
+        bool m_stop = false; //!< true when the threads have to end
+        std::exception_ptr m_exception; //!< first exception thrown during the current job
+
+        static int s_grain_size; //!< minimal number of slices processed at once
+  };
+}
+
+#endif
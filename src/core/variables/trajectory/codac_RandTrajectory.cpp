@@ -34,7 +34,7 @@ namespace codac
       for(t = tdomain.lb() ; t < tdomain.ub()+timestep ; t+=timestep)
       {
         double y = Tools::rand_in_bounds(bounds);
-        m_map_values[std::min(t,tdomain.ub())] = y;
+        m_samples.set(std::min(t,tdomain.ub()), y);
         m_codomain |= y;
       }
       m_tdomain = tdomain;
@@ -23,7 +23,7 @@ namespace codac
     Trajectory::Trajectory()
       : m_traj_def_type(TrajDefnType::MAP_OF_VALUES)
     {
-      m_map_values = map<double,double>();
+
     }
 
     Trajectory::Trajectory(const Trajectory& traj)
@@ -50,10 +50,14 @@ namespace codac
     }
 
     Trajectory::Trajectory(const map<double,double>& map_values)
-      : m_traj_def_type(TrajDefnType::MAP_OF_VALUES), m_map_values(map_values)
+      : m_traj_def_type(TrajDefnType::MAP_OF_VALUES)
     {
       assert(!map_values.empty());
 
+      m_samples.reserve(map_values.size());
+      for(const auto& it : map_values)
+        m_samples.set(it.first, it.second); // sorted keys: appended in constant time
+
       // Temporal domain:
       map<double,double>::const_iterator
         last_it = map_values.end(); last_it--; // accessing last value
@@ -73,9 +77,19 @@ namespace codac
           it_t != list_t.end() && it_x != list_x.end();
           ++it_t, ++it_x)
       {
-        m_map_values[*it_t] = *it_x;
+        m_samples.set(*it_t, *it_x);
         m_tdomain |= *it_t;
       }
+
+      compute_codomain();
+    }
+
+    Trajectory::Trajectory(const TrajectorySamples& samples)
+      : m_traj_def_type(TrajDefnType::MAP_OF_VALUES), m_samples(samples)
+    {
+      assert(!samples.empty());
+      m_tdomain = Interval(samples.times().front(), samples.times().back());
+      compute_codomain();
     }
 
     Trajectory::~Trajectory()
@@ -98,13 +112,14 @@ namespace codac
           break;
 
         case TrajDefnType::MAP_OF_VALUES:
-          m_map_values = x.m_map_values;
+          m_samples = x.m_samples;
           break;
 
         default:
           assert(false && "unhandled case");
       }
 
+      samples_updated();
       return *this;
     }
 
@@ -128,9 +143,24 @@ namespace codac
     const map<double,double>& Trajectory::sampled_map() const
     {
       assert(m_traj_def_type == TrajDefnType::MAP_OF_VALUES);
+
+      if(m_map_values_outdated)
+      {
+        m_map_values.clear();
+        for(int k = 0 ; k < m_samples.size() ; k++) // sorted keys: constant time insertions at the end
+          m_map_values.emplace_hint(m_map_values.end(), m_samples.times()[k], m_samples.values()[k]);
+        m_map_values_outdated = false;
+      }
+
       return m_map_values;
     }
 
+    const TrajectorySamples& Trajectory::samples() const
+    {
+      assert(m_traj_def_type == TrajDefnType::MAP_OF_VALUES);
+      return m_samples;
+    }
+
     const TFunction* Trajectory::tfunction() const
     {
       assert(m_traj_def_type == TrajDefnType::ANALYTIC_FNC);
@@ -152,22 +182,7 @@ namespace codac
           return m_function->eval(t).mid(); // /!\ an approximation is made here
 
         case TrajDefnType::MAP_OF_VALUES:
-          if(m_map_values.find(t) != m_map_values.end()) // key exists
-            return m_map_values.at(t);
-            // todo: optimize this to avoid double reading of the map?
-
-          else
-          {
-            typename map<double,double>::const_iterator it_lower, it_upper;
-            it_lower = m_map_values.lower_bound(t);
-            it_upper = it_lower;
-            it_lower--;
-
-            // Linear interpolation
-            return it_lower->second +
-                   (t - it_lower->first) * (it_upper->second - it_lower->second) /
-                   (it_upper->first - it_lower->first);
-          }
+          return m_samples.interpolate(t);
 
         default:
           assert(false && "unhandled case");
@@ -191,12 +206,7 @@ namespace codac
           break;
 
         case TrajDefnType::MAP_OF_VALUES:
-          eval |= (*this)(t.lb());
-          eval |= (*this)(t.ub());
-
-          for(map<double,double>::const_iterator it = m_map_values.lower_bound(t.lb()) ;
-              it != m_map_values.upper_bound(t.ub()) ; it++)
-            eval |= it->second;
+          eval = m_samples.hull(t);
           break;
 
         default:
@@ -214,7 +224,7 @@ namespace codac
           return m_function->eval(m_tdomain.lb()).mid(); // /!\ an approximation is made here
 
         case TrajDefnType::MAP_OF_VALUES:
-          return m_map_values.begin()->second;
+          return m_samples.values().front();
 
         default:
           assert(false && "unhandled case");
@@ -230,7 +240,7 @@ namespace codac
           return m_function->eval(m_tdomain.ub()).mid(); // /!\ an approximation is made here
 
         case TrajDefnType::MAP_OF_VALUES:
-          return m_map_values.rbegin()->second;
+          return m_samples.values().back();
 
         default:
           assert(false && "unhandled case");
@@ -248,7 +258,7 @@ namespace codac
           return m_function == NULL;
 
         case TrajDefnType::MAP_OF_VALUES:
-          return m_map_values.empty();
+          return m_samples.empty();
 
         default:
           assert(false && "unhandled case");
@@ -266,13 +276,10 @@ namespace codac
         if(m_tdomain != x.tdomain() || m_codomain != x.codomain())
           return false;
 
-        typename map<double,double>::const_iterator it_map;
-        for(it_map = m_map_values.begin() ; it_map != m_map_values.end() ; it_map++)
+        for(int k = 0 ; k < m_samples.size() ; k++)
         {
-          if(x.sampled_map().find(it_map->first) == x.sampled_map().end())
-            return false;
-
-          if(it_map->second != x.sampled_map().at(it_map->first))
+          int k_x = x.m_samples.find(m_samples.times()[k]);
+          if(k_x == -1 || m_samples.values()[k] != x.m_samples.values()[k_x])
             return false;
         }
 
@@ -299,11 +306,12 @@ namespace codac
       
       m_tdomain |= t;
 
-      bool update_codomain = m_map_values.find(t) != m_map_values.end() // key already exists
-            && m_codomain.contains(m_map_values.at(t)); // and new value inside codomain hull
+      int k = m_samples.find(t);
+      bool update_codomain = k != -1 // key already exists
+            && m_codomain.contains(m_samples.values()[k]); // and new value inside codomain hull
 
-      m_map_values.erase(t);
-      m_map_values.emplace(t, y);
+      m_samples.set(t, y);
+      samples_updated();
 
       if(update_codomain) // the new codomain may be a subset of the old one
         compute_codomain();
@@ -322,15 +330,10 @@ namespace codac
         double y_lb = (*this)(t.lb());
         double y_ub = (*this)(t.ub());
 
-        map<double,double>::iterator it = m_map_values.begin();
-        while(it != m_map_values.end())
-        {
-          if(!t.contains(it->first)) it = m_map_values.erase(it);
-          else ++it;
-        }
-
-        m_map_values[t.lb()] = y_lb; // clean truncation
-        m_map_values[t.ub()] = y_ub;
+        m_samples.truncate(t);
+        m_samples.set(t.lb(), y_lb); // clean truncation
+        m_samples.set(t.ub(), y_ub);
+        samples_updated();
       }
 
       m_tdomain &= t;
@@ -342,11 +345,8 @@ namespace codac
     {
       if(m_traj_def_type == TrajDefnType::MAP_OF_VALUES)
       {
-        map<double,double> map_temp = m_map_values;
-        m_map_values.clear();
-
-        for(map<double,double>::iterator it = map_temp.begin() ; it != map_temp.end() ; it++)
-          m_map_values.emplace(it->first + shift_ref, it->second);
+        m_samples.shift(shift_ref);
+        samples_updated();
       }
 
       m_tdomain += shift_ref;
@@ -358,16 +358,16 @@ namespace codac
     {
       assert(dt > 0.);
 
-      map<double,double> new_map;
+      TrajectorySamples new_samples;
       
       if(m_traj_def_type == TrajDefnType::MAP_OF_VALUES)
-        new_map = m_map_values;
+        new_samples = m_samples;
 
       double t;
       for(t = m_tdomain.lb() ; t < m_tdomain.ub() ; t+=dt)
-        if(new_map.find(t) == new_map.end()) // if key does not exist already
-          new_map[t] = (*this)(t); // evaluation/interpolation
-      new_map[m_tdomain.ub()] = (*this)(m_tdomain.ub());
+        if(new_samples.find(t) == -1) // if key does not exist already
+          new_samples.set(t, (*this)(t)); // evaluation/interpolation
+      new_samples.set(m_tdomain.ub(), (*this)(m_tdomain.ub()));
 
       if(m_traj_def_type == TrajDefnType::ANALYTIC_FNC)
       {
@@ -375,7 +375,8 @@ namespace codac
         delete m_function;
       }
 
-      m_map_values = new_map;
+      m_samples = new_samples;
+      samples_updated();
       // Note : no need to update the codomain, it will not be changed by this method.
       return *this;
     }
@@ -385,14 +386,36 @@ namespace codac
       assert(tdomain() == x.tdomain());
       assert(x.m_traj_def_type == TrajDefnType::MAP_OF_VALUES && "trajectory x has to be sampled");
       
-      map<double,double> new_map;
+      // Merging the two sorted lists of time keys
+      const vector<double>& v_t_x = x.m_samples.times();
+      TrajectorySamples new_samples;
+      new_samples.reserve(v_t_x.size() + (m_traj_def_type == TrajDefnType::MAP_OF_VALUES ? m_samples.size() : 0));
 
       if(m_traj_def_type == TrajDefnType::MAP_OF_VALUES)
-        new_map = m_map_values;
+      {
+        const vector<double>& v_t = m_samples.times();
+        size_t i = 0, j = 0;
+        while(i < v_t.size() || j < v_t_x.size())
+        {
+          if(j == v_t_x.size() || (i < v_t.size() && v_t[i] <= v_t_x[j]))
+          {
+            if(j < v_t_x.size() && v_t[i] == v_t_x[j])
+              j++;
+            new_samples.set(v_t[i], m_samples.values()[i]);
+            i++;
+          }
 
-      for(auto const& it : x.sampled_map())
-        if(new_map.find(it.first) == new_map.end()) // if key does not exist already
-          new_map[it.first] = (*this)(it.first); // evaluation/interpolation
+          else
+          {
+            new_samples.set(v_t_x[j], (*this)(v_t_x[j])); // interpolation
+            j++;
+          }
+        }
+      }
+
+      else
+        for(const auto& t : v_t_x)
+          new_samples.set(t, (*this)(t)); // evaluation
 
       if(m_traj_def_type == TrajDefnType::ANALYTIC_FNC)
       {
@@ -400,7 +423,8 @@ namespace codac
         delete m_function;
       }
 
-      m_map_values = new_map;
+      m_samples = new_samples;
+      samples_updated();
       // Note : no need to update the codomain, it will not be changed by this method.
       return *this;
     }
@@ -414,24 +438,22 @@ namespace codac
       m_codomain = Interval::EMPTY_SET;
 
       double prev_value = 0., value_mod = 0.;
-      map<double,double> m_continuous_values(m_map_values);
 
-      for(const auto& it : m_map_values)
+      for(int k = 0 ; k < m_samples.size() ; k++)
       {
-        if(!m_continuous_values.empty())
-        {
-          if(prev_value - it.second > periodicity.diam()*0.9)
-            value_mod += periodicity.diam();
-          else if(prev_value - it.second < -periodicity.diam()*0.9)
-            value_mod -= periodicity.diam();
-        }
+        double value = m_samples.values()[k];
 
-        prev_value = it.second;
-        m_continuous_values[it.first] += value_mod;
-        m_codomain |= m_continuous_values[it.first];
+        if(prev_value - value > periodicity.diam()*0.9)
+          value_mod += periodicity.diam();
+        else if(prev_value - value < -periodicity.diam()*0.9)
+          value_mod -= periodicity.diam();
+
+        prev_value = value;
+        m_samples.set_value(k, value + value_mod);
+        m_codomain |= value + value_mod;
       }
 
-      m_map_values = m_continuous_values;
+      samples_updated();
       return *this;
     }
 
@@ -442,18 +464,17 @@ namespace codac
       assert(m_traj_def_type == TrajDefnType::MAP_OF_VALUES
         && "integration timestep requested for trajectories defined by TFunction");
       
-      double val;
+      double val = c;
       Trajectory x;
+      const vector<double> &v_t = m_samples.times(), &v_x = m_samples.values();
+      x.m_samples.reserve(v_t.size());
 
-      for(map<double,double>::const_iterator it = m_map_values.begin() ; it != m_map_values.end() ; it++)
+      for(size_t k = 0 ; k < v_t.size() ; k++)
       {
-        if(it == m_map_values.begin())
-          val = c;
-
-        else
-          val += (prev(it)->second + it->second) * (it->first - prev(it)->first) / 2.;
+        if(k != 0)
+          val += (v_x[k-1] + v_x[k]) * (v_t[k] - v_t[k-1]) / 2.;
 
-        x.set(val, it->first);
+        x.set(val, v_t[k]);
       }
 
       return x;
@@ -495,18 +516,21 @@ namespace codac
 
         case TrajDefnType::MAP_OF_VALUES: // finite difference computation
         {
-          assert(m_map_values.size() > 1);
+          assert(m_samples.size() > 1);
+
+          const vector<double>& v_t = m_samples.times();
+          d.m_samples.reserve(v_t.size());
           
-          double prev_t = m_map_values.begin()->first;
-          for(map<double,double>::const_iterator it = m_map_values.begin() ; it != m_map_values.end() ; it++)
+          double prev_t = v_t[0];
+          for(int k = 0 ; k < m_samples.size() ; k++)
           {
-            double h = it->first - prev_t;
+            double h = v_t[k] - prev_t;
 
             if(h == 0.) // first value
-              h = next(m_map_values.begin())->first - prev_t;
+              h = v_t[1] - prev_t;
 
-            d.set(finite_diff(it->first, h), it->first);
-            prev_t = it->first;
+            d.set(finite_diff_index(k, h), v_t[k]);
+            prev_t = v_t[k];
           }
 
           assert(d.tdomain() == tdomain());
@@ -522,39 +546,70 @@ namespace codac
 
     double Trajectory::finite_diff(double t, double h) const
     {
-      // todo: improve this with h not symmetric?
       assert(m_traj_def_type == TrajDefnType::MAP_OF_VALUES);
-      assert(m_map_values.find(t) != m_map_values.end()); // key exists
-      assert(m_map_values.size() > 2);
+      assert(m_samples.find(t) != -1); // key exists
+      return finite_diff_index(m_samples.find(t), h);
+    }
 
-      vector<double> fwd;
-      map<double,double>::const_iterator it_fwd = m_map_values.find(t);
-      double x = it_fwd->second;
+    // String
+    
+    std::ostream& operator<<(std::ostream& str, const Trajectory& x)
+    {
+      str << "Trajectory " << x.tdomain() << "↦" << x.codomain();
 
-      it_fwd++;
-      while(fwd.size() < 4 && it_fwd != m_map_values.end())
+      switch(x.m_traj_def_type)
       {
-        fwd.push_back(it_fwd->second);
-        it_fwd++;
-      }
+        case TrajDefnType::ANALYTIC_FNC:
+          str << " (Fnc object)";
+          break;
 
-      vector<double> bwd;
-      map<double,double>::const_iterator it_bwd = m_map_values.find(t);
+        case TrajDefnType::MAP_OF_VALUES:
+          if(x.m_samples.size() < 10)
+          {
+            str << ", " << x.m_samples.size() << " pts: { ";
+            for(int k = 0 ; k < x.m_samples.size() ; k++)
+              str << "(" << x.m_samples.times()[k] << "," << x.m_samples.values()[k] << ") ";
+            str << "} ";
+          }
 
-      if(it_bwd != m_map_values.begin())
-      {
-        it_bwd--;
-        while(bwd.size() < 4)
-        {
-          bwd.push_back(it_bwd->second);
-          if(it_bwd == m_map_values.begin())
-            break;
-          it_bwd--;
-        }
+          else
+            str << ", " << x.m_samples.size() << " points";
+
+          break;
+
+        default:
+          str << " (def ERROR)";
+          break;
       }
 
-      if(fwd.size() == bwd.size()) // central finite difference
-        switch(fwd.size())
+      str << flush;
+      return str;
+    }
+
+  // Protected methods
+
+    double Trajectory::finite_diff_index(int k, double h) const
+    {
+      // todo: improve this with h not symmetric?
+      assert(m_traj_def_type == TrajDefnType::MAP_OF_VALUES);
+      assert(k >= 0 && k < m_samples.size());
+      assert(m_samples.size() > 2);
+
+      const vector<double>& v_x = m_samples.values();
+      double x = v_x[k];
+
+      // Up to 4 values before and after the kth one, without allocation
+      double fwd[4], bwd[4];
+      int nb_fwd = 0, nb_bwd = 0;
+
+      for(int i = k+1 ; nb_fwd < 4 && i < m_samples.size() ; i++)
+        fwd[nb_fwd++] = v_x[i];
+
+      for(int i = k-1 ; nb_bwd < 4 && i >= 0 ; i--)
+        bwd[nb_bwd++] = v_x[i];
+
+      if(nb_fwd == nb_bwd) // central finite difference
+        switch(nb_fwd)
         {
           case 1:
             return ((-1./2.)*bwd[0] + (1./2.)*fwd[0]) / h;
@@ -569,8 +624,8 @@ namespace codac
             return 0.;
         }
 
-      else if(fwd.size() > bwd.size()) // forward finite difference
-        switch(fwd.size())
+      else if(nb_fwd > nb_bwd) // forward finite difference
+        switch(nb_fwd)
         {
           case 1:
             return ((-1./1.)*x + (1./1.)*fwd[0]) / h;
@@ -586,7 +641,7 @@ namespace codac
         }
 
       else // backward finite difference
-        switch(bwd.size())
+        switch(nb_bwd)
         {
           case 1:
             return ((1./1.)*x + (-1./1.)*bwd[0]) / h;
@@ -602,43 +657,6 @@ namespace codac
         }
     }
 
-    // String
-    
-    std::ostream& operator<<(std::ostream& str, const Trajectory& x)
-    {
-      str << "Trajectory " << x.tdomain() << "↦" << x.codomain();
-
-      switch(x.m_traj_def_type)
-      {
-        case TrajDefnType::ANALYTIC_FNC:
-          str << " (Fnc object)";
-          break;
-
-        case TrajDefnType::MAP_OF_VALUES:
-          if(x.m_map_values.size() < 10)
-          {
-            str << ", " << x.m_map_values.size() << " pts: { ";
-            for(map<double,double>::const_iterator it = x.m_map_values.begin() ; it != x.m_map_values.end() ; it++)
-              str << "(" << it->first << "," << it->second << ") ";
-            str << "} ";
-          }
-
-          else
-            str << ", " << x.m_map_values.size() << " points";
-
-          break;
-
-        default:
-          str << " (def ERROR)";
-          break;
-      }
-
-      str << flush;
-      return str;
-    }
-
-  // Protected methods
-
     const IntervalVector Trajectory::codomain_box() const
     {
       return IntervalVector(m_codomain);
@@ -653,13 +671,16 @@ namespace codac
           break;
 
         case TrajDefnType::MAP_OF_VALUES:
-          m_codomain = Interval::EMPTY_SET;
-          for(map<double,double>::iterator it = m_map_values.begin() ; it != m_map_values.end() ; it++)
-            m_codomain |= it->second;
+          m_codomain = m_samples.hull();
           break;
 
         default:
           assert(false && "unhandled case");
       }
     }
-}
\ No newline at end of file
+
+    void Trajectory::samples_updated()
+    {
+      m_map_values_outdated = true;
+    }
+}
@@ -16,6 +16,7 @@
 #include <list>
 #include "codac_DynamicalItem.h"
 #include "codac_TFunction.h"
+#include "codac_TrajectorySamples.h"
 #include "codac_traj_arithmetic.h"
 
 namespace codac
@@ -80,6 +81,13 @@ namespace codac
        */
       explicit Trajectory(const std::list<double>& list_t, const std::list<double>& list_x);
 
+      /**
+       * \brief Creates a scalar trajectory \f$x(\cdot)\f$ from a set of samples
+       *
+       * \param samples TrajectorySamples object (non empty) defining the trajectory
+       */
+      explicit Trajectory(const TrajectorySamples& samples);
+
       /**
        * \brief Creates a copy of a scalar trajectory \f$x(\cdot)\f$
        *
@@ -128,10 +136,20 @@ namespace codac
       /**
        * \brief Returns the map of values, if the object is defined as a map
        *
+       * \note The values are stored in contiguous arrays (see `samples()`): the map is
+       *       built on demand and kept until the next modification of the trajectory.
+       *
        * \return a map<t,y> of values, or an empty map
        */
       const std::map<double,double>& sampled_map() const;
 
+      /**
+       * \brief Returns the sampled values, if the object is defined as a map
+       *
+       * \return a const reference to the contiguous TrajectorySamples storage
+       */
+      const TrajectorySamples& samples() const;
+
       /**
        * \brief Returns the temporal function, if the object is an analytic trajectory
        *
@@ -442,6 +460,20 @@ namespace codac
        */
       void compute_codomain();
 
+      /**
+       * \brief Computes the finite difference at the kth sample
+       *
+       * \param k the index of the sample
+       * \param h temporal timestep around \f$t_k\f$
+       * \return the derivative value
+       */
+      double finite_diff_index(int k, double h) const;
+
+      /**
+       * \brief Notifies a modification of the sampled values (the map built by `sampled_map()` is outdated)
+       */
+      void samples_updated();
+
       // Class variables:
 
         Interval m_tdomain = Interval::EMPTY_SET; //!< temporal domain \f$[t_0,t_f]\f$ of the trajectory
@@ -453,11 +485,15 @@ namespace codac
         //union
         //{
           TFunction *m_function = NULL; //!< optional pointer to the analytic expression of this trajectory
-          std::map<double,double> m_map_values; //!< optional map of values <t,y>: \f$x(t)=y\f$
+          TrajectorySamples m_samples; //!< optional sampled values <t,y>: \f$x(t)=y\f$
         //};
 
+        mutable std::map<double,double> m_map_values; //!< map of the sampled values, built on demand by `sampled_map()`
+        mutable bool m_map_values_outdated = true; //!< `true` if m_map_values has to be built again
+
       friend void deserialize_Trajectory(std::ifstream& bin_file, Trajectory *&traj);
       friend void deserialize_TrajectoryVector(std::ifstream& bin_file, TrajectoryVector *&traj);
+      friend class TrajectoryVector; // for operations on a shared time base
   };
 }
 
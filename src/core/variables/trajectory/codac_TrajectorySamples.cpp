@@ -0,0 +1,293 @@
+/** 
+ *  TrajectorySamples class
+ * ----------------------------------------------------------------------------
+ *  \date       2021
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#include <algorithm>
+#include <cassert>
+#include "codac_TrajectorySamples.h"
+
+using namespace std;
+using namespace ibex;
+
+namespace codac
+{
+  // Public methods
+
+    // Definition
+
+    TrajectorySamples::TrajectorySamples()
+      : m_v_t(make_shared<vector<double> >())
+    {
+
+    }
+
+    int TrajectorySamples::size() const
+    {
+      return m_v_x.size();
+    }
+
+    bool TrajectorySamples::empty() const
+    {
+      return m_v_x.empty();
+    }
+
+    const vector<double>& TrajectorySamples::times() const
+    {
+      return *m_v_t;
+    }
+
+    const vector<double>& TrajectorySamples::values() const
+    {
+      return m_v_x;
+    }
+
+    bool TrajectorySamples::shares_times(const TrajectorySamples& x) const
+    {
+      return m_v_t == x.m_v_t;
+    }
+
+    void TrajectorySamples::share_times(const TrajectorySamples& x)
+    {
+      assert(times() == x.times());
+      m_v_t = x.m_v_t;
+    }
+
+    // Accessing values
+
+    int TrajectorySamples::find(double t) const
+    {
+      if(empty() || t < m_v_t->front() || t > m_v_t->back())
+        return -1;
+
+      int k = lower_index(t);
+      return (*m_v_t)[k] == t ? k : -1;
+    }
+
+    int TrajectorySamples::lower_index(double t) const
+    {
+      assert(!empty() && t >= m_v_t->front());
+
+      int n = size();
+      if(t >= m_v_t->back())
+        return n - 1;
+
+      // Fast path for (nearly) uniform samplings: the index is estimated
+      // from the mean timestep, and then locally corrected
+      double dt = (m_v_t->back() - m_v_t->front()) / (n - 1);
+      int k = std::min(n - 2, (int)((t - m_v_t->front()) / dt));
+
+      for(int i = 0 ; i < 3 ; i++)
+      {
+        if((*m_v_t)[k] > t)
+          k--;
+        else if((*m_v_t)[k+1] <= t)
+          k++;
+        else
+          return k;
+      }
+
+      // Otherwise, binary search
+      return upper_bound(m_v_t->begin(), m_v_t->end(), t) - m_v_t->begin() - 1;
+    }
+
+    double TrajectorySamples::interpolate(double t) const
+    {
+      assert(!empty() && Interval(m_v_t->front(), m_v_t->back()).contains(t));
+
+      return interpolate(t, lower_index(t));
+    }
+
+    double TrajectorySamples::interpolate(double t, int k) const
+    {
+      assert(k >= 0 && k < size() && (*m_v_t)[k] <= t);
+
+      if((*m_v_t)[k] == t) // key exists
+        return m_v_x[k];
+
+      // Linear interpolation
+      return m_v_x[k] + (t - (*m_v_t)[k]) * (m_v_x[k+1] - m_v_x[k]) / ((*m_v_t)[k+1] - (*m_v_t)[k]);
+    }
+
+    const Interval TrajectorySamples::hull(const Interval& t) const
+    {
+      assert(!empty() && Interval(m_v_t->front(), m_v_t->back()).is_superset(t));
+
+      Interval eval = Interval::EMPTY_SET;
+      eval |= interpolate(t.lb());
+      eval |= interpolate(t.ub());
+
+      // Samples strictly inside the interpolated bounds
+      eval |= hull(lower_index(t.lb()) + 1, lower_index(t.ub()));
+      return eval;
+    }
+
+    const Interval TrajectorySamples::hull(int k0, int kf) const
+    {
+      assert(k0 >= 0 && kf < size());
+
+      if(k0 > kf)
+        return Interval::EMPTY_SET;
+
+      if(kf - k0 < HULL_TREE_MIN_RANGE) // small ranges are directly scanned
+      {
+        auto minmax = minmax_element(m_v_x.begin() + k0, m_v_x.begin() + kf + 1);
+        return Interval(*minmax.first, *minmax.second);
+      }
+
+      if(m_hull_tree_outdated)
+        build_hull_tree();
+
+      // Bottom-up traversal of the segment tree
+      Interval eval = Interval::EMPTY_SET;
+      int capacity = m_v_hull_tree.size() / 2;
+      for(int l = k0 + capacity, r = kf + capacity + 1 ; l < r ; l /= 2, r /= 2)
+      {
+        if(l % 2 == 1) eval |= m_v_hull_tree[l++];
+        if(r % 2 == 1) eval |= m_v_hull_tree[--r];
+      }
+
+      return eval;
+    }
+
+    const Interval TrajectorySamples::hull() const
+    {
+      if(empty())
+        return Interval::EMPTY_SET;
+
+      if(!m_hull_tree_outdated)
+        return m_v_hull_tree[1]; // root of the tree
+
+      auto minmax = minmax_element(m_v_x.begin(), m_v_x.end());
+      return Interval(*minmax.first, *minmax.second);
+    }
+
+    // Setting values
+
+    void TrajectorySamples::reserve(int n)
+    {
+      m_v_t->reserve(n); // no modification of the (possibly shared) keys
+      m_v_x.reserve(n);
+    }
+
+    void TrajectorySamples::clear()
+    {
+      if(m_v_t.use_count() > 1)
+        m_v_t = make_shared<vector<double> >(); // shared keys are left unchanged
+      else
+        m_v_t->clear();
+      m_v_x.clear();
+      m_hull_tree_outdated = true;
+    }
+
+    void TrajectorySamples::set(double t, double x)
+    {
+      if(empty() || t > m_v_t->back()) // append-optimized
+      {
+        detach_times();
+        m_v_t->push_back(t);
+        m_v_x.push_back(x);
+        update_hull_tree(size() - 1);
+        return;
+      }
+
+      int k = t < m_v_t->front() ? -1 : lower_index(t);
+
+      if(k != -1 && (*m_v_t)[k] == t) // key already exists
+        set_value(k, x);
+
+      else
+      {
+        detach_times();
+        m_v_t->insert(m_v_t->begin() + k + 1, t);
+        m_v_x.insert(m_v_x.begin() + k + 1, x);
+        m_hull_tree_outdated = true; // shifted leaves
+      }
+    }
+
+    void TrajectorySamples::set_value(int k, double x)
+    {
+      assert(k >= 0 && k < size());
+      m_v_x[k] = x;
+      update_hull_tree(k);
+    }
+
+    void TrajectorySamples::truncate(const Interval& t)
+    {
+      detach_times();
+      int k0 = lower_bound(m_v_t->begin(), m_v_t->end(), t.lb()) - m_v_t->begin();
+      int kf = upper_bound(m_v_t->begin(), m_v_t->end(), t.ub()) - m_v_t->begin();
+
+      m_v_t->erase(m_v_t->begin() + kf, m_v_t->end());
+      m_v_x.erase(m_v_x.begin() + kf, m_v_x.end());
+      m_v_t->erase(m_v_t->begin(), m_v_t->begin() + k0);
+      m_v_x.erase(m_v_x.begin(), m_v_x.begin() + k0);
+      m_hull_tree_outdated = true;
+    }
+
+    void TrajectorySamples::shift(double a)
+    {
+      detach_times();
+      for(auto& t : *m_v_t)
+        t += a;
+    }
+
+  // Protected methods
+
+    void TrajectorySamples::detach_times()
+    {
+      if(m_v_t.use_count() > 1) // copy-on-write of shared time keys
+        m_v_t = make_shared<vector<double> >(*m_v_t);
+    }
+
+    void TrajectorySamples::push_back_shared_time(double t)
+    {
+      assert(m_v_t->empty() || t > m_v_t->back());
+      m_v_t->push_back(t);
+    }
+
+    void TrajectorySamples::push_back_value(double x)
+    {
+      assert(m_v_x.size() < m_v_t->size());
+      m_v_x.push_back(x);
+      update_hull_tree(size() - 1);
+    }
+
+    void TrajectorySamples::build_hull_tree() const
+    {
+      int capacity = 1;
+      while(capacity <= size())
+        capacity *= 2;
+
+      m_v_hull_tree.assign(2 * capacity, Interval::EMPTY_SET);
+      for(int k = 0 ; k < size() ; k++)
+        m_v_hull_tree[capacity + k] = Interval(m_v_x[k]);
+      for(int i = capacity - 1 ; i > 0 ; i--)
+        m_v_hull_tree[i] = m_v_hull_tree[2*i] | m_v_hull_tree[2*i+1];
+
+      m_hull_tree_outdated = false;
+    }
+
+    void TrajectorySamples::update_hull_tree(int k) const
+    {
+      if(m_hull_tree_outdated)
+        return; // the tree will be built at the next query
+
+      int capacity = m_v_hull_tree.size() / 2;
+      if(k >= capacity)
+      {
+        m_hull_tree_outdated = true; // the capacity will be doubled
+        return;
+      }
+
+      int i = capacity + k;
+      m_v_hull_tree[i] = Interval(m_v_x[k]);
+      for(i /= 2 ; i > 0 ; i /= 2)
+        m_v_hull_tree[i] = m_v_hull_tree[2*i] | m_v_hull_tree[2*i+1];
+    }
+}
@@ -0,0 +1,260 @@
+/** 
+ *  \file
+ *  TrajectorySamples class
+ * ----------------------------------------------------------------------------
+ *  \date       2021
+ *  \author     Simon Rohou
+ *  \copyright  Copyright 2021 Codac Team
+ *  \license    This program is distributed under the terms of
+ *              the GNU Lesser General Public License (LGPL).
+ */
+
+#ifndef __CODAC_TRAJECTORYSAMPLES_H__
+#define __CODAC_TRAJECTORYSAMPLES_H__
+
+#include <vector>
+#include <memory>
+#include "codac_Interval.h"
+
+namespace codac
+{
+  class TrajectoryVector;
+
+  /**
+   * \class TrajectorySamples
+   * \brief Contiguous storage of the sampled values of a one dimensional trajectory
+   *
+   * \note The \f$n\f$ increasing time keys \f$t_0<\dots<t_{n-1}\f$ and their values
+   *       \f$x_0,\dots,x_{n-1}\f$ are stored in two parallel vectors. Appending a sample
+   *       after the last one is done in amortized constant time.
+   * \note Time keys are indexed by a binary search, except for (nearly) uniform samplings
+   *       for which the index is directly estimated from the mean timestep: \f$\mathcal{O}(1)\f$.
+   * \note The hull of the values over a range of samples is computed from a segment tree,
+   *       lazily built at the first large query: \f$\mathcal{O}(\log(n))\f$. The tree is
+   *       updated when values are set or appended, and built again after other modifications.
+   * \note The time keys can be shared by several sets of samples (for instance the components
+   *       of a TrajectoryVector), and are copied before being modified (copy-on-write).
+   */
+  class TrajectorySamples
+  {
+    public:
+
+      /// \name Definition
+      /// @{
+
+      /**
+       * \brief Creates an empty set of samples
+       */
+      TrajectorySamples();
+
+      /**
+       * \brief Returns the number of samples
+       *
+       * \return an integer
+       */
+      int size() const;
+
+      /**
+       * \brief Returns `true` if there is no sample
+       *
+       * \return a boolean
+       */
+      bool empty() const;
+
+      /**
+       * \brief Returns the time keys of the samples
+       *
+       * \return a const reference to the vector of the \f$n\f$ increasing time keys
+       */
+      const std::vector<double>& times() const;
+
+      /**
+       * \brief Returns the values of the samples
+       *
+       * \return a const reference to the vector of the \f$n\f$ values
+       */
+      const std::vector<double>& values() const;
+
+      /**
+       * \brief Returns `true` if the time keys are shared with another set of samples
+       *
+       * \param x the other TrajectorySamples object
+       * \return a boolean
+       */
+      bool shares_times(const TrajectorySamples& x) const;
+
+      /**
+       * \brief Shares the (equal) time keys of another set of samples, to save memory
+       *
+       * \param x the TrajectorySamples object defined on the same time keys
+       */
+      void share_times(const TrajectorySamples& x);
+
+      /// @}
+      /// \name Accessing values
+      /// @{
+
+      /**
+       * \brief Returns the index of a time key
+       *
+       * \param t the temporal key
+       * \return the index \f$k\f$ such that \f$t_k=t\f$, or -1 if the key does not exist
+       */
+      int find(double t) const;
+
+      /**
+       * \brief Returns the index of the last sample defined before \f$t\f$
+       *
+       * \param t the temporal key, not lower than \f$t_0\f$
+       * \return the largest index \f$k\f$ such that \f$t_k\leqslant t\f$
+       */
+      int lower_index(double t) const;
+
+      /**
+       * \brief Returns the linear interpolation of the values at \f$t\f$
+       *
+       * \param t the temporal key, in \f$[t_0,t_{n-1}]\f$
+       * \return the value at \f$t\f$
+       */
+      double interpolate(double t) const;
+
+      /**
+       * \brief Returns the linear interpolation of the values at \f$t\f$,
+       *        from a known lower index (no search)
+       *
+       * \param t the temporal key, in \f$[t_k,t_{k+1}]\f$
+       * \param k the index of the last sample defined before \f$t\f$, see `lower_index()`
+       * \return the value at \f$t\f$
+       */
+      double interpolate(double t, int k) const;
+
+      /**
+       * \brief Returns the hull of the interpolated values over \f$[t]\f$
+       *
+       * \param t the subtdomain, subset of \f$[t_0,t_{n-1}]\f$
+       * \return the hull of the samples in \f$[t]\f$ and of the values at its bounds
+       */
+      const Interval hull(const Interval& t) const;
+
+      /**
+       * \brief Returns the hull of the values of the samples from index \f$k_0\f$ to index \f$k_f\f$
+       *
+       * \param k0 index of the first sample
+       * \param kf index of the last sample (included)
+       * \return an Interval object, empty if \f$k_0>k_f\f$
+       */
+      const Interval hull(int k0, int kf) const;
+
+      /**
+       * \brief Returns the hull of all the values
+       *
+       * \return an Interval object, empty if there is no sample
+       */
+      const Interval hull() const;
+
+      /// @}
+      /// \name Setting values
+      /// @{
+
+      /**
+       * \brief Reserves memory for the given number of samples
+       *
+       * \param n expected number of samples
+       */
+      void reserve(int n);
+
+      /**
+       * \brief Removes all the samples
+       */
+      void clear();
+
+      /**
+       * \brief Sets the value \f$x\f$ at \f$t\f$, possibly replacing a previous one
+       *
+       * \note Constant time if \f$t\f$ is greater than the last time key
+       *
+       * \param t the temporal key
+       * \param x the value
+       */
+      void set(double t, double x);
+
+      /**
+       * \brief Sets the value of the kth sample
+       *
+       * \param k the index of the sample
+       * \param x the new value
+       */
+      void set_value(int k, double x);
+
+      /**
+       * \brief Removes the samples outside \f$[t]\f$
+       *
+       * \param t the interval of time keys to be kept
+       */
+      void truncate(const Interval& t);
+
+      /**
+       * \brief Shifts all the time keys
+       *
+       * \param a the offset value so that \f$t_k:=t_k+a\f$
+       */
+      void shift(double a);
+
+      /// @}
+
+    protected:
+
+      /**
+       * \brief Copies the time keys if they are shared, before their modification
+       */
+      void detach_times();
+
+      /**
+       * \brief Appends a time key to the (possibly shared) time keys, without copy
+       *
+       * \note The values of all the sets of samples sharing the keys
+       *       have then to be appended with `push_back_value()`
+       *
+       * \param t the temporal key, greater than the last one
+       */
+      void push_back_shared_time(double t);
+
+      /**
+       * \brief Appends a value for the last time key, previously added by `push_back_shared_time()`
+       *
+       * \param x the value
+       */
+      void push_back_value(double x);
+
+      /**
+       * \brief Builds the segment tree of the hulls of the values
+       *
+       * \note The capacity of the tree is the smallest power of two greater
+       *       than the number of samples, so that appended values can be inserted in the tree
+       */
+      void build_hull_tree() const;
+
+      /**
+       * \brief Updates the segment tree after the modification of the kth value
+       *
+       * \note The tree is marked as outdated if the kth leaf exceeds its capacity
+       *
+       * \param k the index of the modified sample
+       */
+      void update_hull_tree(int k) const;
+
+      // Class variables:
+
+        std::shared_ptr<std::vector<double> > m_v_t; //!< increasing time keys of the samples, possibly shared
+        std::vector<double> m_v_x; //!< values of the samples
+
+        mutable std::vector<Interval> m_v_hull_tree; //!< segment tree of hulls, leaves stored from the index equal to the capacity
+        mutable bool m_hull_tree_outdated = true; //!< `true` if the segment tree has to be built again
+
+        static const int HULL_TREE_MIN_RANGE = 32; //!< number of samples below which a range is scanned without the tree
+
+      friend class TrajectoryVector;
+  };
+}
+
+#endif
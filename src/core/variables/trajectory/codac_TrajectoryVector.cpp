@@ -57,10 +57,8 @@ namespace codac
       {
         assert((size() == 0 // nothing added yet
              || size() == it_map->second.size()) && "vectors of map_values of different dimensions");
-        set(it_map->second, it_map->first);
+        set(it_map->second, it_map->first); // sorted keys: appended on a shared time base
       }
-
-      // todo: optimize this by building Trajectory objects here directly?
     }
 
     TrajectoryVector::TrajectoryVector(const vector<map<double,double> >& v_map_values)
@@ -69,6 +67,7 @@ namespace codac
       assert(!v_map_values.empty());
       for(int i = 0 ; i < size() ; i++)
         (*this)[i] = Trajectory(v_map_values[i]);
+      share_tbase();
     }
     
     TrajectoryVector::TrajectoryVector(const list<double>& list_t, const list<Vector>& list_x)
@@ -89,8 +88,6 @@ namespace codac
         assert(it_x->size() == n);
         set(*it_x, *it_t);
       }
-
-      // todo: optimize this by building Trajectory objects here directly?
     }
 
     TrajectoryVector::TrajectoryVector(int n, const Trajectory& x)
@@ -210,8 +207,18 @@ namespace codac
     {
       assert(tdomain().contains(t));
       Vector v(size());
-      for(int i = 0 ; i < size() ; i++)
-        v[i] = (*this)[i](t);
+
+      if(shared_tbase()) // one temporal search for all the components
+      {
+        int k = m_v_trajs[0].m_samples.lower_index(t);
+        for(int i = 0 ; i < size() ; i++)
+          v[i] = m_v_trajs[i].m_samples.interpolate(t, k);
+      }
+
+      else
+        for(int i = 0 ; i < size() ; i++)
+          v[i] = (*this)[i](t);
+
       return v;
     }
     
@@ -219,8 +226,25 @@ namespace codac
     {
       assert(tdomain().is_superset(t));
       IntervalVector v(size());
-      for(int i = 0 ; i < size() ; i++)
-        v[i] = (*this)[i](t);
+
+      if(shared_tbase()) // one temporal search for all the components
+      {
+        int k_lb = m_v_trajs[0].m_samples.lower_index(t.lb());
+        int k_ub = m_v_trajs[0].m_samples.lower_index(t.ub());
+
+        for(int i = 0 ; i < size() ; i++)
+        {
+          const TrajectorySamples& samples = m_v_trajs[i].m_samples;
+          v[i] = samples.hull(k_lb + 1, k_ub);
+          v[i] |= samples.interpolate(t.lb(), k_lb);
+          v[i] |= samples.interpolate(t.ub(), k_ub);
+        }
+      }
+
+      else
+        for(int i = 0 ; i < size() ; i++)
+          v[i] = (*this)[i](t);
+
       return v;
     }
     
@@ -239,6 +263,17 @@ namespace codac
         v[i] = (*this)[i].last_value();
       return v;
     }
+
+    const Vector TrajectoryVector::sampled_value(int k) const
+    {
+      assert(shared_tbase());
+      assert(k >= 0 && k < m_v_trajs[0].m_samples.size());
+
+      Vector v(size());
+      for(int i = 0 ; i < size() ; i++)
+        v[i] = m_v_trajs[i].m_samples.values()[k];
+      return v;
+    }
     
     // Tests
 
@@ -250,6 +285,19 @@ namespace codac
       return false;
     }
 
+    bool TrajectoryVector::shared_tbase() const
+    {
+      if(size() == 0)
+        return false;
+
+      for(int i = 0 ; i < size() ; i++)
+        if(m_v_trajs[i].definition_type() != TrajDefnType::MAP_OF_VALUES
+          || !m_v_trajs[i].m_samples.shares_times(m_v_trajs[0].m_samples))
+          return false;
+
+      return true;
+    }
+
     bool TrajectoryVector::operator==(const TrajectoryVector& x) const
     {
       if(size() != x.size())
@@ -281,24 +329,54 @@ namespace codac
       }
 
       assert(size() == y.size());
+
+      if(shared_tbase() && !m_v_trajs[0].not_defined() && t > tdomain().ub()
+        && m_v_trajs[0].m_samples.m_v_t.use_count() == size()) // time keys not shared with other objects
+      {
+        // The time key is appended once for all the components
+        m_v_trajs[0].m_samples.push_back_shared_time(t);
+
+        for(int i = 0 ; i < size() ; i++)
+        {
+          Trajectory& x = m_v_trajs[i];
+          x.m_samples.push_back_value(y[i]);
+          x.m_tdomain |= t;
+          x.m_codomain |= y[i];
+          x.samples_updated();
+        }
+
+        return;
+      }
+
+      bool share = not_defined() || shared_tbase();
+
       for(int i = 0 ; i < size() ; i++)
         (*this)[i].set(y[i], t);
+
+      if(share)
+        share_tbase();
     }
 
     TrajectoryVector& TrajectoryVector::truncate_tdomain(const Interval& t)
     {
       assert(valid_tdomain(t));
       assert(tdomain().is_superset(t));
+      bool share = shared_tbase();
       for(int i = 0 ; i < size() ; i++)
         if(!(*this)[i].not_defined())
           (*this)[i].truncate_tdomain(t);
+      if(share)
+        share_tbase();
       return *this;
     }
 
     TrajectoryVector& TrajectoryVector::shift_tdomain(double shift_ref)
     {
+      bool share = shared_tbase();
       for(int i = 0 ; i < size() ; i++)
         (*this)[i].shift_tdomain(shift_ref);
+      if(share)
+        share_tbase();
       return *this;
     }
     
@@ -314,6 +392,7 @@ namespace codac
     {
       for(int i = 0 ; i < size() ; i++)
         (*this)[i].sample(dt);
+      share_tbase();
       return *this;
     }
 
@@ -321,6 +400,7 @@ namespace codac
     {
       for(int i = 0 ; i < size() ; i++)
         (*this)[i].sample(x);
+      share_tbase();
       return *this;
     }
 
@@ -329,6 +409,7 @@ namespace codac
       assert(size() == x.size());
       for(int i = 0 ; i < size() ; i++)
         (*this)[i].sample(x[i]);
+      share_tbase();
       return *this;
     }
     
@@ -385,4 +466,17 @@ namespace codac
         box[i] |= (*this)[i].codomain();
       return box;
     }
+
+    void TrajectoryVector::share_tbase()
+    {
+      for(int i = 0 ; i < size() ; i++)
+        if(m_v_trajs[i].definition_type() != TrajDefnType::MAP_OF_VALUES)
+          return;
+
+      const TrajectorySamples& samples = m_v_trajs[0].m_samples;
+      for(int i = 1 ; i < size() ; i++)
+        if(!m_v_trajs[i].m_samples.shares_times(samples)
+          && m_v_trajs[i].m_samples.times() == samples.times())
+          m_v_trajs[i].m_samples.share_times(samples);
+    }
 }
\ No newline at end of file
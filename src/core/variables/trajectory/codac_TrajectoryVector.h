@@ -228,6 +228,14 @@ namespace codac
        */
       const Vector last_value() const;
 
+      /**
+       * \brief Returns the kth sampled value, when the components share the same time base
+       *
+       * \param k the index of the sample
+       * \return the vector \f$\mathbf{x}(t_k)\f$
+       */
+      const Vector sampled_value(int k) const;
+
       /// @}
       /// \name Tests
       /// @{
@@ -240,6 +248,16 @@ namespace codac
        */
       bool not_defined() const;
 
+      /**
+       * \brief Tests whether the components are sampled on a single shared time base
+       *
+       * \note In this case, the time keys are stored once for all the components,
+       *       and the evaluations involve only one temporal search
+       *
+       * \return true if all the components are maps of values sharing the same time keys
+       */
+      bool shared_tbase() const;
+
       /**
        * \brief Returns true if this trajectory is equal to \f$\mathbf{x}(\cdot)\f$
        *
@@ -511,6 +529,11 @@ namespace codac
        */
       const IntervalVector codomain_box() const;
 
+      /**
+       * \brief Shares the time keys of the components, if they are all sampled on the same times
+       */
+      void share_tbase();
+
       // Class variables:
 
         int m_n = 0; //!< dimension of this trajectory
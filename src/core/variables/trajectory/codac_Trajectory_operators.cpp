@@ -22,8 +22,9 @@ namespace codac
       assert(definition_type() == TrajDefnType::MAP_OF_VALUES && \
         "not supported yet for trajectories defined by a Function"); \
       \
-      for(auto& kv : m_map_values) \
-        m_map_values[kv.first] = kv.second f x; \
+      for(int k = 0 ; k < m_samples.size() ; k++) \
+        m_samples.set_value(k, m_samples.values()[k] f x); \
+      samples_updated(); \
       m_codomain.fdef(x); \
       return *this; \
     } \
@@ -38,11 +39,14 @@ namespace codac
       if(definition_type() == TrajDefnType::MAP_OF_VALUES) \
         x_sampled.sample(*this); \
       \
-      map<double,double> new_map; \
-      for(auto const& it : x_sampled.sampled_map()) \
-        new_map[it.first] = (*this)(it.first) f it.second; \
+      const TrajectorySamples& x_samples = x_sampled.samples(); \
+      TrajectorySamples new_samples; \
+      new_samples.reserve(x_samples.size()); \
+      for(int k = 0 ; k < x_samples.size() ; k++) \
+        new_samples.set(x_samples.times()[k], (*this)(x_samples.times()[k]) f x_samples.values()[k]); \
       \
-      m_map_values = new_map; \
+      m_samples = new_samples; \
+      samples_updated(); \
       compute_codomain(); \
       return *this; \
     } \
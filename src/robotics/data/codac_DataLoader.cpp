@@ -44,7 +44,7 @@ namespace codac
 
   void DataLoader::serialize_data(const TubeVector& x, const TrajectoryVector& traj) const
   {
-    x.serialize(m_file_path + DATA_FILE_EXTENSION, traj);
+    x.serialize(m_file_path + DATA_FILE_EXTENSION, traj, SERIALIZATION_VERSION_COMPRESSED);
   }
   
   bool DataLoader::serialized_data_available() const
@@ -413,12 +413,12 @@ namespace codac
         traj_colormap = m_map_trajs[traj].color_map.second;
 
     if((*traj)[index_x].definition_type() == TrajDefnType::MAP_OF_VALUES
-        && (*traj)[index_x].sampled_map().size() != 0)
+        && (*traj)[index_x].samples().size() != 0)
     {
       const Trajectory *displayed_traj_x, *displayed_traj_y;
       Trajectory *temp_displayed_traj_x = NULL, *temp_displayed_traj_y = NULL; // possibly used in case of heavy trajectories
 
-      if((*traj)[index_x].sampled_map().size() > m_traj_max_nb_disp_points) // heavy trajectories
+      if((*traj)[index_x].samples().size() > m_traj_max_nb_disp_points) // heavy trajectories
       {
         // Computing a trajectory less discretized
         
@@ -442,33 +442,30 @@ namespace codac
         displayed_traj_y = &(*traj)[index_y];
       }
 
-      typename map<double,double>::const_iterator it_scalar_values_x, it_scalar_values_y;
-      it_scalar_values_x = displayed_traj_x->sampled_map().begin();
-      it_scalar_values_y = displayed_traj_y->sampled_map().begin();
+      const TrajectorySamples &samples_x = displayed_traj_x->samples(), &samples_y = displayed_traj_y->samples();
 
-      while(it_scalar_values_x != displayed_traj_x->sampled_map().end())
+      for(int k = 0 ; k < samples_x.size() ; k++)
       {
-        if(m_restricted_tdomain.contains(it_scalar_values_x->first))
+        double t = samples_x.times()[k], x = samples_x.values()[k], y = samples_y.values()[k];
+
+        if(m_restricted_tdomain.contains(t))
         {
           if(points_size != 0.)
-            vibes::drawPoint(it_scalar_values_x->second, it_scalar_values_y->second,
+            vibes::drawPoint(x, y,
                              points_size,
                              vibesParams("figure", name(), "group", group_name));
 
           else
           {
-            v_x.push_back(it_scalar_values_x->second);
-            v_y.push_back(it_scalar_values_y->second);
+            v_x.push_back(x);
+            v_y.push_back(y);
             if(m_map_trajs[traj].color == "")
-              v_colors.push_back(rgb2hex(m_map_trajs[traj].color_map.first.color(it_scalar_values_x->first, *traj_colormap)));
+              v_colors.push_back(rgb2hex(m_map_trajs[traj].color_map.first.color(t, *traj_colormap)));
           }
         }
 
-        viewbox[0] |= Interval(it_scalar_values_x->second);
-        viewbox[1] |= Interval(it_scalar_values_y->second);
-
-        it_scalar_values_x++;
-        it_scalar_values_y++;
+        viewbox[0] |= Interval(x);
+        viewbox[1] |= Interval(y);
       }
 
       if(temp_displayed_traj_x != NULL)
@@ -1,6 +1,9 @@
 #include "catch_interval.hpp"
 #include "codac_tube_arithmetic.h"
 #include "codac_traj_arithmetic.h"
+#include "codac_TFunction.h"
+#include "codac_Exception.h"
+#include "codac_ThreadPool.h"
 
 using namespace Catch;
 using namespace Detail;
@@ -533,6 +536,179 @@ TEST_CASE("Arithmetic on tubes")
 }
 
 
+TEST_CASE("Parallel arithmetic on tubes")
+{
+  Tube x(Interval(0.,10.), 0.001), y(x);
+  for(int k = 0 ; k < x.nb_slices() ; k++)
+  {
+    x.set(Interval(cos(k*0.01)).inflate(0.1), k);
+    y.set(Interval(sin(k*0.01)).inflate(0.2), k);
+  }
+
+  TubeVector v(2, x);
+  v[1] = y;
+
+  // Sequential results
+  Tube a = cos(x), b = x*y + 2.*x, c = pow(y, 3) | sqr(x), d = -atan2(x, y);
+  TubeVector e = v + v;
+  TFunction f("x1", "x2", "(x1+sin(t)*x2 ; x1*x2)");
+  TubeVector g = f.eval_vector(v);
+
+  ThreadPool::set_nb_threads(4);
+  ThreadPool::set_grain_size(64);
+  CHECK(ThreadPool::shared().nb_threads() == 4);
+  CHECK(ThreadPool::shared().nb_ranges(x.nb_slices(), ThreadPool::grain_size()) == (x.nb_slices() + 63) / 64);
+
+  CHECK(cos(x) == a);
+  CHECK(x*y + 2.*x == b);
+  CHECK((pow(y, 3) | sqr(x)) == c);
+  CHECK(-atan2(x, y) == d);
+  CHECK(v + v == e);
+  CHECK(f.eval_vector(v) == g);
+
+  SECTION("Exceptions thrown in the threads")
+  {
+    int nb_calls = 0;
+    std::mutex m;
+
+    CHECK_THROWS(ThreadPool::shared().for_each_range(1000, 10, [&](int k0, int k1)
+    {
+      { std::lock_guard<std::mutex> lock(m); nb_calls++; }
+      if(k0 == 500)
+        throw Exception("test", "error in a thread");
+    }));
+
+    CHECK(nb_calls == 100); // all the ranges are processed
+  }
+
+  ThreadPool::set_nb_threads(1);
+  ThreadPool::set_grain_size(1024);
+  CHECK(ThreadPool::shared().nb_ranges(x.nb_slices(), ThreadPool::grain_size()) == 1);
+}
+
+TEST_CASE("Lazy expressions on tubes")
+{
+  Tube x(Interval(0.,10.), 0.01), y(x), z(x);
+  for(int k = 0 ; k < x.nb_slices() ; k++)
+  {
+    x.set(Interval(cos(k*0.01)).inflate(0.1), k);
+    y.set(Interval(sin(k*0.01)).inflate(0.2), k);
+    z.set(Interval(k*0.001).inflate(0.05), k);
+  }
+
+  SECTION("Fused evaluation")
+  {
+    // Step by step evaluation with intermediate tubes
+    Tube a = sin(y);
+    Tube b = 2.*a;
+    Tube c = x + b;
+    Tube d = c - z;
+
+    Tube e = x + 2.*sin(y) - z;
+    CHECK(e == d);
+    CHECK(Tube::same_slicing(e, x));
+    CHECK(x + 2.*sin(y) - z == d);
+    CHECK(ApproxIntv((x + 2.*sin(y) - z).codomain()) == d.codomain());
+    CHECK((x + 2.*sin(y) - z).tdomain() == x.tdomain());
+
+    Tube f = sqr(x + y) / (1. + exp(-z));
+    Tube g = x + y, h = -z, i = exp(h), j = 1. + i, l = sqr(g);
+    CHECK(f == l / j);
+    CHECK(atan2(x, y + 1.) == atan2(x, Tube(y + 1.)));
+    CHECK((pow(x + y, 3) | root(abs(z), 2)) == (Tube(pow(g, 3)) | Tube(root(Tube(abs(z)), 2))));
+  }
+
+  SECTION("Accessors of expressions")
+  {
+    Tube e = x + 2.*sin(y) - z;
+    CHECK((x + 2.*sin(y) - z).nb_slices() == e.nb_slices());
+    CHECK(ApproxIntv(Interval((x + 2.*sin(y) - z).volume())) == Interval(e.volume()));
+    CHECK((x + 2.*sin(y) - z)(5.) == e(5.)); // gate
+    CHECK((x + 2.*sin(y) - z)(5.005) == e(5.005));
+    CHECK((x + 2.*sin(y) - z)(Interval(2.5,6.)) == e(Interval(2.5,6.)));
+    CHECK((x + 2.*sin(y) - z)(Interval(2.505,6.003)) == e(Interval(2.505,6.003)));
+    CHECK((x + 2.*sin(y) - z)(Interval(11.)) == Interval::all_reals());
+    CHECK(sin(x).nb_slices() == x.nb_slices());
+
+    Tube w(Interval(0.,10.), 0.5);
+    w.set(Interval(-1.,2.));
+    Tube f = x*w + 1.; // different slicings
+    CHECK((x*w + 1.).nb_slices() == f.nb_slices());
+    CHECK((x*w + 1.).volume() == f.volume());
+    CHECK((x*w + 1.)(Interval(2.5,6.)) == f(Interval(2.5,6.)));
+    CHECK((x*w + 1.)(5.005) == f(5.005));
+  }
+
+  SECTION("In-place assignment")
+  {
+    Tube expected = cos(x) * y;
+    x = cos(x) * y; // x is an operand of the expression
+    CHECK(x == expected);
+
+    expected = x + x;
+    x = x + x;
+    CHECK(x == expected);
+  }
+
+  SECTION("Different slicings")
+  {
+    Tube w(Interval(0.,10.), 0.5);
+    w.set(Interval(-1.,2.));
+
+    // Eager evaluation on resampled copies
+    Tube x_(x), w_(w);
+    x_.sample(w); w_.sample(x);
+    Tube expected(x_);
+    for(int k = 0 ; k < expected.nb_slices() ; k++)
+    {
+      expected.slice(k)->set_envelope(x_.slice(k)->codomain() * w_.slice(k)->codomain() + 1., false);
+      expected.slice(k)->set_input_gate(x_.slice(k)->input_gate() * w_.slice(k)->input_gate() + 1., false);
+    }
+    expected.last_slice()->set_output_gate(x_.last_slice()->output_gate() * w_.last_slice()->output_gate() + 1., false);
+
+    CHECK(x*w + 1. == expected);
+    CHECK(w*x + 1. == expected);
+
+    Tube v = w;
+    v = x*w + 1.; // v is resampled
+    CHECK(v == expected);
+  }
+
+  SECTION("Temporary operands")
+  {
+    Tube p = x.primitive();
+    Tube expected = sqr(p) + 1.;
+
+    // The temporary tubes are owned by the expressions
+    auto e1 = sqr(x.primitive()) + 1.; // const temporary
+    auto e2 = Tube(x.primitive()) * y; // non-const temporary
+    auto e3 = e1 - Tube(z) + min(Tube(y), Tube(z));
+    CHECK(Tube(e1) == expected);
+    CHECK(Tube(e2) == p * y);
+    CHECK(Tube(e3) == expected - z + min(y, z));
+  }
+
+  SECTION("Reassignment of a moved-from tube")
+  {
+    Tube expected = x + z;
+    Tube a(x);
+    Tube b(std::move(a));
+    CHECK(b == x);
+    CHECK(a.nb_slices() == 0);
+    CHECK(!Tube::same_slicing(a, b));
+
+    a = b + z; // a has no slices: the expression is evaluated in a new tube
+    CHECK(a == expected);
+    CHECK(Tube::same_slicing(a, x));
+
+    Tube c(z);
+    c = std::move(a); // a now holds the previous slices of c
+    CHECK(c == expected);
+    a = c - z;
+    CHECK(a == expected - z);
+  }
+}
+
 TEST_CASE("Arithmetic on trajs")
 {
   SECTION("Tests scalar traj")
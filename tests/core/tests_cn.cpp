@@ -1,3 +1,6 @@
+#include <fstream>
+#include <sstream>
+#include <chrono>
 #include "catch_interval.hpp"
 #include "codac_ContractorNetwork.h"
 #include "codac_CtcDeriv.h"
@@ -480,4 +483,456 @@ TEST_CASE("CN simple")
     //cn.contract();
     CHECK(x.codomain() == IntervalVector(2, 0.));
   }*/
-}
\ No newline at end of file
+}
+
+TEST_CASE("CN large tubes")
+{
+  SECTION("Registration of a tube with many slices")
+  {
+    Tube x(Interval(0.,100.), 0.01), v(Interval(0.,100.), 0.01);
+    int n = x.nb_slices();
+    CHECK(n == 10000);
+
+    ContractorNetwork cn;
+    CtcDeriv ctc_deriv;
+    cn.add(ctc_deriv, {x, v});
+
+    // 2 tubes, 2n slices, 2n components contractors and n CtcDeriv contractors
+    CHECK(cn.nb_dom() == 2*n+2);
+    CHECK(cn.nb_ctc() == 3*n);
+
+    cn.add(ctc_deriv, {x, v}); // redundant contractors that should not be added
+    cn.add(ctc_deriv, {*x.slice(0), *v.slice(0)});
+    CHECK(cn.nb_dom() == 2*n+2);
+    CHECK(cn.nb_ctc() == 3*n);
+  }
+}
+
+TEST_CASE("CN parallel propagation")
+{
+  SECTION("Slice-level CtcDeriv")
+  {
+    double dt = 0.5;
+    Interval tdomain(0.,10.);
+    vector<Tube> v_x;
+
+    for(int nb_threads : { 1, 2, 4, 0 })
+    {
+      Tube x(tdomain, dt), v(tdomain, dt, Interval(-1.,1.));
+      x.set(0., 0.);
+      x.set(Interval(-1.,1.), 10.);
+
+      CtcDeriv ctc_deriv;
+      ContractorNetwork cn;
+      CHECK(cn.nb_threads() == 1);
+      cn.set_nb_threads(nb_threads);
+      CHECK(cn.nb_threads() >= 1);
+      cn.add(ctc_deriv, {x, v});
+      cn.contract();
+
+      CHECK(cn.nb_ctc_in_stack() == 0);
+      CHECK(x.codomain() == Interval(-5.5,5.5));
+      CHECK(x(5.) == Interval(-5.,5.));
+      v_x.push_back(x);
+    }
+
+    // Same fixed point for any number of threads
+    for(size_t i = 1 ; i < v_x.size() ; i++)
+      CHECK(v_x[i] == v_x[0]);
+  }
+}
+
+TEST_CASE("CN scheduling policies")
+{
+  SECTION("Same fixed point for each policy")
+  {
+    double dt = 0.5;
+    Interval tdomain(0.,10.);
+
+    for(auto policy : { ContractorNetwork::SchedulingPolicy::LIFO,
+                        ContractorNetwork::SchedulingPolicy::FIFO,
+                        ContractorNetwork::SchedulingPolicy::PRIORITY })
+      for(int nb_threads : { 1, 4 })
+      {
+        Tube x(tdomain, dt), v(tdomain, dt, Interval(-1.,1.));
+        x.set(0., 0.);
+        x.set(Interval(-1.,1.), 10.);
+
+        CtcDeriv ctc_deriv;
+        ContractorNetwork cn;
+        CHECK(cn.scheduling_policy() == ContractorNetwork::SchedulingPolicy::LIFO);
+        cn.set_scheduling_policy(policy);
+        CHECK(cn.scheduling_policy() == policy);
+        cn.set_nb_threads(nb_threads);
+        cn.add(ctc_deriv, {x, v});
+        cn.contract();
+
+        CHECK(cn.nb_ctc_in_stack() == 0);
+        CHECK(x.codomain() == Interval(-5.5,5.5));
+        CHECK(x(5.) == Interval(-5.,5.));
+        CHECK(x(2.) == Interval(-2.,2.));
+        CHECK(x(8.) == Interval(-3.,3.));
+
+        // Contracting again after an external update of the domains
+        x.set(Interval(0.), 10.);
+        cn.trigger_all_contractors();
+        cn.contract();
+
+        CHECK(cn.nb_ctc_in_stack() == 0);
+        CHECK(x.codomain() == Interval(-5.,5.));
+        CHECK(x(8.) == Interval(-2.,2.));
+      }
+  }
+}
+
+TEST_CASE("CN profiling")
+{
+  SECTION("Export of the contractors statistics")
+  {
+    Tube x(Interval(0.,10.), 1.), v(Interval(0.,10.), 1., Interval(-1.,1.));
+    x.set(0., 0.);
+
+    CtcDeriv ctc_deriv;
+    ContractorNetwork cn;
+    cn.add(ctc_deriv, {x, v});
+    cn.contract();
+
+    cn.export_profiling_csv("cn_profiling.csv");
+    cn.export_profiling_json("cn_profiling.json");
+    cn.print_dot_graph("cn_profiling", "fdp", true);
+
+    ifstream csv_file("cn_profiling.csv");
+    string line;
+    int nb_lines = 0, nb_calls = 0;
+    getline(csv_file, line);
+    CHECK(line == "id,name,type,nb_domains,nb_calls,nb_triggers,total_time,mean_time,total_reduction");
+    while(getline(csv_file, line))
+    {
+      nb_lines++;
+      // Number of calls: fifth field (names are quoted and do not contain commas here)
+      stringstream ss(line);
+      string field;
+      for(int i = 0 ; i < 5 ; i++)
+        getline(ss, field, ',');
+      nb_calls += stoi(field);
+    }
+
+    CHECK(nb_lines == cn.nb_ctc());
+    CHECK(nb_calls >= cn.nb_ctc()); // each contractor has been called at least once
+
+    ifstream json_file("cn_profiling.json");
+    getline(json_file, line);
+    CHECK(line == "[");
+
+    cn.reset_profiling();
+    cn.export_profiling_csv("cn_profiling.csv");
+    ifstream csv_file_reset("cn_profiling.csv");
+    getline(csv_file_reset, line);
+    nb_calls = 0;
+    while(getline(csv_file_reset, line))
+    {
+      stringstream ss(line);
+      string field;
+      for(int i = 0 ; i < 5 ; i++)
+        getline(ss, field, ',');
+      nb_calls += stoi(field);
+    }
+
+    CHECK(nb_calls == 0);
+  }
+}
+
+TEST_CASE("CN anytime propagation")
+{
+  SECTION("Interrupted and resumed propagation")
+  {
+    Interval tdomain(0.,10.);
+    Tube x_ref(tdomain, 0.5), v_ref(tdomain, 0.5, Interval(-1.,1.));
+    x_ref.set(0., 0.);
+    x_ref.set(Interval(-1.,1.), 10.);
+    Tube x(x_ref), v(v_ref);
+
+    CtcDeriv ctc_deriv;
+    ContractorNetwork cn_ref, cn;
+    cn_ref.add(ctc_deriv, {x_ref, v_ref});
+    cn.add(ctc_deriv, {x, v});
+    cn_ref.contract();
+
+    // Deadline already reached: nothing is done
+    int nb_ctc = cn.nb_ctc_in_stack();
+    cn.contract_until(chrono::steady_clock::now());
+    CHECK(cn.nb_ctc_in_stack() == nb_ctc);
+    cn.contract_during(0.);
+    CHECK(cn.nb_ctc_in_stack() == nb_ctc);
+
+    // Interruption from the callback, after a few calls
+    int nb_calls = 0;
+    cn.set_callback([&nb_calls]() { nb_calls++; return nb_calls < 5; });
+    cn.contract();
+    CHECK(nb_calls == 5);
+    CHECK(cn.nb_ctc_in_stack() != 0);
+
+    // Resuming the propagation
+    cn.set_callback(nullptr);
+    cn.contract_until(chrono::steady_clock::now() + chrono::seconds(60));
+    CHECK(cn.nb_ctc_in_stack() == 0);
+    CHECK(x == x_ref);
+  }
+}
+
+TEST_CASE("CN streaming")
+{
+  SECTION("Sliding window on realtime data")
+  {
+    double dt = 0.1, horizon = 2.;
+    Tube x(Interval(0.,1.), dt), v(Interval(0.,1.), dt);
+    x.set(0., 0.);
+
+    CtcDeriv ctc_deriv;
+    ContractorNetwork cn;
+    cn.set_streaming(dt, horizon);
+    CHECK(cn.streaming());
+    cn.add(ctc_deriv, {x, v});
+
+    int nb_dom_max = 0, nb_ctc_max = 0;
+    for(double t = 0. ; t < 20. ; t += 0.05)
+    {
+      cn.add_data(v, t, Interval(1.));
+      cn.contract();
+      nb_dom_max = std::max(nb_dom_max, cn.nb_dom());
+      nb_ctc_max = std::max(nb_ctc_max, cn.nb_ctc());
+    }
+
+    // The size of the graph only depends on the horizon
+    CHECK(x.tdomain().ub() >= 19.95);
+    CHECK(x.tdomain().lb() > 17.);
+    CHECK(x.tdomain() == v.tdomain());
+    CHECK(x.nb_slices() <= 25);
+    CHECK(nb_dom_max < 2*(25+1)+2);
+    CHECK(nb_ctc_max < 3*(25+1)+2);
+
+    // The propagation through the evicted slices is kept by the first gate
+    double t0 = x.tdomain().lb();
+    CHECK(x(t0).is_superset(Interval(t0)));
+    CHECK(x(t0).diam() < 1e-6);
+    const Slice *s = x.slice(19.);
+    CHECK(ApproxIntv(s->input_gate()) == Interval(s->tdomain().lb()));
+    CHECK(ApproxIntv(s->codomain()) == s->tdomain());
+    CHECK(cn.evicted_codomain(x).is_superset(Interval(0.,17.)));
+    CHECK(cn.evicted_codomain(x).is_subset(Interval(0.,t0)));
+    CHECK(cn.evicted_codomain(v) == Interval(1.));
+  }
+
+  SECTION("Removal of single entries of the registry")
+  {
+    struct Key // keys with colliding hashes
+    {
+      int v;
+      size_t hash() const { return (v % 5) * 3; }
+      bool operator==(const Key& k) const { return v == k.v; }
+    };
+
+    HashRegistry<Key,int> reg;
+    for(int v = 0 ; v < 40 ; v++)
+      reg.insert({ v }, 10*v);
+
+    for(int v = 0 ; v < 40 ; v += 3)
+      CHECK(reg.erase({ v }));
+    CHECK(!reg.erase({ 3 })); // already removed
+    CHECK(!reg.erase({ 50 }));
+    CHECK(reg.size() == 26);
+
+    for(int v = 0 ; v < 40 ; v++)
+    {
+      auto it = reg.find({ v });
+      if(v % 3 == 0)
+        CHECK(it == reg.end());
+      else
+        CHECK((it != reg.end() && it->second == 10*v));
+    }
+
+    reg.insert({ 3 }, 30);
+    CHECK(reg.find({ 3 })->second == 30);
+  }
+}
+
+TEST_CASE("CN batched data")
+{
+  SECTION("Batch of samples equivalent to successive samples")
+  {
+    Interval tdomain(0.,5.);
+    Tube x1(tdomain, 0.5), v1(tdomain, 0.5);
+    x1.set(0., 0.);
+    Tube x2(x1), v2(v1);
+
+    CtcDeriv ctc_deriv;
+    ContractorNetwork cn1, cn2;
+    cn1.add(ctc_deriv, {x1, v1});
+    cn2.add(ctc_deriv, {x2, v2});
+    cn1.contract();
+    cn2.contract();
+
+    vector<double> v_t;
+    vector<Interval> v_y;
+    for(int i = 0 ; i <= 3000 ; i++) // 1 kHz
+    {
+      double t = 0.001*i;
+      v_t.push_back(t);
+      v_y.push_back(Interval(std::sin(t)).inflate(0.01));
+      cn1.add_data(v1, t, v_y.back());
+    }
+
+    cn2.add_data(v2, v_t, v_y);
+    CHECK(cn1.nb_ctc_in_stack() == cn2.nb_ctc_in_stack());
+    CHECK(v1 == v2);
+    CHECK(v2.slice(0)->codomain().is_superset(Interval(0.,std::sin(0.5))));
+    CHECK(v2.slice(6)->codomain().diam() > 1000.); // [3,3.5] not covered yet
+    CHECK(v2.slice(4)->codomain().is_subset(Interval(std::sin(2.5),std::sin(2.)).inflate(0.011)));
+
+    cn1.contract();
+    cn2.contract();
+    CHECK(x1 == x2);
+    CHECK(x2(2.5).is_superset(Interval(1.-std::cos(2.5))));
+
+    // Jump over several slices, and samples beyond the tdomain
+    cn1.add_data(v1, 4.1, Interval(0.));
+    cn1.add_data(v1, 5.3, Interval(0.));
+    cn2.add_data(v2, {4.1, 5.3}, {Interval(0.), Interval(0.)});
+    CHECK(v1 == v2);
+    CHECK(v2.last_slice()->codomain() == Interval(0.));
+
+    CHECK_THROWS(cn2.add_data(v2, {5.4, 5.2}, {Interval(0.), Interval(0.)}););
+    CHECK_THROWS(cn2.add_data(v2, {5.6}, {Interval(0.), Interval(0.)}););
+  }
+
+  SECTION("Rejected batch of samples")
+  {
+    Interval tdomain(0.,5.);
+    TubeVector x1(tdomain, 0.5, 2), v1(tdomain, 0.5, 2);
+    x1.set(IntervalVector(2, 0.), 0.);
+    TubeVector x2(x1), v2(v1);
+
+    CtcDeriv ctc_deriv;
+    ContractorNetwork cn1, cn2;
+    cn1.add(ctc_deriv, {x1, v1});
+    cn2.add(ctc_deriv, {x2, v2});
+    cn1.contract();
+    cn2.contract();
+
+    cn1.add_data(v1, {0., 0.7}, {IntervalVector(2, 1.), IntervalVector(2, 1.)});
+    cn2.add_data(v2, {0., 0.7}, {IntervalVector(2, 1.), IntervalVector(2, 1.)});
+    TubeVector v2_before(v2);
+    int nb_ctc_before = cn2.nb_ctc_in_stack();
+
+    // A wrong time in the middle of the batch
+    CHECK_THROWS(cn2.add_data(v2, {1.2, 1.6, 1.4, 2.2}, {IntervalVector(2, 1.), IntervalVector(2, 1.), IntervalVector(2, 1.), IntervalVector(2, 1.)}););
+    // A wrong dimension in the middle of the batch
+    CHECK_THROWS(cn2.add_data(v2, {1.2, 1.6, 2.2}, {IntervalVector(2, 1.), IntervalVector(3, 1.), IntervalVector(2, 1.)}););
+    // A time before the last sample of the previous batch
+    CHECK_THROWS(cn2.add_data(v2, {0.6, 1.6}, {IntervalVector(2, 1.), IntervalVector(2, 1.)}););
+    CHECK(v2 == v2_before);
+    CHECK(cn2.nb_ctc_in_stack() == nb_ctc_before);
+
+    // A corrected batch is accepted on all the components
+    cn1.add_data(v1, {1.2, 1.6, 2.2}, {IntervalVector(2, 1.), IntervalVector(2, 1.), IntervalVector(2, 1.)});
+    cn2.add_data(v2, {1.2, 1.6, 2.2}, {IntervalVector(2, 1.), IntervalVector(2, 1.), IntervalVector(2, 1.)});
+    CHECK(v1 == v2);
+    CHECK(v2[1].slice(3)->codomain() == Interval(1.));
+    CHECK(cn1.nb_ctc_in_stack() == cn2.nb_ctc_in_stack());
+  }
+}
+
+// Incremental contractor counting the slices of the tube it is provided with
+class CtcSlicesCounter : public DynCtc
+{
+  public:
+
+    CtcSlicesCounter() : DynCtc(true) { }
+
+    bool is_incremental() const
+    {
+      return true;
+    }
+
+    void contract(vector<Domain*>& v_domains)
+    {
+      contract_incremental(v_domains, Interval::ALL_REALS);
+    }
+
+    void contract_incremental(vector<Domain*>& v_domains, const Interval& dirty_tdomain)
+    {
+      for(const Slice *s = v_domains[0]->tube().first_slice() ; s != NULL ; s = s->next_slice())
+      {
+        Interval t = s->tdomain() & dirty_tdomain;
+        if(!t.is_empty() && t.lb() < t.ub())
+          nb_slices++;
+      }
+    }
+
+    int nb_slices = 0;
+};
+
+TEST_CASE("CN incremental contractors")
+{
+  SECTION("Same results as complete contractions")
+  {
+    Interval domain(0.,20.);
+    Tube x(domain, 1., Interval(-10.,10.)), v(domain, 1., Interval(-1.,1.));
+    Tube x_inc(x), v_inc(v);
+    Interval t1(5.), z1(2.), t2(12.), z2(3.);
+    Interval t1_inc(t1), z1_inc(z1), t2_inc(t2), z2_inc(z2);
+
+    CtcDeriv ctc_deriv, ctc_deriv_inc;
+    ctc_deriv_inc.set_incremental_mode();
+    CHECK(!ctc_deriv.is_incremental());
+    CHECK(ctc_deriv_inc.is_incremental());
+    CtcEval ctc_eval;
+
+    ContractorNetwork cn, cn_inc;
+    cn.add(ctc_deriv, {x, v});
+    cn.add(ctc_eval, {t1, z1, x, v});
+    cn_inc.add(ctc_deriv_inc, {x_inc, v_inc});
+    cn_inc.add(ctc_eval, {t1_inc, z1_inc, x_inc, v_inc});
+    cn.contract();
+    cn_inc.contract();
+
+    CHECK(x_inc(5.) == Interval(2.));
+    CHECK(x_inc(0.) == Interval(-3.,7.));
+    CHECK(x_inc == x);
+
+    // New observation: the CtcDeriv is provided with the contracted part of the tube
+    cn.add(ctc_eval, {t2, z2, x, v});
+    cn_inc.add(ctc_eval, {t2_inc, z2_inc, x_inc, v_inc});
+    cn.contract();
+    cn_inc.contract();
+
+    CHECK(x_inc(12.) == Interval(3.));
+    CHECK(x_inc(10.) == Interval(1.,5.));
+    CHECK(x_inc(3.) == Interval(0.,4.));
+    CHECK(x_inc == x);
+  }
+
+  SECTION("Number of contracted slices in streaming mode")
+  {
+    Tube x(Interval(0.,20.), 1., Interval(-10.,10.));
+    CtcSlicesCounter ctc_counter;
+
+    ContractorNetwork cn;
+    cn.add(ctc_counter, {x});
+    cn.contract();
+    CHECK(ctc_counter.nb_slices == 20); // the whole tube at the first contraction
+
+    cn.contract(); // no contraction since the last call
+    CHECK(ctc_counter.nb_slices == 20);
+
+    // The new slice and the slices covered by the data are the only ones provided,
+    // even if the slicing has changed
+    cn.set_streaming(1.);
+    cn.add_data(x, vector<double>({ 19., 20., 21. }), vector<Interval>({ Interval(0.), Interval(1.), Interval(2.) }));
+    cn.contract();
+    CHECK(x.nb_slices() == 21);
+    CHECK(x.slice(19)->codomain() == Interval(0.,1.));
+    CHECK(x.slice(20)->codomain() == Interval(1.,2.));
+    CHECK(ctc_counter.nb_slices == 20 + 2);
+  }
+}
@@ -7,6 +7,7 @@
 // of the class for tests purposes
 #define protected public
 #include "codac_CtcDeriv.h"
+#include "codac_ThreadPool.h"
 
 using namespace Catch;
 using namespace Detail;
@@ -395,4 +396,173 @@ TEST_CASE("CtcDeriv")
     CHECK(x.interpol(Interval(1.), v) == Interval(-1.));
     CHECK(x.interpol(Interval(-1.,3.), v) == Interval(-3.,1.));
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("CtcDeriv, fast mode")
+{
+  SECTION("Same results as slice by slice contractions")
+  {
+    Tube x(Interval(0.,10.), 0.01), v(x);
+    for(int k = 0 ; k < x.nb_slices() ; k++)
+    {
+      double t = x.slice_tdomain(k).lb();
+      x.set(Interval(std::sin(t)).inflate(1. + (k % 7) * 0.1), k);
+      v.set(Interval(std::cos(t)).inflate(0.2 + (k % 3) * 0.05), k);
+    }
+    x.set(Interval(0.), 0.);
+    x.set(Interval(-0.5,0.5), 5.);
+
+    CtcDeriv ctc;
+    ctc.set_fast_mode();
+    ctc.restrict_tdomain(Interval(0.,9.));
+
+    for(TimePropag t_propa : { TimePropag::FORWARD, TimePropag::BACKWARD, TimePropag::FORWARD | TimePropag::BACKWARD })
+    {
+      Tube x_ref(x);
+      if(t_propa & TimePropag::FORWARD)
+        for(Slice *s = x_ref.first_slice() ; s != NULL ; s = s->next_slice())
+          ctc.contract(*s, *v.slice(x_ref.index(s)), t_propa);
+      if(t_propa & TimePropag::BACKWARD)
+        for(Slice *s = x_ref.last_slice() ; s != NULL ; s = s->prev_slice())
+          ctc.contract(*s, *v.slice(x_ref.index(s)), t_propa);
+
+      Tube x_batch(x);
+      ctc.contract(x_batch, v, t_propa);
+      CHECK(x_batch == x_ref);
+
+      ThreadPool::set_nb_threads(4);
+      ThreadPool::set_grain_size(16);
+      Tube x_parallel(x);
+      ctc.contract(x_parallel, v, t_propa);
+      CHECK(x_parallel == x_ref);
+
+      TubeVector xv(3, x), vv(3, v);
+      ctc.contract(xv, vv, t_propa);
+      for(int i = 0 ; i < 3 ; i++)
+        CHECK(xv[i] == x_ref);
+
+      ThreadPool::set_nb_threads(1);
+      ThreadPool::set_grain_size(1024);
+    }
+  }
+
+  SECTION("Parallel propagation of the gates")
+  {
+    // Dyadic values: same results as the sequential propagation, without rounding
+    Tube x(Interval(0.,64.), 0.125), v(x);
+    for(int k = 0 ; k < x.nb_slices() ; k++)
+    {
+      x.set(Interval(-8.,8.) + (k % 16) * 0.25, k);
+      v.set(Interval(-1.,1.) + (k % 5) * 0.5, k);
+    }
+    x.set(Interval(0.), 0.);
+    x.set(Interval(1.,2.), 40.);
+
+    CtcDeriv ctc_seq, ctc_par;
+    ctc_seq.set_fast_mode();
+    ctc_par.set_fast_mode();
+    ctc_par.set_parallel_propagation();
+
+    ThreadPool::set_nb_threads(4);
+    ThreadPool::set_grain_size(16);
+
+    for(TimePropag t_propa : { TimePropag::FORWARD, TimePropag::BACKWARD, TimePropag::FORWARD | TimePropag::BACKWARD })
+    {
+      Tube x_seq(x), x_par(x);
+      ctc_seq.contract(x_seq, v, t_propa);
+      ctc_par.contract(x_par, v, t_propa);
+      CHECK(x_par == x_seq);
+    }
+
+    ThreadPool::set_nb_threads(1);
+    ThreadPool::set_grain_size(1024);
+  }
+
+  SECTION("Parallel propagation with empty gates and a restricted tdomain")
+  {
+    Tube x(Interval(0.,64.), 0.125), v(x);
+    for(int k = 0 ; k < x.nb_slices() ; k++)
+    {
+      x.set(Interval(-8.,8.) + (k % 16) * 0.25, k);
+      v.set(Interval(-1.,1.) + (k % 5) * 0.5, k);
+    }
+    x.set(Interval(0.), 0.);
+
+    ThreadPool::set_nb_threads(4);
+    ThreadPool::set_grain_size(16);
+
+    // 0: empty gate in the middle, 1: empty slice in the middle,
+    // 2: restricted tdomain, 3: restricted tdomain and empty gate
+    for(int test = 0 ; test < 4 ; test++)
+    {
+      Tube x_test(x);
+      if(test == 0 || test == 3)
+        x_test.set(Interval::EMPTY_SET, 20.);
+      if(test == 1)
+        x_test.set(Interval::EMPTY_SET, 300);
+
+      CtcDeriv ctc_seq, ctc_par;
+      ctc_seq.set_fast_mode();
+      ctc_par.set_fast_mode();
+      ctc_par.set_parallel_propagation();
+      if(test >= 2)
+      {
+        ctc_seq.restrict_tdomain(Interval(10.,50.));
+        ctc_par.restrict_tdomain(Interval(10.,50.));
+      }
+
+      for(TimePropag t_propa : { TimePropag::FORWARD, TimePropag::BACKWARD, TimePropag::FORWARD | TimePropag::BACKWARD })
+      {
+        Tube x_seq(x_test), x_par(x_test);
+        ctc_seq.contract(x_seq, v, t_propa);
+        ctc_par.contract(x_par, v, t_propa);
+        CHECK(x_par == x_seq);
+
+        if(t_propa == TimePropag::FORWARD)
+        {
+          CHECK(x_par(45.).is_empty() == (test != 2)); // emptiness propagated over several ranges
+          CHECK(x_par(60.).is_empty() == (test < 2)); // but not beyond the restricted tdomain
+        }
+      }
+    }
+
+    ThreadPool::set_nb_threads(1);
+    ThreadPool::set_grain_size(1024);
+  }
+}
+
+TEST_CASE("CtcDeriv, incremental mode")
+{
+  SECTION("Same results as complete contractions")
+  {
+    for(bool fast_mode : { false, true })
+    {
+      Tube x(Interval(0.,10.), 1., Interval(-3.,3.)), v(x.tdomain(), 1., Interval(-1.,1.));
+      x.set(Interval(0.), 0.);
+
+      CtcDeriv ctc;
+      ctc.set_fast_mode(fast_mode);
+      ctc.contract(x, v);
+      Tube x_full(x), x_inc(x);
+
+      // Contraction of a gate
+      x_full.set(Interval(-2.5,3.), 5.);
+      x_inc.set(Interval(-2.5,3.), 5.);
+      ctc.contract(x_full, v);
+      ctc.contract_incremental(x_inc, v, Interval(5.));
+      CHECK(x_inc(5.) == Interval(-2.5,3.));
+      CHECK(x_inc == x_full);
+
+      // Contraction of a slice
+      x_full.set(Interval(-1.,1.), 7);
+      x_inc.set(Interval(-1.,1.), 7);
+      ctc.contract(x_full, v);
+      ctc.contract_incremental(x_inc, v, x_inc.slice_tdomain(7));
+      CHECK(x_inc == x_full);
+
+      // No contracted part
+      ctc.contract_incremental(x_inc, v, Interval::EMPTY_SET);
+      CHECK(x_inc == x_full);
+    }
+  }
+}
@@ -1324,4 +1324,125 @@ TEST_CASE("CtcEval (other tests)")
       CHECK(y.codomain() == Interval(4,5));
     }
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("CtcEval, batch of evaluations")
+{
+  SECTION("Same results as successive evaluations on gates")
+  {
+    Tube x(Interval(0.,10.), 1., Interval(-10.,10.)), v(x.tdomain(), 1., Interval(-1.,1.));
+    Tube x_seq(x), v_seq(v);
+
+    CtcEval ctc_eval;
+    vector<Interval> v_t = { Interval(7.), Interval(2.) }, v_z = { Interval(3.), Interval(1.) };
+    ctc_eval.contract(v_t, v_z, x, v);
+
+    for(size_t i = 0 ; i < v_t.size() ; i++)
+    {
+      Interval t(v_t[i]), z(v_z[i]);
+      ctc_eval.contract(t, z, x_seq, v_seq);
+    }
+
+    CHECK(x.nb_slices() == 10);
+    CHECK(x == x_seq);
+    CHECK(x(2.) == Interval(1.));
+    CHECK(x(4.) == Interval(0.,3.));
+    CHECK(x(7.) == Interval(3.));
+    CHECK(x(0.) == Interval(-1.,3.));
+  }
+
+  SECTION("Same results as successive evaluations inside slices")
+  {
+    Tube x(Interval(0.,10.), 1., Interval(-10.,10.)), v(x.tdomain(), 1., Interval(-1.,1.));
+    Tube x_seq(x), v_seq(v), x_local(x), v_local(v), x_local_seq(x), v_local_seq(v);
+
+    CtcEval ctc_eval, ctc_eval_local;
+    ctc_eval_local.enable_time_propag(false);
+    vector<Interval> v_t = { Interval(7.5), Interval(2.5) }, v_z = { Interval(3.), Interval(1.) };
+    vector<Interval> v_t_local(v_t), v_z_local(v_z);
+    ctc_eval.contract(v_t, v_z, x, v);
+    ctc_eval_local.contract(v_t_local, v_z_local, x_local, v_local);
+
+    for(size_t i = 0 ; i < v_t.size() ; i++)
+    {
+      Interval t(v_t[i]), z(v_z[i]);
+      ctc_eval.contract(t, z, x_seq, v_seq);
+      Interval t_local(v_t_local[i]), z_local(v_z_local[i]);
+      ctc_eval_local.contract(t_local, z_local, x_local_seq, v_local_seq);
+    }
+
+    // With propagation, the gates of the evaluations are kept
+    CHECK(x.nb_slices() == 12);
+    CHECK(x_seq.nb_slices() == 12);
+    CHECK(Tube::same_slicing(x, v));
+    CHECK(x == x_seq);
+    CHECK(x(2.5) == Interval(1.));
+    CHECK(x(7.5) == Interval(3.));
+    CHECK(x(5.) == Interval(0.5,3.5));
+
+    // Without propagation, the slicing is preserved
+    CHECK(x_local.nb_slices() == 10);
+    CHECK(x_local_seq.nb_slices() == 10);
+    CHECK(Tube::same_slicing(x_local, v_local));
+    CHECK(x_local == x_local_seq);
+    CHECK(x_local(2) == Interval(0.5,1.5));
+    CHECK(x_local(5) == Interval(-10.,10.));
+  }
+
+  SECTION("Uncertain times, preserved slicing")
+  {
+    Tube x(Interval(0.,10.), 1.), v(x.tdomain(), 1., Interval(1.));
+    x.set(Interval(0.), 0.);
+    CtcDeriv ctc_deriv;
+    ctc_deriv.contract(x, v);
+
+    CtcEval ctc_eval;
+    vector<Interval> v_t = { Interval(0.,10.), Interval(1.,3.), Interval(2.5,6.) };
+    vector<Interval> v_z = { Interval(4.5,5.5), Interval(2.), Interval::ALL_REALS };
+    ctc_eval.contract(v_t, v_z, x, v);
+
+    CHECK(x.nb_slices() == 10);
+    CHECK(ApproxIntv(v_t[0]) == Interval(4.5,5.5));
+    CHECK(ApproxIntv(v_t[1]) == Interval(2.));
+    CHECK(ApproxIntv(v_t[2]) == Interval(2.5,6.));
+    CHECK(ApproxIntv(v_z[2]) == Interval(2.5,6.));
+  }
+
+  SECTION("Inconsistent evaluation")
+  {
+    Tube x(Interval(0.,10.), 1., Interval(-1.,1.)), v(x.tdomain(), 1.);
+    CtcEval ctc_eval;
+    vector<Interval> v_t = { Interval(2.), Interval(4.) }, v_z = { Interval(0.), Interval(2.,3.) };
+    ctc_eval.contract(v_t, v_z, x, v);
+    CHECK(x.is_empty());
+    CHECK(v_t[0].is_empty());
+    CHECK(v_z[1].is_empty());
+  }
+
+  SECTION("Empty evaluation")
+  {
+    Tube x(Interval(0.,10.), 1., Interval(-1.,1.)), v(x.tdomain(), 1.);
+    CtcEval ctc_eval;
+    vector<Interval> v_t = { Interval(2.), Interval(4.) }, v_z = { Interval(0.), Interval::EMPTY_SET };
+    ctc_eval.contract(v_t, v_z, x, v);
+    CHECK(x.is_empty());
+    CHECK(v.is_empty());
+    CHECK(v_t[0].is_empty());
+    CHECK(v_t[1].is_empty());
+    CHECK(v_z[0].is_empty());
+  }
+
+  SECTION("Empty evaluation, vector case")
+  {
+    TubeVector x(Interval(0.,10.), 1., IntervalVector(2, Interval(-1.,1.))), v(x.tdomain(), 1., 2);
+    CtcEval ctc_eval;
+    vector<Interval> v_t = { Interval(2.), Interval(4.) };
+    vector<IntervalVector> v_z = { IntervalVector(2, Interval(0.)), IntervalVector(2, Interval::EMPTY_SET) };
+    ctc_eval.contract(v_t, v_z, x, v);
+    CHECK(x.is_empty());
+    CHECK(v.is_empty());
+    CHECK(v_t[0].is_empty());
+    CHECK(v_t[1].is_empty());
+    CHECK(v_z[0].is_empty());
+  }
+}
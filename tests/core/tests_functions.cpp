@@ -62,4 +62,72 @@ TEST_CASE("Functions")
       CHECK(f.eval_vector(box_i.subvector(1,2)) == tf.eval_vector(box_i));
     }
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Function tape")
+{
+  SECTION("Compilation and batch evaluation")
+  {
+    Function f("t", "x1", "x2", "(x1+sin(t)*x2+[-0.01,0.01] ; -sqr(x1) + exp(x2)/2. ; atan2(x1,x2)*sin(t))");
+    FunctionTape tape(f);
+    CHECK(tape.nb_args() == 3);
+    CHECK(tape.image_dim() == 3);
+    CHECK(tape.size() <= 16); // sin(t) shared
+
+    const int n = 100;
+    vector<Interval> v_t(n), v_x1(n), v_x2(n), v_y1(n), v_y2(n), v_y3(n), workspace;
+    for(int k = 0 ; k < n ; k++)
+    {
+      v_t[k] = Interval(k*0.1, (k+1)*0.1);
+      v_x1[k] = Interval(-1.,2.) + cos(k*0.3);
+      v_x2[k] = Interval(0.5,1.) * k;
+    }
+
+    const Interval* v_x[3] = { v_t.data(), v_x1.data(), v_x2.data() };
+    Interval* v_y[3] = { v_y1.data(), v_y2.data(), v_y3.data() };
+    tape.eval(n, v_x, v_y, workspace);
+
+    for(int k = 0 ; k < n ; k++)
+    {
+      // Same operations as the IBEX evaluation
+      IntervalVector y = f.eval_vector(IntervalVector({ v_t[k], v_x1[k], v_x2[k] }));
+      CHECK(v_y1[k] == y[0]);
+      CHECK(v_y2[k] == y[1]);
+      CHECK(v_y3[k] == y[2]);
+    }
+
+    FunctionTape tape2 = tape.component(1);
+    CHECK(tape2.image_dim() == 1);
+    tape2.eval(n, v_x, v_y, workspace);
+    CHECK(v_y1[50] == v_y2[50]);
+  }
+
+  SECTION("Unsupported expressions")
+  {
+    CHECK_THROWS(FunctionTape(Function("t", "x[2]", "x[0]+t")););
+  }
+
+  SECTION("Evaluation over tubes")
+  {
+    TubeVector x(Interval(0.,10.), 0.01, 2);
+    for(int k = 0 ; k < x.nb_slices() ; k++)
+    {
+      x[0].slice(k)->set_envelope(Interval(-1.,1.) * (k % 7), false);
+      x[1].slice(k)->set_envelope(Interval(k*0.01), false);
+    }
+    x[0].slice(0)->set_input_gate(Interval(0.1), false);
+    x[1].slice(0)->set_input_gate(Interval(0.), false);
+
+    TFunction f("x1", "x2", "x1+sin(t)*x2^3+[-0.01,0.01]");
+    Tube y = f.eval(x);
+    CHECK(Tube::same_slicing(y, x[0]));
+
+    for(int k = 0 ; k < x.nb_slices() ; k++)
+    {
+      const Interval t = x[0].slice(k)->tdomain();
+      CHECK(y.slice(k)->codomain() == f.eval(IntervalVector({ t, x[0].slice(k)->codomain(), x[1].slice(k)->codomain() })));
+    }
+
+    CHECK(y.slice(0)->input_gate() == f.eval(IntervalVector({ Interval(0.), Interval(0.1), Interval(0.) })));
+  }
+}
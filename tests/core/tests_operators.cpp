@@ -548,4 +548,46 @@ TEST_CASE("Operators")
     CHECK(tube3(0) == Interval(3.,8.));
     CHECK(tube3(1) == Interval(3.,6.));
   }
+
+  SECTION("Test in-place and move assignments")
+  {
+    Tube x(Interval(0.,10.), 0.5, Interval(-1.,2.)), y(x);
+    y.set(Interval(0.,1.));
+    y.set(Interval(0.5), 5.);
+    const Slice *s = x.first_slice();
+
+    // Compound assignment from an expression: same values as with an intermediate tube
+    Tube expected(x);
+    expected &= Tube(2.*y - 1.);
+    x &= 2.*y - 1.;
+    CHECK(x == expected);
+    CHECK(x(5.) == Interval(0.));
+
+    // Operands sharing the slicing: the structure of x is kept
+    x |= y;
+    x += x;
+    x = y;
+    CHECK(x == y);
+    CHECK(x.first_slice() == s);
+
+    Tube z(Interval(0.,10.), 0.1, Interval(1.));
+    x *= z; // different slicing: the slicing of x is kept
+    CHECK(x.nb_slices() == 20);
+    CHECK(x.codomain() == y.codomain());
+
+    Tube w = std::move(z);
+    CHECK(w.nb_slices() == 100);
+    CHECK(w.codomain() == Interval(1.));
+    x = std::move(w);
+    CHECK(x.nb_slices() == 100);
+    CHECK(x.codomain() == Interval(1.));
+
+    TubeVector v(2, y), v_copy(2, x);
+    v = TubeVector(2, y);
+    CHECK(v[1] == y);
+    v = v_copy; // different slicing
+    CHECK(v[1] == x);
+    TubeVector v_moved(std::move(v));
+    CHECK(v_moved == v_copy);
+  }
 }
\ No newline at end of file
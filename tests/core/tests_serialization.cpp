@@ -1,6 +1,11 @@
 #include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
 #include "codac_serialize_trajectories.h"
 #include "codac_serialize_tubes.h"
+#include "codac_MappedTube.h"
+#include "codac_TubeLog.h"
 #include "catch_interval.hpp"
 #include "tests_predefined_tubes.h"
 
@@ -104,6 +109,21 @@ TEST_CASE("serialization/deserialization of Tube")
     CHECK(tube2(3.) == Interval(2.,3.));
   }
 
+  SECTION("Inconsistent gates")
+  {
+    Tube tube1(Interval(0.,3.), 1., Interval(0.,1.));
+    tube1.slice(1)->set_envelope(Interval(0.5,2.));
+    tube1.slice(1)->set_input_gate(Interval(-5.,5.), false); // not intersected with the envelopes
+
+    string filename = "test_serialization_inconsistent.tube";
+    tube1.serialize(filename);
+    Tube tube2(filename);
+    remove(filename.c_str());
+
+    CHECK(tube2.slice(1)->input_gate() == Interval(0.5,1.));
+    CHECK(tube2.slice(1)->codomain() == Interval(0.5,2.));
+  }
+
   SECTION("With trajectories")
   {
     Tube tube1 = tube_test_1();
@@ -296,4 +316,247 @@ TEST_CASE("(de)serializations on unbounded tubes", "[core]")
     tube.set(Interval::EMPTY_SET);
     CHECK(test_serialization(tube));
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("(de)serializations with columnar layout", "[core]")
+{
+  SECTION("Tube and trajectory")
+  {
+    Tube tube1 = tube_test4();
+    tube1.set(Interval::EMPTY_SET, 0);
+    tube1.set(Interval::POS_REALS, 1);
+    tube1.set(Interval(-5.,POS_INFINITY), 2);
+    tube1.set(Interval(7.), 3.);
+    Trajectory traj1;
+    traj1.set(1., 0.);
+    traj1.set(2., 21.);
+
+    string filename = "test_serialization_v3.tube";
+    tube1.serialize(filename, traj1, SERIALIZATION_VERSION_COLUMNAR);
+    Trajectory *traj2;
+    Tube tube2(filename, traj2);
+    remove(filename.c_str());
+    CHECK(tube1 == tube2);
+    CHECK(traj1 == *traj2);
+    CHECK(tube2(3.) == Interval(7.));
+    delete traj2;
+  }
+
+  SECTION("Vector case")
+  {
+    TubeVector tube1(Interval(0.,46.), 1., 3);
+    tube1.set(IntervalVector(3, Interval(2.,3.)), 0.);
+    tube1.set(IntervalVector(3, Interval::EMPTY_SET), 46.);
+
+    string filename = "test_serialization_v3.tube";
+    tube1.serialize(filename, SERIALIZATION_VERSION_COLUMNAR);
+    TubeVector tube2(filename);
+    CHECK(tube1 == tube2);
+
+    MappedTube x(filename, 2);
+    CHECK(x.nb_slices() == tube1[2].nb_slices());
+    CHECK(x.tube() == tube1[2]);
+    remove(filename.c_str());
+  }
+
+  SECTION("Vector case, other byte order")
+  {
+    TubeVector tube1(Interval(0.,10.), 1., 2);
+    tube1.set(IntervalVector(2, Interval(2.,3.)), 0.);
+    tube1[1].set(Interval(-1.,4.), 5);
+    tube1.set(IntervalVector(2, Interval::EMPTY_SET), 10.);
+
+    string filename = "test_serialization_v3_swapped.tube";
+    tube1.serialize(filename, SERIALIZATION_VERSION_COLUMNAR);
+
+    // Fixture: the same file, as written on a machine with the other byte order
+    ifstream ifile(filename, ios::binary);
+    vector<char> v_bytes((istreambuf_iterator<char>(ifile)), istreambuf_iterator<char>());
+    ifile.close();
+
+    auto reverse_field = [&](size_t offset, size_t nb_bytes)
+    {
+      reverse(v_bytes.begin() + offset, v_bytes.begin() + offset + nb_bytes);
+    };
+
+    reverse_field(0, sizeof(short int)); // dimension
+    size_t offset = sizeof(short int);
+    for(int i = 0 ; i < tube1.size() ; i++)
+    {
+      reverse_field(offset, sizeof(short int)); // version number
+      offset += sizeof(short int);
+      offset += (8 - offset % 8) % 8; // padding
+      reverse_field(offset, sizeof(uint32_t)); // endianness tag
+      reverse_field(offset + sizeof(uint32_t), sizeof(int32_t)); // slices number
+      offset += sizeof(uint32_t) + sizeof(int32_t);
+      for(int k = 0 ; k < 5 * tube1[i].nb_slices() + 3 ; k++, offset += sizeof(double))
+        reverse_field(offset, sizeof(double));
+    }
+    REQUIRE(offset == v_bytes.size());
+
+    ofstream ofile(filename, ios::binary);
+    ofile.write(v_bytes.data(), v_bytes.size());
+    ofile.close();
+
+    TubeVector tube2(filename);
+    CHECK(tube2.size() == 2);
+    CHECK(tube1 == tube2);
+    CHECK_THROWS(MappedTube x(filename, 1););
+    remove(filename.c_str());
+  }
+
+  SECTION("Mapped tube")
+  {
+    Tube tube1 = tube_test_1();
+    tube1.set(Interval(-4.,2.), 14);
+    tube1.set(Interval(1.), 3.);
+
+    string filename = "test_serialization_mapped.tube";
+    tube1.serialize(filename, SERIALIZATION_VERSION_COLUMNAR);
+    MappedTube x(filename);
+
+    CHECK(x.nb_slices() == tube1.nb_slices());
+    CHECK(x.tdomain() == tube1.tdomain());
+    CHECK(x(14) == tube1(14));
+    CHECK(x(3.) == Interval(1.));
+    CHECK(x(3.5) == tube1(3.5));
+    CHECK(x.time_to_index(3.) == tube1.time_to_index(3.));
+    CHECK(x.gate(0) == tube1.first_slice()->input_gate());
+    CHECK(x(Interval(12.5,17.5)) == tube1(Interval(12.5,17.5)));
+    CHECK(x(tube1.tdomain()) == tube1.codomain());
+    CHECK(x.tube() == tube1);
+
+    Tube tube2 = x.tube(Interval(3.,6.));
+    CHECK(tube2.tdomain() == Interval(3.,6.));
+    CHECK(tube2.nb_slices() == 3);
+    CHECK(tube2(1) == tube1(4));
+    CHECK(tube2(3.) == Interval(1.));
+    remove(filename.c_str());
+
+    tube1.serialize(filename); // version 2 cannot be mapped
+    CHECK_THROWS(MappedTube y(filename););
+    remove(filename.c_str());
+  }
+}
+
+TEST_CASE("(de)serializations with compressed layout", "[core]")
+{
+  SECTION("Tube and trajectory")
+  {
+    Tube tube1 = tube_test4();
+    tube1.set(Interval::EMPTY_SET, 0);
+    tube1.set(Interval::NEG_REALS, 1);
+    tube1.set(Interval(7.), 3.);
+    Trajectory traj1;
+    for(double t = 0. ; t < 21. ; t += 0.01)
+      traj1.set(sin(t), t);
+
+    string filename = "test_serialization_v4.tube";
+    tube1.serialize(filename, traj1, SERIALIZATION_VERSION_COMPRESSED);
+    Trajectory *traj2;
+    Tube tube2(filename, traj2);
+    remove(filename.c_str());
+    CHECK(tube1 == tube2);
+    CHECK(traj1 == *traj2);
+    CHECK(tube2(3.) == Interval(7.));
+    delete traj2;
+  }
+
+  SECTION("Vector case, smaller files")
+  {
+    TubeVector tube1(Interval(0.,46.), 0.01, 3);
+    TrajectoryVector traj1(3);
+    for(int k = 0 ; k < tube1.nb_slices() ; k++)
+    {
+      double t = tube1[0].slice(k)->tdomain().lb();
+      tube1.set(IntervalVector(3, Interval(cos(t)).inflate(0.5)), k);
+      for(int i = 0 ; i < 3 ; i++)
+        traj1[i].set(cos(t), t);
+    }
+
+    string filename2 = "test_serialization_v2.tube", filename4 = "test_serialization_v4.tube";
+    tube1.serialize(filename2, traj1);
+    tube1.serialize(filename4, traj1, SERIALIZATION_VERSION_COMPRESSED);
+
+    TrajectoryVector *traj2;
+    TubeVector tube2(filename4, traj2);
+    CHECK(tube1 == tube2);
+    CHECK(traj1 == *traj2);
+    delete traj2;
+
+    ifstream file2(filename2, ios::binary | ios::ate), file4(filename4, ios::binary | ios::ate);
+    CHECK(file4.tellg() < file2.tellg());
+    file2.close(); file4.close();
+    remove(filename2.c_str());
+    remove(filename4.c_str());
+  }
+}
+
+TEST_CASE("(de)serializations with streaming log", "[core]")
+{
+  SECTION("Appending slices and reading by time range")
+  {
+    TubeVector tube1(Interval(0.,10.), 0.25, 2);
+    for(int k = 0 ; k < tube1.nb_slices() ; k++)
+      tube1.set(IntervalVector(2, Interval(k,k+1)), k);
+    tube1[0].set(Interval::EMPTY_SET, 5);
+
+    string filename = "test_serialization.log";
+    remove(filename.c_str());
+
+    {
+      TubeLogWriter log(filename, 2);
+      CHECK(log.tdomain().is_empty());
+      CHECK(log.append(tube1, 2.6) == 10); // slices finalised before t=2.6
+      CHECK(log.append(tube1, 2.6) == 0);
+      CHECK(log.append(tube1, 5.) == 10);
+    }
+
+    {
+      TubeLogWriter log(filename, 2); // reopening the log
+      CHECK(log.tdomain() == Interval(0.,5.));
+      CHECK(log.append(tube1, 10.) == 20);
+    }
+
+    TubeLogReader log(filename);
+    CHECK(log.size() == 2);
+    CHECK(log.nb_slices() == 40);
+    CHECK(log.tdomain() == Interval(0.,10.));
+
+    TubeVector tube2 = log.tube(Interval(2.,6.));
+    CHECK(tube2.nb_slices() == 16);
+    CHECK(tube2.tdomain() == Interval(2.,6.));
+    for(int k = 0 ; k < tube2.nb_slices() ; k++)
+      for(int i = 0 ; i < 2 ; i++)
+        CHECK(tube2[i].slice(k)->codomain() == tube1[i].slice(k+8)->codomain());
+
+    TubeVector tube3 = log.tube(log.tdomain());
+    CHECK(tube3 == tube1);
+    CHECK(tube3[0](5).is_empty());
+    remove(filename.c_str());
+  }
+
+  SECTION("Recovery of an interrupted log")
+  {
+    Tube tube1(Interval(0.,10.), 0.5, Interval(-1.,1.));
+    string filename = "test_serialization.log";
+    remove(filename.c_str());
+
+    {
+      TubeLogWriter log(filename);
+      log.append(tube1, 10.);
+    }
+
+    { // partial write after the last chunk
+      ofstream bin_file(filename, ios::out | ios::binary | ios::app);
+      bin_file.write("CHNK\x05", 5);
+    }
+
+    CHECK(TubeLogReader(filename).nb_slices() == 20);
+    CHECK(TubeLogReader(filename).scalar_tube(Interval(0.,10.)) == tube1);
+
+    TubeLogWriter log(filename); // the footer is restored
+    CHECK(log.tdomain() == Interval(0.,10.));
+    remove(filename.c_str());
+  }
+}
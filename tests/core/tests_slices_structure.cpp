@@ -55,6 +55,25 @@ TEST_CASE("time_to_index")
     CHECK(tube.index(tube.first_slice()) == 0);
     CHECK(tube.index(tube.last_slice()) == 45);
   }
+
+  SECTION("time_to_index after sampling and gate removal")
+  {
+    Tube tube = tube_test_1();
+    tube.sample(10.5);
+    CHECK(tube.nb_slices() == 47);
+    CHECK(tube.time_to_index(10.2) == 10);
+    CHECK(tube.time_to_index(10.5) == 11);
+    CHECK(tube.time_to_index(11.) == 12);
+    CHECK(tube.time_to_index(tube.tdomain().ub()) == 46);
+    CHECK(tube.slice(10.7) == tube.slice(11));
+
+    tube.remove_gate(10.);
+    CHECK(tube.nb_slices() == 46);
+    CHECK(tube.time_to_index(9.2) == 9);
+    CHECK(tube.time_to_index(10.5) == 10);
+    CHECK(tube.time_to_index(11.) == 11);
+    CHECK(tube.slice(9.) == tube.slice(9));
+  }
 }
 
 TEST_CASE("Tube slices structure")
@@ -354,6 +373,100 @@ TEST_CASE("Tube slices structure")
     CHECK(x == xold);
   }
 
+  SECTION("Slices indexes after sampling and merging")
+  {
+    Tube x(Interval(0.,10.), 1., Interval(-1.,1.));
+    Slice *s_last = x.last_slice();
+    CHECK(x.index(s_last) == 9);
+
+    x.sample(2.5);
+    CHECK(x.nb_slices() == 11);
+    CHECK(x.last_slice() == s_last);
+    CHECK(x.index(s_last) == 10);
+    CHECK(x.slice(3)->tdomain() == Interval(2.5,3.));
+    CHECK(x.slice(3)->prev_slice() == x.slice(2));
+    CHECK(x.slice(3)->input_gate() == Interval(-1.,1.));
+    CHECK(x.slice(10)->next_slice() == NULL);
+
+    x.set(Interval(2.), 7);
+    x.merge_similar_slices(0.1);
+    CHECK(x.nb_slices() == 3);
+    CHECK(x.last_slice()->tdomain() == Interval(7.,10.));
+    CHECK(x.index(x.last_slice()) == 2);
+    CHECK(x.slice(1)->tdomain() == Interval(6.,7.));
+    CHECK(x.slice(1)->codomain() == Interval(2.));
+    CHECK(x.slice(0)->input_gate() == Interval(-1.,1.));
+    CHECK(x.slice(1)->input_gate().is_empty());
+    CHECK(x.slice(2)->prev_slice() == x.slice(1));
+
+    Slice s(*x.slice(1)); // standalone copy
+    s.set(Interval(3.));
+    CHECK(x.slice(1)->codomain() == Interval(2.));
+    CHECK(s.prev_slice() == NULL);
+    CHECK(s.next_slice() == NULL);
+  }
+
+  SECTION("Synthesis tree after sampling and gate removal")
+  {
+    Tube x = tube_test_1();
+    x.enable_synthesis(true);
+    CHECK(x.codomain() == Interval(-11.,13.)); // tree values computed
+
+    x.sample(10.5);
+    x.sample(10.25);
+    x.set(Interval(-20.,-19.), x.time_to_index(10.4));
+    x.remove_gate(10.);
+    x.remove_gate(30.);
+    for(double t = 40.5 ; t > 40. + 1e-3 ; t = (t + 40.) / 2.) // deep branch
+      x.sample(t);
+    x.merge_similar_slices(0.5);
+
+    Tube y(x); // same tube, without synthesis tree
+    CHECK(x.nb_slices() == y.nb_slices());
+    CHECK(x == y);
+    CHECK(x.codomain() == y.codomain());
+    CHECK(x.codomain() == Interval(-20.,13.));
+    CHECK(x.slice(40.2) == x.slice(x.time_to_index(40.2)));
+    CHECK(x(Interval(9.5,10.7)) == y(Interval(9.5,10.7)));
+    CHECK(x(Interval(39.,41.)) == y(Interval(39.,41.)));
+    CHECK(x.invert(Interval(-19.5), x.tdomain()) == y.invert(Interval(-19.5), y.tdomain()));
+    CHECK(x.invert(Interval(-19.5), x.tdomain()) == Interval(10.25,10.5));
+    CHECK(ApproxIntv(x.integral(Interval(5.,12.2))) == y.integral(Interval(5.,12.2)));
+    CHECK(ApproxIntv(x.integral(Interval(20.,45.1))) == y.integral(Interval(20.,45.1)));
+  }
+
+  SECTION("Sampling and merging in one pass")
+  {
+    Tube x = tube_test_1();
+    x.enable_synthesis(true);
+    Tube y(x);
+    vector<double> v_t = { 0., 2.5, 2.5, 3., 10.25, 10.5, 21.7, 46. };
+
+    x.sample(v_t);
+    for(const auto& t : v_t)
+      y.sample(t);
+
+    CHECK(x.nb_slices() == y.nb_slices());
+    CHECK(x.nb_slices() == tube_test_1().nb_slices() + 4);
+    CHECK(x == y);
+    CHECK(x.slice(10.4)->tdomain() == Interval(10.25,10.5));
+    CHECK(x.index(x.slice(21.)) == x.time_to_index(21.));
+
+    x.set(Interval(-20.,-19.), x.time_to_index(10.4));
+    y.set(Interval(-20.,-19.), y.time_to_index(10.4));
+    CHECK(x.invert(Interval(-19.5), x.tdomain()) == Interval(10.25,10.5));
+
+    vector<double> v_gates = { 2.5, 10., 10.25, 10.5, 21.7, 30. };
+    x.remove_gates(v_gates);
+    for(auto it = v_gates.rbegin() ; it != v_gates.rend() ; it++)
+      y.remove_gate(*it);
+
+    CHECK(x.nb_slices() == y.nb_slices());
+    CHECK(x == y);
+    CHECK(x.codomain() == Interval(-20.,13.));
+    CHECK(x.index(x.last_slice()) == x.nb_slices() - 1);
+  }
+
   SECTION("truncate_tdomain, test 1")
   {
     TubeVector tube(Interval(0.,10.), 1., 2);
@@ -402,4 +515,93 @@ TEST_CASE("Tube slices structure")
     CHECK(tube.nb_slices() == 1);
     CHECK(tube[0].slice(0)->tdomain() == Interval(8.2,8.3));
   }
+
+  SECTION("truncate_tdomain, test 5 (bounds on gates)")
+  {
+    Tube tube(Interval(0.,10.), 1., Interval(-1.,1.));
+    tube.set(Interval(0.5), 2.);
+    tube.truncate_tdomain(Interval(2.,5.));
+    CHECK(tube.tdomain() == Interval(2.,5.));
+    CHECK(tube.nb_slices() == 3);
+    CHECK(tube.first_slice()->tdomain() == Interval(2.,3.));
+    CHECK(tube.last_slice()->tdomain() == Interval(4.,5.));
+    CHECK(tube(2.) == Interval(0.5));
+  }
+
+  SECTION("extend_tdomain")
+  {
+    Tube tube(Interval(0.,2.), 1., Interval(-1.,1.));
+    tube.set(Interval(0.5), 2.);
+    tube.extend_tdomain(4.5, 1., Interval(-2.,2.));
+    CHECK(tube.tdomain() == Interval(0.,4.5));
+    CHECK(tube.nb_slices() == 5);
+    CHECK(tube.slice(2)->tdomain() == Interval(2.,3.));
+    CHECK(tube.last_slice()->tdomain() == Interval(4.,4.5));
+    CHECK(tube(2.) == Interval(0.5));
+    CHECK(tube(Interval(2.,4.5)) == Interval(-2.,2.));
+    CHECK(tube.codomain() == Interval(-2.,2.));
+    CHECK(tube.slice(4.2) == tube.last_slice());
+
+    TubeVector tube_vector(Interval(0.,1.), 0.5, 2);
+    tube_vector.extend_tdomain(2., 0.5);
+    CHECK(tube_vector.tdomain() == Interval(0.,2.));
+    CHECK(tube_vector.nb_slices() == 4);
+  }
+
+  SECTION("Tracking of the updated slices")
+  {
+    Tube tube(Interval(0.,10.), 1., Interval(-10.,10.));
+    shared_ptr<SlicesStorage::DirtyTDomain> tracker, tracker2;
+    CHECK(tube.dirty_tdomain(tracker) == Interval::ALL_REALS); // previous updates unknown
+    CHECK(tube.dirty_tdomain(tracker) == Interval::EMPTY_SET);
+
+    tube.slice(2)->set_envelope(Interval(-1.,1.));
+    tube.slice(2)->set_envelope(Interval(-1.,1.)); // no update
+    CHECK(tube.dirty_tdomain(tracker) == Interval(2.,3.));
+    CHECK(tube.dirty_tdomain(tracker) == Interval::EMPTY_SET);
+    CHECK(tube.dirty_tdomain(tracker2) == Interval::ALL_REALS);
+
+    tube.slice(5)->set_input_gate(Interval(0.5));
+    tube.slice(8)->set_output_gate(Interval(-20.,20.)); // no update
+    CHECK(tube.dirty_tdomain(tracker) == Interval(5.));
+    CHECK(tube.dirty_tdomain(tracker2) == Interval(5.));
+
+    // Sampling and merging: only the related slices are updated
+    tube.sample(6.5);
+    CHECK(tube.nb_slices() == 11);
+    CHECK(tube.dirty_tdomain(tracker) == Interval(6.,7.));
+    tube.sample(vector<double>({ 1.5, 2.5 }));
+    CHECK(tube.dirty_tdomain(tracker) == Interval(1.,3.));
+    tube.remove_gate(6.5);
+    CHECK(tube.dirty_tdomain(tracker) == Interval(6.,7.));
+    tube.sample(6.); // already a gate
+    CHECK(tube.dirty_tdomain(tracker) == Interval::EMPTY_SET);
+    CHECK(tube.dirty_tdomain(tracker2) == Interval(1.,7.));
+
+    tube.extend_tdomain(12., 1.);
+    CHECK(tube.dirty_tdomain(tracker) == Interval(10.,12.));
+
+    // Bulk updates: one hull per range of slices
+    tube.for_each_slice_range([&](int k0, int k1)
+    {
+      for(int k = k0 ; k < k1 ; k++)
+      {
+        tube.slice(k)->set_input_gate(tube.slice(k)->input_gate(), false); // no update
+        if(k == 3 || k == 4)
+          tube.slice(k)->set_envelope(Interval(-2.,2.), false);
+      }
+    });
+    CHECK(tube.dirty_tdomain(tracker) == Interval(3.,5.));
+    tube.for_each_slice_range([&](int k0, int k1)
+    {
+      if(k1 == tube.nb_slices())
+        tube.last_slice()->set_output_gate(Interval(0.), false);
+    });
+    CHECK(tube.dirty_tdomain(tracker) == Interval(12.));
+
+    // New storage: previous updates unknown
+    tube = Tube(Interval(0.,10.), 2.);
+    CHECK(tube.dirty_tdomain(tracker) == Interval::ALL_REALS);
+    CHECK(tube.dirty_tdomain(tracker) == Interval::EMPTY_SET);
+  }
 }
@@ -184,4 +184,173 @@ TEST_CASE("Trajectory base")
     CHECK(test1 == test2);
     CHECK(test1[0] == test2[0]);
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Trajectory samples")
+{
+  SECTION("Uniform and non-uniform lookups")
+  {
+    TrajectorySamples samples;
+    for(int k = 0 ; k <= 100 ; k++)
+      samples.set(k*0.1, k); // appended samples
+    CHECK(samples.size() == 101);
+    CHECK(samples.find(5.) == 50);
+    CHECK(samples.find(5.05) == -1);
+    CHECK(samples.lower_index(5.05) == 50);
+    CHECK(samples.lower_index(10.) == 100);
+    CHECK(samples.interpolate(5.05) == Approx(50.5));
+    CHECK(samples.hull(Interval(2.05,2.95)).lb() == Approx(20.5));
+    CHECK(samples.hull(Interval(2.05,2.95)).ub() == Approx(29.5));
+
+    TrajectorySamples samples_nu; // non-uniform sampling
+    for(int k = 0 ; k <= 20 ; k++)
+      samples_nu.set(k*k, k);
+    CHECK(samples_nu.lower_index(0.5) == 0);
+    CHECK(samples_nu.lower_index(99.) == 9);
+    CHECK(samples_nu.lower_index(100.) == 10);
+    CHECK(samples_nu.lower_index(399.) == 19);
+    CHECK(samples_nu.interpolate(110.5) == Approx(10.5));
+  }
+
+  SECTION("Insertions and replacements")
+  {
+    TrajectorySamples samples;
+    samples.set(2., 20.);
+    samples.set(0., 0.);
+    samples.set(3., 30.);
+    samples.set(1., 10.);
+    samples.set(2., 21.);
+    CHECK(samples.times() == vector<double>({ 0., 1., 2., 3. }));
+    CHECK(samples.values() == vector<double>({ 0., 10., 21., 30. }));
+    CHECK(samples.hull() == Interval(0.,30.));
+
+    samples.truncate(Interval(0.5,2.));
+    CHECK(samples.times() == vector<double>({ 1., 2. }));
+    samples.shift(-1.);
+    CHECK(samples.times() == vector<double>({ 0., 1. }));
+  }
+
+  SECTION("Range hulls")
+  {
+    TrajectorySamples samples;
+    for(int k = 0 ; k < 500 ; k++)
+      samples.set(k, std::cos(0.1*k) + 0.01*k);
+
+    // Checks the tree-based hulls against a linear scan
+    auto check_hulls = [](const TrajectorySamples& s)
+    {
+      for(int k0 = 0 ; k0 < s.size() ; k0+=37)
+        for(int kf = k0 ; kf < s.size() ; kf+=23)
+        {
+          Interval scan = Interval::EMPTY_SET;
+          for(int k = k0 ; k <= kf ; k++)
+            scan |= s.values()[k];
+          CHECK(s.hull(k0,kf) == scan);
+        }
+      CHECK(s.hull() == s.hull(0,s.size()-1));
+    };
+
+    check_hulls(samples); // builds the tree
+    samples.set_value(250, 100.); // leaf update
+    CHECK(samples.hull(200,300) == Interval(samples.hull(200,249) | samples.hull(251,300) | 100.));
+    for(int k = 500 ; k < 600 ; k++) // appended values, beyond the tree capacity
+      samples.set(k, -0.5*k);
+    check_hulls(samples);
+    samples.set(10.5, 1000.); // insertion
+    check_hulls(samples);
+    samples.truncate(Interval(100.,400.));
+    check_hulls(samples);
+
+    Interval expected_hull = samples.hull(samples.find(151.),samples.find(350.));
+    expected_hull |= samples.interpolate(150.5);
+    expected_hull |= samples.interpolate(350.5);
+    CHECK(samples.hull(Interval(150.5,350.5)) == expected_hull);
+  }
+
+  SECTION("Equivalence with the map of values")
+  {
+    Trajectory x;
+    for(double t = 10. ; t >= 0. ; t-=0.5) // values set backward
+      x.set(std::cos(t), t);
+    x.set(0.25, 0.25);
+
+    const map<double,double>& map_values = x.sampled_map();
+    CHECK(map_values.size() == (size_t)x.samples().size());
+
+    int k = 0;
+    for(const auto& it : map_values)
+    {
+      CHECK(it.first == x.samples().times()[k]);
+      CHECK(it.second == x.samples().values()[k]);
+      k++;
+    }
+
+    x.set(1., 5.);
+    CHECK(x.sampled_map().at(5.) == 1.);
+    x.shift_tdomain(1.);
+    CHECK(x.sampled_map().begin()->first == 1.);
+    CHECK(x(6.) == 1.);
+    CHECK(x(Interval(1.,1.25)) == Interval(0.25,1.));
+  }
+}
+
+TEST_CASE("TrajectoryVector shared time base")
+{
+  SECTION("Appended values")
+  {
+    TrajectoryVector x(3);
+    for(int k = 0 ; k <= 100 ; k++)
+      x.set(Vector({ 1.*k, 2.*k, std::cos(0.1*k) }), 0.1*k);
+
+    CHECK(x.shared_tbase());
+    CHECK(x[0].samples().shares_times(x[2].samples()));
+    CHECK(x.tdomain() == Interval(0.,10.));
+    CHECK(x[1].tdomain() == Interval(0.,10.));
+    CHECK(x[1].codomain() == Interval(0.,200.));
+    CHECK(x.sampled_value(10) == Vector({ 10., 20., std::cos(1.) }));
+    CHECK(x(0.55)[0] == Approx(5.5));
+    CHECK(x(0.55)[1] == Approx(11.));
+    CHECK(x(Interval(0.55,2.))[1].lb() == Approx(11.));
+    CHECK(x(Interval(0.55,2.))[1].ub() == Approx(40.));
+
+    // Same results as component-wise evaluations
+    for(double t = 0. ; t < 9.5 ; t+=0.37)
+      for(int i = 0 ; i < 3 ; i++)
+      {
+        CHECK(x(t)[i] == x[i](t));
+        CHECK(x(Interval(t,t+0.5))[i] == x[i](Interval(t,t+0.5)));
+      }
+
+    // Copy-on-write of the time keys
+    TrajectoryVector y(x);
+    CHECK(y.shared_tbase());
+    y.set(Vector({ 0., 0., 0. }), 11.);
+    CHECK(y.shared_tbase());
+    CHECK(y.tdomain() == Interval(0.,11.));
+    CHECK(x.tdomain() == Interval(0.,10.));
+    CHECK(x[0].samples().size() == 101);
+    CHECK(x[0].samples().times().size() == 101);
+
+    y[0].set(1., 5.05); // the component does not share its time base anymore
+    CHECK(!y.shared_tbase());
+    CHECK(y[1].samples().size() == 102);
+    CHECK(y[0].samples().size() == 103);
+  }
+
+  SECTION("Constructors and sampling")
+  {
+    map<double,Vector> map_values;
+    for(double t = 0. ; t <= 10. ; t++)
+      map_values.insert(make_pair(t, Vector(4,t)));
+    TrajectoryVector x(map_values);
+    CHECK(x.shared_tbase());
+
+    x.sample(0.25);
+    CHECK(x.shared_tbase());
+    CHECK(x[3].samples().size() == 41);
+    x.truncate_tdomain(Interval(2.,8.));
+    CHECK(x.shared_tbase());
+    CHECK(x(5.125) == Vector(4,5.125));
+    CHECK(x.sampled_value(0) == Vector(4,2.));
+  }
+}
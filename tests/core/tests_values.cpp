@@ -425,6 +425,37 @@ TEST_CASE("Testing set inversion")
     Tube x(domain, dt, TFunction("[-1,1]*(t^2+1)"));
     CHECK(x.invert(0., x.tdomain()) == domain);
   }
+
+  SECTION("Set inversion with a synthesis tree")
+  {
+    Tube x = tube_test_1();
+    x.set(Interval(-4,2), 14);
+    Tube v(x);
+    v.set(Interval(-1.,1.));
+
+    Tube x_tree(x);
+    x_tree.enable_synthesis(true);
+
+    vector<Interval> v_y({ Interval(0.), Interval(-7.), Interval(-1.,1.), Interval(10.,11.), Interval(-20.,-18.) });
+    vector<Interval> v_search({ x.tdomain(), Interval(3.,17.), Interval(15.2,39.), Interval(4.5), Interval(46.) });
+
+    for(const auto& y : v_y)
+      for(const auto& search : v_search)
+      {
+        vector<Interval> v_t, v_t_tree;
+
+        CHECK(x_tree.invert(y, search) == x.invert(y, search));
+        CHECK(x_tree.invert(y, v, search) == x.invert(y, v, search));
+
+        x.invert(y, v_t, search);
+        x_tree.invert(y, v_t_tree, search);
+        CHECK(v_t_tree == v_t);
+
+        x.invert(y, v_t, v, search);
+        x_tree.invert(y, v_t_tree, v, search);
+        CHECK(v_t_tree == v_t);
+      }
+  }
 }
 
 TEST_CASE("Testing set inversion in vector case")